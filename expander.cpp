@@ -1,10 +1,20 @@
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 #include <tao/json.hpp>
 #include <tao/json/external/pegtl.hpp>
-#include <tao/json/external/pegtl/contrib/json.hpp>
 #include <tao/json/external/pegtl/memory_input.hpp>
 
 using namespace tao::json;
@@ -12,15 +22,500 @@ using namespace std::literals::string_literals;
 
 namespace expander {
 
-struct value : pegtl::try_catch<pegtl::sor<pegtl::json::object, pegtl::json::array>> {};
+// an object or array that is valid JSON; the validator checks it in a
+// single pass without events, so failed candidates are cheap to reject;
+// numbers that overflow a double are accepted here so that the parser
+// reports them as errors like for any other value
+struct value {
+    using analyze_t = pegtl::analysis::generic<pegtl::analysis::rule_type::any>;
+
+    template<typename input>
+    static bool match(input& in) {
+        if (in.empty() || (in.peek_char() != '{' && in.peek_char() != '[')) {
+            return false;
+        }
+        validate_options options;
+        options.allow_trailing = true;
+        options.allow_infinite = true;
+        auto const result = validate(std::string_view(in.current(), in.size()), options);
+        if (result) {
+            in.bump(result.offset);
+        }
+        return bool(result);
+    }
+};
+
 struct any : pegtl::any {};
 struct grammar : pegtl::star<pegtl::sor<value, any>> {};
 
+constexpr std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+
+// output stream that appends to a string, so that the printer can reorder
+// what it has written
+class output : private std::streambuf, public std::ostream {
+public:
+    output()
+        : std::ostream(this) {}
+
+    std::string text;
+
+private:
+    using traits = std::streambuf::traits_type;
+
+    std::streambuf::int_type overflow(std::streambuf::int_type const c) override {
+        if (!traits::eq_int_type(c, traits::eof())) {
+            text += traits::to_char_type(c);
+        }
+        return traits::not_eof(c);
+    }
+
+    std::streamsize xsputn(char const* s, std::streamsize const n) override {
+        text.append(s, std::size_t(n));
+        return n;
+    }
+};
+
+// pretty printer that shows at most max_elements array elements or object
+// members per container; skip_action asks it with full() whether the next
+// one is still shown, and reports the rest with elided(); strings longer
+// than max_string_bytes are cut at a code point boundary; the members of
+// every object are sorted by key at its end, like when printing a value,
+// and duplicate keys are reported like when parsing into a value, except
+// for the keys of elided members, which are never seen
+class pretty_printer : public events::to_pretty_stream {
+public:
+    pretty_printer(output& out,
+                   std::size_t indent,
+                   std::size_t max_elements,
+                   std::size_t max_string_bytes)
+        : to_pretty_stream(out, indent)
+        , out_(out)
+        , max_elements_(max_elements)
+        , max_string_bytes_(max_string_bytes) {}
+
+    // numbers are converted, so the ones that overflow a double are
+    // reported and all are printed as before
+    static constexpr bool disable_number_raw = true;
+
+    void string(std::string_view const v) {
+        if (v.size() <= max_string_bytes_) {
+            to_pretty_stream::string(v);
+            return;
+        }
+        auto cut = max_string_bytes_;
+        while (cut > 0 && (static_cast<unsigned char>(v[cut]) & 0xC0) == 0x80) {
+            --cut;
+        }
+        to_pretty_stream::string(v.substr(0, cut));
+        os << " ... (" << v.size() - cut << " more bytes)";
+    }
+
+    void begin_array(std::size_t const /*unused*/ = 0) {
+        to_pretty_stream::begin_array();
+        counts_.push_back(0);
+    }
+
+    void element() {
+        ++counts_.back();
+        to_pretty_stream::element();
+    }
+
+    void end_array(std::size_t const /*unused*/ = 0) {
+        counts_.pop_back();
+        to_pretty_stream::end_array();
+    }
+
+    void begin_object(std::size_t const /*unused*/ = 0) {
+        to_pretty_stream::begin_object();
+        counts_.push_back(0);
+        objects_.emplace_back();
+    }
+
+    // the text of the member starts after the comma and the indentation
+    // that to_pretty_stream::key() writes first
+    void key(std::string_view const v) {
+        auto& object = objects_.back();
+        object.key = v;
+        object.begin = out_.text.size() + (first ? 0 : 1) + eol.size() + current_indent;
+        to_pretty_stream::key(v);
+    }
+
+    // the key is checked after the value, like when parsing into a value,
+    // so that errors in the value are reported first
+    void member() {
+        auto& object = objects_.back();
+        auto const [it, inserted] = object.members.try_emplace(std::move(object.key), object.begin, out_.text.size());
+        if (!inserted) {
+            throw std::runtime_error(internal::format("duplicate JSON object key \"", internal::escape(it->first), '"'));
+        }
+        ++counts_.back();
+        to_pretty_stream::member();
+    }
+
+    void end_object(std::size_t const /*unused*/ = 0) {
+        sort(objects_.back().members);
+        counts_.pop_back();
+        objects_.pop_back();
+        to_pretty_stream::end_object();
+    }
+
+    bool full() const {
+        return counts_.back() >= max_elements_;
+    }
+
+    void elided(std::size_t const count) {
+        next();
+        os << "... (" << count << " more)";
+        first = false;
+    }
+
+private:
+    // where the text of every member of an object is, by key
+    using member_ranges = std::map<std::string, std::pair<std::size_t, std::size_t>>;
+
+    struct object {
+        member_ranges members;
+        std::string key;
+        std::size_t begin = 0;
+    };
+
+    // the members are written one after the other, with the same comma and
+    // indentation between them, and an elided() note after the last one
+    void sort(member_ranges const& m) {
+        if (m.size() < 2) {
+            return;
+        }
+        auto& text = out_.text;
+        std::size_t begin = text.size();
+        std::size_t end = 0;
+        for (auto const& [k, r] : m) {
+            begin = std::min(begin, r.first);
+            end = std::max(end, r.second);
+        }
+        std::string const separator = ","s + eol + std::string(current_indent, os.fill());
+        std::string sorted;
+        sorted.reserve(end - begin);
+        for (auto const& [k, r] : m) {
+            if (!sorted.empty()) {
+                sorted += separator;
+            }
+            sorted.append(text, r.first, r.second - r.first);
+        }
+        text.replace(begin, end - begin, sorted);
+    }
+
+    output& out_;
+    std::size_t const max_elements_;
+    std::size_t const max_string_bytes_;
+    std::vector<std::size_t> counts_;
+    std::vector<object> objects_;
+};
+
+// parser actions that skip the remaining elements or members of a
+// container once the consumer is full(), without any events and without
+// unescaping or converting anything; value::match has checked the text,
+// so the validator is only used to find the end of every skipped value,
+// and the only check it can fail is the one that value::match left out
+template<typename rule>
+struct skip_action : internal::action<rule> {};
+
+// returns the end of the value at p
+inline char const* skip_value(internal::validator& v, char const* p) {
+    p = v.value(p);
+    if (p == nullptr) {
+        throw std::runtime_error("invalid double value");
+    }
+    return p;
+}
+
+template<typename input, typename consumer>
+bool skip_rest(input& in, consumer& c, bool const members) {
+    internal::validator v(in.current(), in.end(), 0);
+    char const* p = in.current();
+    std::size_t count = 0;
+    while (*p != ']' && *p != '}') {
+        if (members) {
+            p = v.whitespace(v.value(p));
+            p = v.whitespace(p + 1);
+        }
+        p = v.whitespace(skip_value(v, p));
+        if (*p == ',') {
+            p = v.whitespace(p + 1);
+        }
+        ++count;
+    }
+    if (count == 0) {
+        return false;
+    }
+    in.bump(p - in.current());
+    c.elided(count);
+    return true;
+}
+
+template<>
+struct skip_action<internal::rules::array_element> : internal::action<internal::rules::array_element> {
+    template<typename rule,
+             pegtl::apply_mode A,
+             pegtl::rewind_mode M,
+             template<typename...> class Action,
+             template<typename...> class Control,
+             typename input,
+             typename consumer>
+    static bool match(input& in, consumer& c) {
+        if (c.full()) {
+            return skip_rest(in, c, false);
+        }
+        return pegtl::match<rule, A, M, Action, Control>(in, c);
+    }
+};
+
+template<>
+struct skip_action<internal::rules::member> : internal::action<internal::rules::member> {
+    template<typename rule,
+             pegtl::apply_mode A,
+             pegtl::rewind_mode M,
+             template<typename...> class Action,
+             template<typename...> class Control,
+             typename input,
+             typename consumer>
+    static bool match(input& in, consumer& c) {
+        if (c.full()) {
+            return skip_rest(in, c, true);
+        }
+        return pegtl::match<rule, A, M, Action, Control>(in, c);
+    }
+};
+
+// set of object keys with a perfect hash that is computed once at startup,
+// a lookup is one hash, one length check and at most one compare
+class key_set {
+public:
+    key_set() = default;
+
+    explicit key_set(std::vector<std::string> keys) {
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        if (keys.empty()) {
+            return;
+        }
+        std::size_t size = 2;
+        while (size < 2 * keys.size()) {
+            size *= 2;
+        }
+        for (std::uint64_t seed = 0;; ++seed) {
+            if (seed == 64) {
+                seed = 0;
+                size *= 2;
+            }
+            if (place(keys, size, seed)) {
+                break;
+            }
+        }
+        for (auto const& key : keys) {
+            lengths_ |= length_bit(key.size());
+        }
+    }
+
+    bool empty() const {
+        return slots_.empty();
+    }
+
+    bool contains(std::string_view const key) const {
+        if ((lengths_ & length_bit(key.size())) == 0) {
+            return false;
+        }
+        auto const& slot = slots_[hash(key, seed_) & (slots_.size() - 1)];
+        return slot.used && slot.key == key;
+    }
+
+private:
+    struct slot {
+        bool used = false;
+        std::string key;
+    };
+
+    static std::uint64_t length_bit(std::size_t const length) {
+        return std::uint64_t(1) << std::min<std::size_t>(length, 63);
+    }
+
+    static std::uint64_t hash(std::string_view const key,
+                              std::uint64_t const seed) {
+        // FNV-1a with the seed folded into the offset basis
+        std::uint64_t h = 14695981039346656037ULL ^ (seed * 0x9E3779B97F4A7C15ULL);
+        for (char const c : key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ULL;
+        }
+        return h ^ (h >> 32);
+    }
+
+    bool place(std::vector<std::string> const& keys,
+               std::size_t const size,
+               std::uint64_t const seed) {
+        std::vector<slot> slots(size);
+        for (auto const& key : keys) {
+            auto& s = slots[hash(key, seed) & (size - 1)];
+            if (s.used) {
+                return false;
+            }
+            s.used = true;
+            s.key = key;
+        }
+        slots_ = std::move(slots);
+        seed_ = seed;
+        return true;
+    }
+
+    std::vector<slot> slots_;
+    std::uint64_t seed_ = 0;
+    std::uint64_t lengths_ = 0;
+};
+
+// what --redact asked for: member names anywhere in the document
+// and JSON pointers to single values
+struct redaction {
+    key_set keys;
+    std::vector<pointer> pointers;
+
+    bool empty() const {
+        return keys.empty() && pointers.empty();
+    }
+
+    bool matches(std::vector<std::string> const& path) const {
+        for (auto const& p : pointers) {
+            if (p.size() == path.size() &&
+                std::equal(p.begin(), p.end(), path.begin(), [](token const& t, std::string const& k) {
+                    return t.key() == k;
+                })) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// transformer that keeps track of where the parser is in the document for
+// redact_action, which asks it with redacted() before every value; the
+// matching values are replaced by "***" and skipped by the parser, so their
+// events never reach Consumer
+template<typename Consumer>
+class redact : public Consumer {
+public:
+    template<typename... Ts>
+    explicit redact(redaction const& rules, Ts&&... ts)
+        : Consumer(std::forward<Ts>(ts)...)
+        , rules_(rules) {}
+
+    void begin_array(std::size_t const /*unused*/ = 0) {
+        Consumer::begin_array();
+        if (!rules_.pointers.empty()) {
+            path_.emplace_back("0"s);
+            indices_.push_back(0);
+        }
+    }
+
+    void element() {
+        if (!rules_.pointers.empty()) {
+            path_.back() = std::to_string(++indices_.back());
+        }
+        Consumer::element();
+    }
+
+    void end_array(std::size_t const /*unused*/ = 0) {
+        if (!rules_.pointers.empty()) {
+            path_.pop_back();
+            indices_.pop_back();
+        }
+        Consumer::end_array();
+    }
+
+    void begin_object(std::size_t const /*unused*/ = 0) {
+        Consumer::begin_object();
+        if (!rules_.pointers.empty()) {
+            path_.emplace_back();
+            indices_.push_back(0);
+        }
+    }
+
+    void key(std::string_view const v) {
+        matched_key_ = rules_.keys.contains(v);
+        if (!rules_.pointers.empty()) {
+            path_.back() = v;
+        }
+        Consumer::key(v);
+    }
+
+    void end_object(std::size_t const /*unused*/ = 0) {
+        if (!rules_.pointers.empty()) {
+            path_.pop_back();
+            indices_.pop_back();
+        }
+        Consumer::end_object();
+    }
+
+    bool redacted() {
+        bool const matched = matched_key_ || (!rules_.pointers.empty() && rules_.matches(path_));
+        matched_key_ = false;
+        if (matched) {
+            Consumer::string("***");
+        }
+        return matched;
+    }
+
+private:
+    redaction const& rules_;
+    bool matched_key_ = false;
+    std::vector<std::string> path_;
+    std::vector<std::size_t> indices_;
+};
+
+// parser actions for redact that skip the values it replaces, on top of
+// the elided elements and members that skip_action skips
+template<typename rule>
+struct redact_action : skip_action<rule> {};
+
+template<>
+struct redact_action<internal::rules::sor_value> : skip_action<internal::rules::sor_value> {
+    template<typename rule,
+             pegtl::apply_mode A,
+             pegtl::rewind_mode M,
+             template<typename...> class Action,
+             template<typename...> class Control,
+             typename input,
+             typename consumer>
+    static bool match(input& in, consumer& c) {
+        // an empty array is the only place where no value follows; numbers
+        // that overflow a double are accepted, a masked value never fails
+        if (in.peek_char() != ']' && c.redacted()) {
+            internal::validator v(in.current(), in.end(), 0, true);
+            in.bump(v.value(in.current()) - in.current());
+            return true;
+        }
+        return pegtl::match<rule, A, M, Action, Control>(in, c);
+    }
+};
+
 struct state {
     bool json_only = false;
+    std::size_t max_elements = unlimited;
+    std::size_t max_string_bytes = unlimited;
+    redaction redacted;
     std::string value;
+    output stream;
 };
 
+template<template<typename...> class actions, typename consumer, typename input>
+void expand(consumer& c, input const& in, state& s) {
+    auto const text = in.string_view();
+    pegtl::memory_input<pegtl::tracking_mode::lazy> json(text.data(), text.data() + text.size(), "");
+    pegtl::parse<internal::grammar, actions, internal::errors>(json, c);
+    if (!s.json_only) {
+        s.value += "\n"s;
+    }
+    s.value += s.stream.text;
+    s.value += "\n"s;
+}
+
 // default action
 template<typename rule>
 struct action : pegtl::nothing<rule> {};
@@ -30,12 +525,16 @@ template<>
 struct action<value> {
     template<typename input>
     static void apply(input const& in, state& s) {
-        auto value = tao::json::from_string(in.string_view());
-        if (!s.json_only) {
-            s.value += "\n"s;
+        // events go straight from the parser to the printer, elided
+        // elements are skipped by the parser
+        s.stream.text.clear();
+        if (s.redacted.empty()) {
+            pretty_printer printer(s.stream, 2, s.max_elements, s.max_string_bytes);
+            expand<skip_action>(printer, in, s);
+        } else {
+            redact<pretty_printer> printer(s.redacted, s.stream, 2, s.max_elements, s.max_string_bytes);
+            expand<redact_action>(printer, in, s);
         }
-        s.value += to_string(value, 2);
-        s.value += "\n"s;
     }
 };
 
@@ -51,13 +550,55 @@ struct action<any> {
 
 struct options {
     bool json_only = false;
+    std::size_t max_elements = unlimited;
+    std::size_t max_string_bytes = unlimited;
+    std::vector<std::string> redact_keys;
+    std::vector<pointer> redact_pointers;
 };
 
+char const* next_arg(int count, char const* values[], int& i) {
+    if (++i == count) {
+        throw std::invalid_argument("missing value for "s + values[i - 1]);
+    }
+    return values[i];
+}
+
+// the whole argument must be a decimal number that fits a std::size_t
+std::size_t parse_size(int count, char const* values[], int& i) {
+    std::string_view const arg = next_arg(count, values, i);
+    std::size_t size = 0;
+    auto const [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), size);
+    if (ec != std::errc() || end != arg.data() + arg.size()) {
+        throw std::invalid_argument("invalid value '"s + values[i] + "' for " + values[i - 1]);
+    }
+    return size;
+}
+
+// comma separated list, entries starting with '/' are JSON pointers
+void parse_redact(std::string_view list, options& opts) {
+    while (!list.empty()) {
+        auto const comma = std::min(list.find(','), list.size());
+        auto const entry = list.substr(0, comma);
+        if (!entry.empty() && entry[0] == '/') {
+            opts.redact_pointers.emplace_back(std::string(entry));
+        } else if (!entry.empty()) {
+            opts.redact_keys.emplace_back(entry);
+        }
+        list.remove_prefix(std::min(comma + 1, list.size()));
+    }
+}
+
 options parse_args(int count, char const* values[]) {
     options opts;
-    for (std::size_t i = 1; i < count; i++) {
+    for (int i = 1; i < count; i++) {
         if (std::strcmp(values[i], "--json-only") == 0) {
             opts.json_only = true;
+        } else if (std::strcmp(values[i], "--max-elements") == 0) {
+            opts.max_elements = parse_size(count, values, i);
+        } else if (std::strcmp(values[i], "--max-string-bytes") == 0) {
+            opts.max_string_bytes = parse_size(count, values, i);
+        } else if (std::strcmp(values[i], "--redact") == 0) {
+            parse_redact(next_arg(count, values, i), opts);
         }
     }
     return opts;
@@ -67,19 +608,33 @@ options parse_args(int count, char const* values[]) {
 
 int main(int count, char const* values[]) {
     int error = 0;
-    std::size_t pos;
     expander::state state;
-    auto options = expander::parse_args(count, values);
+    expander::options options;
+    try {
+        options = expander::parse_args(count, values);
+    } catch (std::exception const& ex) {
+        std::cerr << ex.what() << "\n";
+        return 2;
+    }
     state.json_only = options.json_only;
+    state.max_elements = options.max_elements;
+    state.max_string_bytes = options.max_string_bytes;
+    state.redacted.keys = expander::key_set(std::move(options.redact_keys));
+    state.redacted.pointers = std::move(options.redact_pointers);
 
     for (std::string line; std::getline(std::cin, line);) {
         state.value.clear();
         try {
-            pegtl::memory_input in(line, "");
+            pegtl::memory_input<pegtl::tracking_mode::lazy> in(line, "");
             pegtl::parse<expander::grammar, expander::action>(in, state);
         } catch (std::exception const& ex) {
             std::cerr << ex.what();
-            state.value = std::move(line);
+            // the raw line could show what --redact is meant to hide
+            if (state.redacted.empty()) {
+                state.value = std::move(line);
+            } else {
+                state.value.clear();
+            }
             error = 1;
         }
 
@@ -10,8 +10,12 @@
 // Value Reading
 #include "json/from_stream.hpp"
 #include "json/from_string.hpp"
+#include "json/incremental_parser.hpp"
 #include "json/parse_file.hpp"
+#include "json/parse_ndjson.hpp"
 #include "json/parts_parser.hpp"
+#include "json/validate.hpp"
+#include "json/value_parser.hpp"
 
 // Value Writing
 #include "json/stream.hpp"  // operator<<
@@ -43,8 +43,8 @@ namespace tao::json
       static_assert( std::is_nothrow_move_constructible_v< public_base_t > );
       static_assert( std::is_nothrow_move_assignable_v< public_base_t > );
 
-      using array_t = std::vector< basic_value >;
-      using object_t = std::map< std::string, basic_value, std::less<> >;
+      using array_t = typename internal::array_type< Traits, basic_value >::type;
+      using object_t = typename internal::object_type< Traits, basic_value >::type;
 
       basic_value() noexcept = default;
 
@@ -414,13 +414,13 @@ namespace tao::json
       }
 
       template< json::type E >
-      [[nodiscard]] decltype( internal::get_by_enum< E >::get( std::declval< internal::value_union< basic_value >& >() ) ) unsafe_get() noexcept
+      [[nodiscard]] decltype( internal::get_by_enum< E >::get( std::declval< internal::value_union< basic_value, object_t, array_t >& >() ) ) unsafe_get() noexcept
       {
          return internal::get_by_enum< E >::get( m_union );
       }
 
       template< json::type E >
-      [[nodiscard]] decltype( internal::get_by_enum< E >::get( std::declval< const internal::value_union< basic_value >& >() ) ) unsafe_get() const noexcept
+      [[nodiscard]] decltype( internal::get_by_enum< E >::get( std::declval< const internal::value_union< basic_value, object_t, array_t >& >() ) ) unsafe_get() const noexcept
       {
          return internal::get_by_enum< E >::get( m_union );
       }
@@ -532,14 +532,14 @@ namespace tao::json
       }
 
       template< json::type E >
-      [[nodiscard]] decltype( internal::get_by_enum< E >::get( std::declval< internal::value_union< basic_value >& >() ) ) get()
+      [[nodiscard]] decltype( internal::get_by_enum< E >::get( std::declval< internal::value_union< basic_value, object_t, array_t >& >() ) ) get()
       {
          validate_json_type( E );
          return internal::get_by_enum< E >::get( m_union );
       }
 
       template< json::type E >
-      [[nodiscard]] decltype( internal::get_by_enum< E >::get( std::declval< const internal::value_union< basic_value >& >() ) ) get() const
+      [[nodiscard]] decltype( internal::get_by_enum< E >::get( std::declval< const internal::value_union< basic_value, object_t, array_t >& >() ) ) get() const
       {
          validate_json_type( E );
          return internal::get_by_enum< E >::get( m_union );
@@ -1425,11 +1425,17 @@ namespace tao::json
                return;
 
             case json::type::ARRAY:
-               m_union.a.~vector();
+               if( unsafe_is_deep() ) {
+                  unsafe_discard_nested();
+               }
+               m_union.a.~array_t();
                return;
 
             case json::type::OBJECT:
-               m_union.o.~map();
+               if( unsafe_is_deep() ) {
+                  unsafe_discard_nested();
+               }
+               m_union.o.~object_t();
                return;
          }
          assert( false );  // LCOV_EXCL_LINE
@@ -1458,6 +1464,9 @@ namespace tao::json
 #if defined( __GNUC__ ) && ( __GNUC__ >= 7 )
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#if defined( __GNUC__ ) && ( __GNUC__ >= 11 ) && !defined( __clang__ )
+#pragma GCC diagnostic ignored "-Wfree-nonheap-object"
 #endif
       void seize( basic_value&& r ) noexcept
       {
@@ -1644,6 +1653,98 @@ namespace tao::json
          assert( false );  // LCOV_EXCL_LINE
       }
 
+      // Whether this is a non-empty Array or Object that owns its elements.
+      [[nodiscard]] bool unsafe_is_nested() const noexcept
+      {
+         switch( m_type ) {
+            case json::type::ARRAY:
+               return !m_union.a.empty() && internal::is_exclusive( m_union.a );
+            case json::type::OBJECT:
+               return !m_union.o.empty() && internal::is_exclusive( m_union.o );
+            default:
+               return false;
+         }
+      }
+
+      // Whether this is an Array or Object that owns a nested element with
+      // nested elements, i.e. its destruction would recurse more than once.
+      [[nodiscard]] bool unsafe_is_deep() const noexcept
+      {
+         if( unsafe_is_nested() ) {
+            if( m_type == json::type::ARRAY ) {
+               for( const auto& e : m_union.a ) {
+                  if( e.unsafe_is_nested() && e.unsafe_has_nested() ) {
+                     return true;
+                  }
+               }
+            }
+            else {
+               for( const auto& e : m_union.o ) {
+                  if( e.second.unsafe_is_nested() && e.second.unsafe_has_nested() ) {
+                     return true;
+                  }
+               }
+            }
+         }
+         return false;
+      }
+
+      [[nodiscard]] bool unsafe_has_nested() const noexcept
+      {
+         if( m_type == json::type::ARRAY ) {
+            for( const auto& e : m_union.a ) {
+               if( e.unsafe_is_nested() ) {
+                  return true;
+               }
+            }
+         }
+         else {
+            for( const auto& e : m_union.o ) {
+               if( e.second.unsafe_is_nested() ) {
+                  return true;
+               }
+            }
+         }
+         return false;
+      }
+
+      void unsafe_move_deep( std::vector< basic_value >& stack )
+      {
+         if( m_type == json::type::ARRAY ) {
+            for( auto& e : m_union.a ) {
+               if( e.unsafe_is_deep() ) {
+                  stack.emplace_back( std::move( e ) );
+               }
+            }
+         }
+         else {
+            for( auto& e : m_union.o ) {
+               if( e.second.unsafe_is_deep() ) {
+                  stack.emplace_back( std::move( e.second ) );
+               }
+            }
+         }
+      }
+
+      // Destroys the elements whose destruction would recurse more than once
+      // with an explicit stack, so that the depth of a Value is not limited
+      // by the size of the call stack.
+      void unsafe_discard_nested() noexcept
+      {
+         try {
+            std::vector< basic_value > stack;
+            unsafe_move_deep( stack );
+            while( !stack.empty() ) {
+               basic_value v = std::move( stack.back() );
+               stack.pop_back();
+               v.unsafe_move_deep( stack );
+            }
+         }
+         catch( ... ) {
+            // Out of memory, the remaining elements are destroyed recursively.
+         }
+      }
+
       template< typename T >
       static void producer_wrapper( events::virtual_base& consumer, const void* raw )
       {
@@ -1651,7 +1752,7 @@ namespace tao::json
       }
 
       json::type m_type = json::type::UNINITIALIZED;
-      internal::value_union< basic_value > m_union;
+      internal::value_union< basic_value, object_t, array_t > m_union;
    };
 
 }  // namespace tao::json
@@ -0,0 +1,148 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_BINDING_INTERNAL_KEY_TABLE_HPP
+#define TAO_JSON_BINDING_INTERNAL_KEY_TABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace tao::json::binding::internal
+{
+   [[nodiscard]] constexpr std::uint64_t key_hash( const std::string_view k ) noexcept
+   {
+      std::uint64_t h = 14695981039346656037U;
+      for( const char c : k ) {
+         h = ( h ^ static_cast< unsigned char >( c ) ) * 1099511628211U;
+      }
+      return ( h ^ ( h >> 32 ) ) * 0x9e3779b97f4a7c15U;
+   }
+
+   // Perfect hash table over the keys of a binding object that is built at
+   // compile time. The hash of a key selects a bucket, and every bucket has
+   // a seed, searched for when building, that moves the keys of the bucket
+   // to free slots; a lookup needs one hash and one comparison of the key.
+
+   template< std::size_t N >
+   class key_table
+   {
+   public:
+      explicit constexpr key_table( const std::array< std::string_view, N >& keys ) noexcept
+         : m_keys( keys )
+      {
+         for( auto& s : m_slots ) {
+            s = N;
+         }
+         // The keys are sorted by bucket, and the buckets with more keys are
+         // placed first, while most slots are free.
+         std::array< std::uint64_t, N > hashes{};
+         std::array< std::size_t, B + 1 > begin{};
+         std::size_t most = 0;
+         for( std::size_t i = 0; i < N; ++i ) {
+            hashes[ i ] = key_hash( m_keys[ i ] );
+            const std::size_t n = ++begin[ bucket( hashes[ i ] ) + 1 ];
+            most = ( n > most ) ? n : most;
+         }
+         for( std::size_t b = 0; b < B; ++b ) {
+            begin[ b + 1 ] += begin[ b ];
+         }
+         std::array< std::size_t, N > sorted{};
+         std::array< std::size_t, B > end{};
+         for( std::size_t b = 0; b < B; ++b ) {
+            end[ b ] = begin[ b ];
+         }
+         for( std::size_t i = 0; i < N; ++i ) {
+            const std::size_t b = bucket( hashes[ i ] );
+            // Equal keys have equal hashes, which no seed can separate.
+            for( std::size_t j = begin[ b ]; j < end[ b ]; ++j ) {
+               if( hashes[ sorted[ j ] ] == hashes[ i ] ) {
+                  m_duplicates = true;
+                  return;
+               }
+            }
+            sorted[ end[ b ]++ ] = i;
+         }
+         for( std::size_t n = most; n > 0; --n ) {
+            for( std::size_t b = 0; b < B; ++b ) {
+               if( end[ b ] - begin[ b ] == n ) {
+                  while( !try_seed( hashes, sorted, begin[ b ], end[ b ], m_seeds[ b ] ) ) {
+                     ++m_seeds[ b ];
+                  }
+               }
+            }
+         }
+      }
+
+      // Whether two keys are equal, or, extremely unlikely, have the same
+      // 64-bit hash, in which case a table can not be built.
+      [[nodiscard]] constexpr bool has_duplicates() const noexcept
+      {
+         return m_duplicates;
+      }
+
+      [[nodiscard]] constexpr const std::array< std::string_view, N >& keys() const noexcept
+      {
+         return m_keys;
+      }
+
+      // Returns the index of the key, or N when it is not in the table.
+      [[nodiscard]] constexpr std::size_t find( const std::string_view k ) const noexcept
+      {
+         const std::uint64_t h = key_hash( k );
+         const std::size_t i = m_slots[ slot( h, m_seeds[ bucket( h ) ] ) ];
+         return ( ( i < N ) && ( m_keys[ i ] == k ) ) ? i : N;
+      }
+
+   private:
+      static_assert( N < 0xffff, "too many keys" );
+
+      [[nodiscard]] static constexpr std::size_t power_of_two( const std::size_t n ) noexcept
+      {
+         std::size_t r = 1;
+         while( r < n ) {
+            r *= 2;
+         }
+         return r;
+      }
+
+      static constexpr std::size_t B = power_of_two( N );
+      static constexpr std::size_t M = power_of_two( 2 * N );
+
+      std::array< std::string_view, N > m_keys;
+      std::array< std::uint32_t, B > m_seeds{};
+      std::array< std::uint16_t, M > m_slots{};
+      bool m_duplicates = false;
+
+      [[nodiscard]] static constexpr std::size_t bucket( const std::uint64_t h ) noexcept
+      {
+         return std::size_t( h >> 32 ) & ( B - 1 );
+      }
+
+      [[nodiscard]] static constexpr std::size_t slot( const std::uint64_t h, const std::uint32_t seed ) noexcept
+      {
+         return std::size_t( ( ( h ^ seed ) * 0x9e3779b97f4a7c15U ) >> 32 ) & ( M - 1 );
+      }
+
+      template< typename H, typename S >
+      [[nodiscard]] constexpr bool try_seed( const H& hashes, const S& sorted, const std::size_t b, const std::size_t e, const std::uint32_t seed ) noexcept
+      {
+         for( std::size_t j = b; j < e; ++j ) {
+            const std::size_t i = sorted[ j ];
+            auto& s = m_slots[ slot( hashes[ i ], seed ) ];
+            if( s != N ) {
+               while( j-- > b ) {
+                  m_slots[ slot( hashes[ sorted[ j ] ], seed ) ] = N;
+               }
+               return false;
+            }
+            s = std::uint16_t( i );
+         }
+         return true;
+      }
+   };
+
+}  // namespace tao::json::binding::internal
+
+#endif
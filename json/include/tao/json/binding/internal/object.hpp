@@ -4,17 +4,20 @@
 #ifndef TAO_JSON_BINDING_INTERNAL_OBJECT_HPP
 #define TAO_JSON_BINDING_INTERNAL_OBJECT_HPP
 
+#include <array>
 #include <bitset>
-#include <map>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "../for_nothing_value.hpp"
 #include "../for_unknown_key.hpp"
 #include "../member_kind.hpp"
 
+#include "key_table.hpp"
+
 #include "../../forward.hpp"
 
 #include "../../basic_value.hpp"
@@ -27,20 +30,20 @@ namespace tao::json::binding::internal
    template< for_unknown_key E, for_nothing_value N, typename T, typename L = std::make_index_sequence< T::size > >
    struct basic_object;
 
-   template< typename... Ts >
-   void list_all_keys( std::ostream& oss, const std::map< std::string, Ts... >& m )
+   template< std::size_t N >
+   void list_all_keys( std::ostream& oss, const key_table< N >& t )
    {
-      for( const auto& p : m ) {
-         json::internal::format_to( oss, ' ', p.first );
+      for( const auto& k : t.keys() ) {
+         json::internal::format_to( oss, ' ', k );
       }
    }
 
-   template< std::size_t N, typename... Ts >
-   void list_missing_keys( std::ostream& oss, const std::bitset< N >& t, const std::map< std::string, Ts... >& m )
+   template< std::size_t N >
+   void list_missing_keys( std::ostream& oss, const std::bitset< N >& b, const key_table< N >& t )
    {
-      for( const auto& p : m ) {
-         if( !t.test( p.second.index ) ) {
-            json::internal::format_to( oss, ' ', p.first );
+      for( std::size_t i = 0; i < N; ++i ) {
+         if( !b.test( i ) ) {
+            json::internal::format_to( oss, ' ', t.keys()[ i ] );
          }
       }
    }
@@ -50,17 +53,8 @@ namespace tao::json::binding::internal
    {
       using members = json::internal::type_list< As... >;
 
-      template< typename F >
-      struct entry
-      {
-         entry( F c, std::size_t i )
-            : function( c ),
-              index( i )
-         {}
-
-         F function;
-         std::size_t index;
-      };
+      template< template< typename... > class Traits >
+      static constexpr key_table< sizeof...( As ) > table{ std::array< std::string_view, sizeof...( As ) >{ As::template key_view< Traits >()... } };
 
       template< typename A, std::size_t I >
       static void set_optional_bit( std::bitset< sizeof...( As ) >& t )
@@ -74,22 +68,12 @@ namespace tao::json::binding::internal
          A::template to< Traits >( v, x );
       }
 
-      template< typename A, std::size_t I, typename C, template< typename... > class Traits, typename F >
-      static void emplace_to( std::map< std::string, entry< F >, std::less<> >& m )
-      {
-         m.emplace( A::template key< Traits >(), entry< F >( &basic_object::to_wrapper< A, C, Traits >, I ) );
-      }
-
       template< template< typename... > class Traits, typename C >
       static void to( const basic_value< Traits >& v, C& x )
       {
+         static_assert( !table< Traits >.has_duplicates(), "duplicate object keys" );
          using F = void ( * )( const basic_value< Traits >&, C& );
-         static const std::map< std::string, entry< F >, std::less<> > m = []() {
-            std::map< std::string, entry< F >, std::less<> > t;
-            ( emplace_to< As, Is, C, Traits >( t ), ... );
-            assert( t.size() == sizeof...( As ) );  // TODO: Check for duplicate keys at compile time?
-            return t;
-         }();
+         static constexpr std::array< F, sizeof...( As ) > f = { &basic_object::to_wrapper< As, C, Traits >... };
          static const std::bitset< sizeof...( As ) > o = []() {
             std::bitset< sizeof...( As ) > t;
             ( set_optional_bit< As, Is >( t ), ... );
@@ -100,25 +84,25 @@ namespace tao::json::binding::internal
          std::bitset< sizeof...( As ) > b;
          for( const auto& p : a ) {
             const auto& k = p.first;
-            const auto i = m.find( k );
-            if( i == m.end() ) {
+            const auto i = table< Traits >.find( k );
+            if( i == sizeof...( As ) ) {
                if constexpr( E == for_unknown_key::skip ) {
                   continue;
                }
                std::ostringstream oss;
                json::internal::format_to( oss, "unknown object key \"", json::internal::escape( k ), "\" -- known are" );
-               list_all_keys( oss, m );
+               list_all_keys( oss, table< Traits > );
                json::internal::format_to( oss, " for type ", typeid( C ), json::message_extension( v ) );
                throw std::runtime_error( oss.str() );  // NOLINT
             }
-            i->second.function( p.second, x );
-            b.set( i->second.index );
+            f[ i ]( p.second, x );
+            b.set( i );
          }
          b |= o;
          if( !b.all() ) {
             std::ostringstream oss;
-            json::internal::format_to( oss, "missing requiredrequired key(s)" );
-            list_missing_keys( oss, b, m );
+            json::internal::format_to( oss, "missing required key(s)" );
+            list_missing_keys( oss, b, table< Traits > );
             json::internal::format_to( oss, " for type ", typeid( C ), json::message_extension( v ) );
             throw std::runtime_error( oss.str() );  // NOLINT
          }
@@ -152,22 +136,12 @@ namespace tao::json::binding::internal
          A::template consume< Traits, Producer >( parser, x );
       }
 
-      template< typename A, std::size_t I, typename C, template< typename... > class Traits, typename Producer, typename F >
-      static void emplace_consume( std::map< std::string, entry< F >, std::less<> >& m )
-      {
-         m.emplace( A::template key< Traits >(), entry< F >( &basic_object::consume_wrapper< A, C, Traits, Producer >, I ) );
-      }
-
       template< template< typename... > class Traits = traits, typename Producer, typename C >
       static void consume( Producer& parser, C& x )
       {
+         static_assert( !table< Traits >.has_duplicates(), "duplicate object keys" );
          using F = void ( * )( Producer&, C& );
-         static const std::map< std::string, entry< F >, std::less<> > m = []() {
-            std::map< std::string, entry< F >, std::less<> > t;
-            ( emplace_consume< As, Is, C, Traits, Producer >( t ), ... );
-            assert( t.size() == sizeof...( As ) );  // TODO: Check for duplicate keys at compile time?
-            return t;
-         }();
+         static constexpr std::array< F, sizeof...( As ) > f = { &basic_object::consume_wrapper< As, C, Traits, Producer >... };
          static const std::bitset< sizeof...( As ) > o = []() {
             std::bitset< sizeof...( As ) > t;
             ( set_optional_bit< As, Is >( t ), ... );
@@ -178,29 +152,29 @@ namespace tao::json::binding::internal
          std::bitset< sizeof...( As ) > b;
          while( parser.member_or_end_object( s ) ) {
             const auto k = parser.key();
-            const auto i = m.find( k );
-            if( i == m.end() ) {
+            const auto i = table< Traits >.find( k );
+            if( i == sizeof...( As ) ) {
                if constexpr( E == for_unknown_key::skip ) {
                   parser.skip_value();
                   continue;
                }
                std::ostringstream oss;
                json::internal::format_to( oss, "unknown object key \"", json::internal::escape( k ), "\" -- known are" );
-               list_all_keys( oss, m );
+               list_all_keys( oss, table< Traits > );
                json::internal::format_to( oss, " for type ", typeid( C ) );
                parser.throw_parse_error( oss.str() );  // NOLINT
             }
-            if( b.test( i->second.index ) ) {
+            if( b.test( i ) ) {
                parser.throw_parse_error( json::internal::format( "duplicate object key \"", json::internal::escape( k ), "\" for type ", typeid( C ) ) );
             }
-            i->second.function( parser, x );
-            b.set( i->second.index );
+            f[ i ]( parser, x );
+            b.set( i );
          }
          b |= o;
          if( !b.all() ) {
             std::ostringstream oss;
             json::internal::format_to( oss, "missing required key(s)" );
-            list_missing_keys( oss, b, m );
+            list_missing_keys( oss, b, table< Traits > );
             json::internal::format_to( oss, " for type ", typeid( C ) );
             parser.throw_parse_error( oss.str() );  // NOLINT
          }
@@ -235,7 +209,7 @@ namespace tao::json::binding::internal
       }
 
       template< typename A, template< typename... > class Traits, typename C >
-      [[nodiscard]] static bool equal_member( const std::map< std::string, basic_value< Traits >, std::less<> >& a, C& x )
+      [[nodiscard]] static bool equal_member( const typename basic_value< Traits >::object_t& a, C& x )
       {
          if( !A::template is_nothing< Traits >( x ) ) {
             return a.at( A::template key< Traits >() ) == A::read( x );
@@ -253,7 +227,7 @@ namespace tao::json::binding::internal
          const auto& p = lhs.skip_value_ptr();
          if( p.is_object() && ( p.unsafe_get_object().size() == sizeof...( As ) ) ) {
             const auto& a = p.unsafe_get_object();
-            return ( equal_member< As >( a, rhs ) && ... );
+            return ( equal_member< As, Traits >( a, rhs ) && ... );
          }
          return false;
       }
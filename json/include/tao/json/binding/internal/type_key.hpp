@@ -5,6 +5,7 @@
 #define TAO_JSON_BINDING_INTERNAL_TYPE_KEY_HPP
 
 #include <string>
+#include <string_view>
 
 #include "../../internal/string_t.hpp"
 #include "../../internal/type_traits.hpp"
@@ -26,6 +27,12 @@ namespace tao::json::binding::internal
          return json::internal::string_t< Cs... >::as_string();
       }
 
+      template< template< typename... > class Traits >
+      [[nodiscard]] static constexpr std::string_view key_view() noexcept
+      {
+         return json::internal::string_t< Cs... >::as_string_view();
+      }
+
       template< template< typename... > class Traits = traits, typename Consumer >
       static void produce_key( Consumer& consumer )
       {
@@ -42,6 +49,12 @@ namespace tao::json::binding::internal
          return Traits< V >::template default_key< Traits >::as_string();
       }
 
+      template< template< typename... > class Traits >
+      [[nodiscard]] static constexpr std::string_view key_view() noexcept
+      {
+         return Traits< V >::template default_key< Traits >::as_string_view();
+      }
+
       template< template< typename... > class Traits = traits, typename Consumer >
       static void produce_key( Consumer& consumer )
       {
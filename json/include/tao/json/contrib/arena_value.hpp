@@ -0,0 +1,758 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_CONTRIB_ARENA_VALUE_HPP
+#define TAO_JSON_CONTRIB_ARENA_VALUE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../binary_view.hpp"
+#include "../events/from_string.hpp"
+#include "../events/parse_file.hpp"
+#include "../events/to_stream.hpp"
+#include "../events/transformer.hpp"
+#include "../internal/escape.hpp"
+#include "../internal/format.hpp"
+#include "../pointer.hpp"
+#include "../type.hpp"
+
+namespace tao::json
+{
+   // An immutable JSON Value whose strings, binary data, arrays and
+   // objects are all allocated from a std::pmr::memory_resource, usually
+   // the monotonic arena owned by an arena_document.
+
+   // The arena_value is trivially copyable and destructible, nothing is
+   // ever freed individually; destroying a document releases the arena
+   // blocks instead of walking the tree. Object members are sorted by
+   // key for binary search lookups, duplicate keys are rejected.
+
+   class arena_value;
+   struct arena_member;
+
+   template< typename T >
+   class arena_span
+   {
+   public:
+      arena_span() noexcept = default;
+
+      arena_span( const T* data, const std::size_t size ) noexcept
+         : m_data( data ),
+           m_size( size )
+      {}
+
+      [[nodiscard]] const T* begin() const noexcept
+      {
+         return m_data;
+      }
+
+      [[nodiscard]] const T* end() const noexcept
+      {
+         return m_data + m_size;
+      }
+
+      [[nodiscard]] std::size_t size() const noexcept
+      {
+         return m_size;
+      }
+
+      [[nodiscard]] bool empty() const noexcept
+      {
+         return m_size == 0;
+      }
+
+      [[nodiscard]] const T& operator[]( const std::size_t i ) const noexcept
+      {
+         return m_data[ i ];
+      }
+
+   private:
+      const T* m_data = nullptr;
+      std::size_t m_size = 0;
+   };
+
+   class arena_value
+   {
+   public:
+      using array_t = arena_span< arena_value >;
+      using object_t = arena_span< arena_member >;
+
+      arena_value() noexcept = default;
+
+      [[nodiscard]] json::type type() const noexcept
+      {
+         return m_type;
+      }
+
+      explicit operator bool() const noexcept
+      {
+         return m_type != json::type::UNINITIALIZED;
+      }
+
+      [[nodiscard]] bool is_uninitialized() const noexcept
+      {
+         return m_type == json::type::UNINITIALIZED;
+      }
+
+      [[nodiscard]] bool is_null() const noexcept
+      {
+         return m_type == json::type::NULL_;
+      }
+
+      [[nodiscard]] bool is_boolean() const noexcept
+      {
+         return m_type == json::type::BOOLEAN;
+      }
+
+      [[nodiscard]] bool is_signed() const noexcept
+      {
+         return m_type == json::type::SIGNED;
+      }
+
+      [[nodiscard]] bool is_unsigned() const noexcept
+      {
+         return m_type == json::type::UNSIGNED;
+      }
+
+      [[nodiscard]] bool is_integer() const noexcept
+      {
+         return is_signed() || is_unsigned();
+      }
+
+      [[nodiscard]] bool is_double() const noexcept
+      {
+         return m_type == json::type::DOUBLE;
+      }
+
+      [[nodiscard]] bool is_number() const noexcept
+      {
+         return is_integer() || is_double();
+      }
+
+      [[nodiscard]] bool is_string() const noexcept
+      {
+         return m_type == json::type::STRING;
+      }
+
+      [[nodiscard]] bool is_binary() const noexcept
+      {
+         return m_type == json::type::BINARY;
+      }
+
+      [[nodiscard]] bool is_array() const noexcept
+      {
+         return m_type == json::type::ARRAY;
+      }
+
+      [[nodiscard]] bool is_object() const noexcept
+      {
+         return m_type == json::type::OBJECT;
+      }
+
+      [[nodiscard]] bool unsafe_get_boolean() const noexcept
+      {
+         return m_union.b;
+      }
+
+      [[nodiscard]] std::int64_t unsafe_get_signed() const noexcept
+      {
+         return m_union.i;
+      }
+
+      [[nodiscard]] std::uint64_t unsafe_get_unsigned() const noexcept
+      {
+         return m_union.u;
+      }
+
+      [[nodiscard]] double unsafe_get_double() const noexcept
+      {
+         return m_union.d;
+      }
+
+      [[nodiscard]] std::string_view unsafe_get_string_type() const noexcept
+      {
+         return std::string_view( m_union.s, m_size );
+      }
+
+      [[nodiscard]] tao::binary_view unsafe_get_binary_type() const noexcept
+      {
+         return tao::binary_view( m_union.x, m_size );
+      }
+
+      [[nodiscard]] array_t unsafe_get_array() const noexcept
+      {
+         return array_t( m_union.a, m_size );
+      }
+
+      [[nodiscard]] object_t unsafe_get_object() const noexcept
+      {
+         return object_t( m_union.o, m_size );
+      }
+
+      [[nodiscard]] bool get_boolean() const
+      {
+         validate_json_type( json::type::BOOLEAN );
+         return unsafe_get_boolean();
+      }
+
+      [[nodiscard]] std::int64_t get_signed() const
+      {
+         validate_json_type( json::type::SIGNED );
+         return unsafe_get_signed();
+      }
+
+      [[nodiscard]] std::uint64_t get_unsigned() const
+      {
+         validate_json_type( json::type::UNSIGNED );
+         return unsafe_get_unsigned();
+      }
+
+      [[nodiscard]] double get_double() const
+      {
+         validate_json_type( json::type::DOUBLE );
+         return unsafe_get_double();
+      }
+
+      [[nodiscard]] std::string_view get_string_type() const
+      {
+         validate_json_type( json::type::STRING );
+         return unsafe_get_string_type();
+      }
+
+      [[nodiscard]] tao::binary_view get_binary_type() const
+      {
+         validate_json_type( json::type::BINARY );
+         return unsafe_get_binary_type();
+      }
+
+      [[nodiscard]] array_t get_array() const
+      {
+         validate_json_type( json::type::ARRAY );
+         return unsafe_get_array();
+      }
+
+      [[nodiscard]] object_t get_object() const
+      {
+         validate_json_type( json::type::OBJECT );
+         return unsafe_get_object();
+      }
+
+      [[nodiscard]] const arena_value* find( const std::size_t index ) const
+      {
+         const auto a = get_array();
+         return ( index < a.size() ) ? ( a.begin() + index ) : nullptr;
+      }
+
+      [[nodiscard]] inline const arena_value* find( const std::string_view key ) const;
+
+      [[nodiscard]] const arena_value* find( const pointer& k ) const
+      {
+         const arena_value* v = this;
+         for( const auto& t : k ) {
+            v = v->is_array() ? v->find( t.index() ) : v->find( std::string_view( t.key() ) );
+            if( v == nullptr ) {
+               return nullptr;
+            }
+         }
+         return v;
+      }
+
+      [[nodiscard]] const arena_value& at( const std::size_t index ) const
+      {
+         const auto* v = find( index );
+         if( v == nullptr ) {
+            throw std::out_of_range( internal::format( "JSON array index '", index, "' out of bound '", m_size, '\'' ) );  // NOLINT
+         }
+         return *v;
+      }
+
+      [[nodiscard]] const arena_value& at( const std::string_view key ) const
+      {
+         const auto* v = find( key );
+         if( v == nullptr ) {
+            throw std::out_of_range( internal::format( "JSON object key \"", internal::escape( key ), "\" not found" ) );  // NOLINT
+         }
+         return *v;
+      }
+
+      [[nodiscard]] const arena_value& at( const pointer& k ) const
+      {
+         const auto* v = find( k );
+         if( v == nullptr ) {
+            throw std::out_of_range( internal::format( "JSON pointer \"", to_string( k ), "\" not found" ) );  // NOLINT
+         }
+         return *v;
+      }
+
+      [[nodiscard]] const arena_value& operator[]( const std::size_t index ) const noexcept
+      {
+         return m_union.a[ index ];
+      }
+
+      [[nodiscard]] const arena_value& operator[]( const std::string_view key ) const
+      {
+         return at( key );
+      }
+
+      void unsafe_assign_null() noexcept
+      {
+         m_type = json::type::NULL_;
+      }
+
+      void unsafe_assign_boolean( const bool b ) noexcept
+      {
+         m_union.b = b;
+         m_type = json::type::BOOLEAN;
+      }
+
+      void unsafe_assign_signed( const std::int64_t i ) noexcept
+      {
+         m_union.i = i;
+         m_type = json::type::SIGNED;
+      }
+
+      void unsafe_assign_unsigned( const std::uint64_t u ) noexcept
+      {
+         m_union.u = u;
+         m_type = json::type::UNSIGNED;
+      }
+
+      void unsafe_assign_double( const double d ) noexcept
+      {
+         m_union.d = d;
+         m_type = json::type::DOUBLE;
+      }
+
+      // The unsafe_assign_* functions for the following types do not copy
+      // the data, it must outlive the value, usually by being allocated from
+      // the same arena.
+
+      void unsafe_assign_string( const char* s, const std::size_t n ) noexcept
+      {
+         m_union.s = s;
+         m_size = static_cast< std::uint32_t >( n );
+         m_type = json::type::STRING;
+      }
+
+      void unsafe_assign_binary( const std::byte* x, const std::size_t n ) noexcept
+      {
+         m_union.x = x;
+         m_size = static_cast< std::uint32_t >( n );
+         m_type = json::type::BINARY;
+      }
+
+      void unsafe_assign_array( const arena_value* a, const std::size_t n ) noexcept
+      {
+         m_union.a = a;
+         m_size = static_cast< std::uint32_t >( n );
+         m_type = json::type::ARRAY;
+      }
+
+      void unsafe_assign_object( const arena_member* o, const std::size_t n ) noexcept
+      {
+         m_union.o = o;
+         m_size = static_cast< std::uint32_t >( n );
+         m_type = json::type::OBJECT;
+      }
+
+      void validate_json_type( const json::type t ) const
+      {
+         if( m_type != t ) {
+            throw std::logic_error( internal::format( "invalid json type '", m_type, "', expected '", t, '\'' ) );  // NOLINT
+         }
+      }
+
+   private:
+      union
+      {
+         bool b;
+         std::int64_t i;
+         std::uint64_t u;
+         double d;
+         const char* s;
+         const std::byte* x;
+         const arena_value* a;
+         const arena_member* o;
+      } m_union = {};
+
+      std::uint32_t m_size = 0;
+      json::type m_type = json::type::UNINITIALIZED;
+   };
+
+   static_assert( sizeof( arena_value ) == 16 );
+   static_assert( std::is_trivially_copyable_v< arena_value > );
+   static_assert( std::is_trivially_destructible_v< arena_value > );
+
+   struct arena_member
+   {
+      std::string_view first;
+      arena_value second;
+   };
+
+   inline const arena_value* arena_value::find( const std::string_view key ) const
+   {
+      const auto o = get_object();
+      const auto* it = std::lower_bound( o.begin(), o.end(), key, []( const arena_member& m, const std::string_view k ) { return m.first < k; } );
+      return ( ( it != o.end() ) && ( it->first == key ) ) ? ( &it->second ) : nullptr;
+   }
+
+   [[nodiscard]] inline bool operator==( const arena_value& lhs, const arena_value& rhs ) noexcept
+   {
+      if( lhs.type() != rhs.type() ) {
+         switch( lhs.type() ) {
+            case type::SIGNED:
+               if( rhs.type() == type::UNSIGNED ) {
+                  const auto v = lhs.unsafe_get_signed();
+                  return ( v >= 0 ) && ( static_cast< std::uint64_t >( v ) == rhs.unsafe_get_unsigned() );
+               }
+               if( rhs.type() == type::DOUBLE ) {
+                  return lhs.unsafe_get_signed() == rhs.unsafe_get_double();
+               }
+               break;
+
+            case type::UNSIGNED:
+               if( rhs.type() == type::SIGNED ) {
+                  const auto v = rhs.unsafe_get_signed();
+                  return ( v >= 0 ) && ( lhs.unsafe_get_unsigned() == static_cast< std::uint64_t >( v ) );
+               }
+               if( rhs.type() == type::DOUBLE ) {
+                  return lhs.unsafe_get_unsigned() == rhs.unsafe_get_double();
+               }
+               break;
+
+            case type::DOUBLE:
+               if( rhs.type() == type::SIGNED ) {
+                  return lhs.unsafe_get_double() == rhs.unsafe_get_signed();
+               }
+               if( rhs.type() == type::UNSIGNED ) {
+                  return lhs.unsafe_get_double() == rhs.unsafe_get_unsigned();
+               }
+               break;
+
+            default:
+               break;
+         }
+         return false;
+      }
+
+      switch( lhs.type() ) {
+         case type::BOOLEAN:
+            return lhs.unsafe_get_boolean() == rhs.unsafe_get_boolean();
+
+         case type::SIGNED:
+            return lhs.unsafe_get_signed() == rhs.unsafe_get_signed();
+
+         case type::UNSIGNED:
+            return lhs.unsafe_get_unsigned() == rhs.unsafe_get_unsigned();
+
+         case type::DOUBLE:
+            return lhs.unsafe_get_double() == rhs.unsafe_get_double();
+
+         case type::STRING:
+            return lhs.unsafe_get_string_type() == rhs.unsafe_get_string_type();
+
+         case type::BINARY:
+            return lhs.unsafe_get_binary_type() == rhs.unsafe_get_binary_type();
+
+         case type::ARRAY: {
+            const auto l = lhs.unsafe_get_array();
+            const auto r = rhs.unsafe_get_array();
+            return std::equal( l.begin(), l.end(), r.begin(), r.end() );
+         }
+
+         case type::OBJECT: {
+            const auto l = lhs.unsafe_get_object();
+            const auto r = rhs.unsafe_get_object();
+            return std::equal( l.begin(), l.end(), r.begin(), r.end(), []( const arena_member& a, const arena_member& b ) { return ( a.first == b.first ) && ( a.second == b.second ); } );
+         }
+
+         default:
+            return true;
+      }
+   }
+
+   [[nodiscard]] inline bool operator!=( const arena_value& lhs, const arena_value& rhs ) noexcept
+   {
+      return !( lhs == rhs );
+   }
+
+   namespace events
+   {
+      // Events consumer to build an arena_value, everything is allocated
+      // from the given memory resource and never deallocated.
+
+      class to_arena_value
+      {
+      public:
+         explicit to_arena_value( std::pmr::memory_resource& resource ) noexcept
+            : m_resource( resource )
+         {}
+
+         arena_value value;
+
+         void null() noexcept
+         {
+            value.unsafe_assign_null();
+         }
+
+         void boolean( const bool v ) noexcept
+         {
+            value.unsafe_assign_boolean( v );
+         }
+
+         void number( const std::int64_t v ) noexcept
+         {
+            value.unsafe_assign_signed( v );
+         }
+
+         void number( const std::uint64_t v ) noexcept
+         {
+            value.unsafe_assign_unsigned( v );
+         }
+
+         void number( const double v ) noexcept
+         {
+            value.unsafe_assign_double( v );
+         }
+
+         void string( const std::string_view v )
+         {
+            value.unsafe_assign_string( copy( v.data(), v.size() ), v.size() );
+         }
+
+         void binary( const tao::binary_view v )
+         {
+            value.unsafe_assign_binary( reinterpret_cast< const std::byte* >( copy( reinterpret_cast< const char* >( v.data() ), v.size() ) ), v.size() );
+         }
+
+         void begin_array( const std::size_t /*unused*/ = 0 )
+         {
+            m_offsets.emplace_back( m_elements.size() );
+         }
+
+         void element()
+         {
+            m_elements.emplace_back( value );
+         }
+
+         void end_array( const std::size_t /*unused*/ = 0 )
+         {
+            const auto b = m_offsets.back();
+            const auto n = m_elements.size() - b;
+            value.unsafe_assign_array( copy( m_elements.data() + b, n ), n );
+            m_elements.resize( b );
+            m_offsets.pop_back();
+         }
+
+         void begin_object( const std::size_t /*unused*/ = 0 )
+         {
+            m_offsets.emplace_back( m_members.size() );
+         }
+
+         void key( const std::string_view v )
+         {
+            m_keys.emplace_back( copy( v.data(), v.size() ), v.size() );
+         }
+
+         void member()
+         {
+            m_members.push_back( { m_keys.back(), value } );
+            m_keys.pop_back();
+         }
+
+         void end_object( const std::size_t /*unused*/ = 0 )
+         {
+            const auto b = m_offsets.back();
+            const auto n = m_members.size() - b;
+            auto* o = copy( m_members.data() + b, n );
+            std::sort( o, o + n, []( const arena_member& l, const arena_member& r ) { return l.first < r.first; } );
+            const auto* d = std::adjacent_find( o, o + n, []( const arena_member& l, const arena_member& r ) { return l.first == r.first; } );
+            if( d != o + n ) {
+               throw std::runtime_error( internal::format( "duplicate JSON object key \"", internal::escape( d->first ), '"' ) );  // NOLINT
+            }
+            value.unsafe_assign_object( o, n );
+            m_members.resize( b );
+            m_offsets.pop_back();
+         }
+
+      private:
+         template< typename T >
+         [[nodiscard]] T* copy( const T* p, const std::size_t n )
+         {
+            if( n > std::numeric_limits< std::uint32_t >::max() ) {
+               throw std::length_error( "JSON string, binary, array or object too large for tao::json::arena_value" );  // NOLINT
+            }
+            if( n == 0 ) {
+               return nullptr;
+            }
+            auto* r = static_cast< T* >( m_resource.allocate( n * sizeof( T ), alignof( T ) ) );
+            std::memcpy( r, p, n * sizeof( T ) );
+            return r;
+         }
+
+         std::pmr::memory_resource& m_resource;
+         std::vector< arena_value > m_elements;
+         std::vector< arena_member > m_members;
+         std::vector< std::string_view > m_keys;
+         std::vector< std::size_t > m_offsets;
+      };
+
+      // Events producer to generate events from an arena_value.
+
+      template< typename Consumer >
+      void from_arena_value( Consumer& consumer, const arena_value& v )
+      {
+         switch( v.type() ) {
+            case type::UNINITIALIZED:
+               throw std::logic_error( "unable to produce events from uninitialized values" );  // NOLINT
+
+            case type::NULL_:
+               consumer.null();
+               return;
+
+            case type::BOOLEAN:
+               consumer.boolean( v.unsafe_get_boolean() );
+               return;
+
+            case type::SIGNED:
+               consumer.number( v.unsafe_get_signed() );
+               return;
+
+            case type::UNSIGNED:
+               consumer.number( v.unsafe_get_unsigned() );
+               return;
+
+            case type::DOUBLE:
+               consumer.number( v.unsafe_get_double() );
+               return;
+
+            case type::STRING:
+               consumer.string( v.unsafe_get_string_type() );
+               return;
+
+            case type::BINARY:
+               consumer.binary( v.unsafe_get_binary_type() );
+               return;
+
+            case type::ARRAY: {
+               const auto a = v.unsafe_get_array();
+               const auto s = a.size();
+               consumer.begin_array( s );
+               for( const auto& e : a ) {
+                  events::from_arena_value( consumer, e );
+                  consumer.element();
+               }
+               consumer.end_array( s );
+               return;
+            }
+
+            case type::OBJECT: {
+               const auto o = v.unsafe_get_object();
+               const auto s = o.size();
+               consumer.begin_object( s );
+               for( const auto& e : o ) {
+                  consumer.key( e.first );
+                  events::from_arena_value( consumer, e.second );
+                  consumer.member();
+               }
+               consumer.end_object( s );
+               return;
+            }
+
+            default:
+               break;
+         }
+         throw std::logic_error( internal::format( "invalid value '", static_cast< std::uint8_t >( v.type() ), "' for tao::json::arena_value" ) );  // NOLINT, LCOV_EXCL_LINE
+      }
+
+   }  // namespace events
+
+   // Owns a monotonic arena together with the arena_value parsed into it.
+   // Destruction and reset() release the arena blocks in one go; the
+   // initial block size is a hint for the expected size of the document.
+
+   class arena_document
+   {
+   public:
+      explicit arena_document( const std::size_t initial_size = 0, std::pmr::memory_resource* upstream = std::pmr::get_default_resource() )
+         : m_resource( initial_size ? std::make_unique< std::pmr::monotonic_buffer_resource >( initial_size, upstream ) : std::make_unique< std::pmr::monotonic_buffer_resource >( upstream ) )
+      {}
+
+      [[nodiscard]] const arena_value& value() const noexcept
+      {
+         return m_value;
+      }
+
+      [[nodiscard]] std::pmr::memory_resource& resource() noexcept
+      {
+         return *m_resource;
+      }
+
+      template< template< typename... > class... Transformers, typename... Ts >
+      void from_string( Ts&&... ts )
+      {
+         reset();
+         events::transformer< events::to_arena_value, Transformers... > consumer( *m_resource );
+         events::from_string( consumer, std::forward< Ts >( ts )... );
+         m_value = consumer.value;
+      }
+
+      template< template< typename... > class... Transformers >
+      void parse_file( const std::string& filename )
+      {
+         reset();
+         events::transformer< events::to_arena_value, Transformers... > consumer( *m_resource );
+         events::parse_file( consumer, filename );
+         m_value = consumer.value;
+      }
+
+      void reset() noexcept
+      {
+         m_value = arena_value();
+         m_resource->release();
+      }
+
+   private:
+      std::unique_ptr< std::pmr::monotonic_buffer_resource > m_resource;
+      arena_value m_value;
+   };
+
+   template< template< typename... > class... Transformers, typename... Ts >
+   [[nodiscard]] arena_document arena_from_string( Ts&&... ts )
+   {
+      arena_document r;
+      r.from_string< Transformers... >( std::forward< Ts >( ts )... );
+      return r;
+   }
+
+   template< template< typename... > class... Transformers >
+   [[nodiscard]] arena_document arena_parse_file( const std::string& filename )
+   {
+      arena_document r;
+      r.parse_file< Transformers... >( filename );
+      return r;
+   }
+
+   inline std::ostream& operator<<( std::ostream& o, const arena_value& v )
+   {
+      events::to_stream consumer( o );
+      events::from_arena_value( consumer, v );
+      return o;
+   }
+
+}  // namespace tao::json
+
+#endif
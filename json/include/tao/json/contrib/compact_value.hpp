@@ -0,0 +1,993 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_CONTRIB_COMPACT_VALUE_HPP
+#define TAO_JSON_CONTRIB_COMPACT_VALUE_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../binary_view.hpp"
+#include "../events/from_string.hpp"
+#include "../events/to_stream.hpp"
+#include "../events/transformer.hpp"
+#include "../internal/escape.hpp"
+#include "../internal/format.hpp"
+#include "../pointer.hpp"
+#include "../type.hpp"
+
+namespace tao::json
+{
+   // A JSON Value with a 16 byte representation, intended for large
+   // documents with many small scalars. Numbers, booleans and strings
+   // of up to 14 bytes are stored inline, longer strings, binary data,
+   // arrays and objects live on the heap behind a single pointer.
+
+   // The accessors follow those of basic_value where the representation
+   // permits, strings are always returned as std::string_view.
+
+   class compact_value
+   {
+   public:
+      using array_t = std::vector< compact_value >;
+      using object_t = std::map< std::string, compact_value, std::less<> >;
+      using binary_t = std::vector< std::byte >;
+
+      static constexpr std::size_t max_inline_string = 14;
+
+      compact_value() noexcept = default;
+
+      compact_value( const compact_value& r )
+      {
+         embed( r );
+      }
+
+      compact_value( compact_value&& r ) noexcept
+      {
+         std::memcpy( m_data, r.m_data, sizeof( m_data ) );
+         m_type = r.m_type;
+         r.m_type = json::type::DISCARDED;
+      }
+
+      compact_value( const null_t /*unused*/ ) noexcept  // NOLINT
+         : m_type( json::type::NULL_ )
+      {}
+
+      compact_value( const bool b ) noexcept  // NOLINT
+      {
+         unsafe_assign_boolean( b );
+      }
+
+      template< typename T, typename = std::enable_if_t< std::is_integral_v< T > && !std::is_same_v< T, bool > > >
+      compact_value( const T t ) noexcept  // NOLINT
+      {
+         if constexpr( std::is_signed_v< T > ) {
+            unsafe_assign_signed( t );
+         }
+         else {
+            unsafe_assign_unsigned( t );
+         }
+      }
+
+      compact_value( const double d ) noexcept  // NOLINT
+      {
+         unsafe_assign_double( d );
+      }
+
+      compact_value( const std::string_view sv )  // NOLINT
+      {
+         unsafe_assign_string( sv );
+      }
+
+      compact_value( const char* s )  // NOLINT
+         : compact_value( std::string_view( s ) )
+      {}
+
+      compact_value( const std::string& s )  // NOLINT
+         : compact_value( std::string_view( s ) )
+      {}
+
+      compact_value( const empty_string_t /*unused*/ ) noexcept  // NOLINT
+      {
+         unsafe_assign_string( std::string_view() );
+      }
+
+      compact_value( const tao::binary_view xv )  // NOLINT
+      {
+         unsafe_assign_binary( binary_t( xv.begin(), xv.end() ) );
+      }
+
+      compact_value( binary_t&& x )  // NOLINT
+      {
+         unsafe_assign_binary( std::move( x ) );
+      }
+
+      compact_value( const empty_binary_t /*unused*/ )  // NOLINT
+      {
+         unsafe_assign_binary( binary_t() );
+      }
+
+      compact_value( array_t&& a )  // NOLINT
+      {
+         unsafe_assign_array( std::move( a ) );
+      }
+
+      compact_value( const empty_array_t /*unused*/ )  // NOLINT
+      {
+         unsafe_assign_array( array_t() );
+      }
+
+      compact_value( object_t&& o )  // NOLINT
+      {
+         unsafe_assign_object( std::move( o ) );
+      }
+
+      compact_value( const empty_object_t /*unused*/ )  // NOLINT
+      {
+         unsafe_assign_object( object_t() );
+      }
+
+      ~compact_value() noexcept
+      {
+         unsafe_discard();
+      }
+
+      [[nodiscard]] static compact_value array( const std::initializer_list< compact_value >& l )
+      {
+         return compact_value( array_t( l ) );
+      }
+
+      [[nodiscard]] static compact_value object( const std::initializer_list< object_t::value_type >& l )
+      {
+         compact_value v( empty_object );
+         for( const auto& e : l ) {
+            v.emplace( e.first, e.second );
+         }
+         return v;
+      }
+
+      compact_value& operator=( compact_value v ) noexcept
+      {
+         unsafe_discard();
+         std::memcpy( m_data, v.m_data, sizeof( m_data ) );
+         m_type = v.m_type;
+         v.m_type = json::type::DISCARDED;
+         return *this;
+      }
+
+      void swap( compact_value& r ) noexcept
+      {
+         compact_value t( std::move( r ) );
+         r = std::move( *this );
+         ( *this ) = std::move( t );
+      }
+
+      [[nodiscard]] json::type type() const noexcept
+      {
+         return m_type;
+      }
+
+      [[nodiscard]] explicit operator bool() const noexcept
+      {
+         assert( m_type != json::type::DISCARDED );
+         return m_type != json::type::UNINITIALIZED;
+      }
+
+      [[nodiscard]] bool is_null() const noexcept
+      {
+         return m_type == json::type::NULL_;
+      }
+
+      [[nodiscard]] bool is_boolean() const noexcept
+      {
+         return m_type == json::type::BOOLEAN;
+      }
+
+      [[nodiscard]] bool is_signed() const noexcept
+      {
+         return m_type == json::type::SIGNED;
+      }
+
+      [[nodiscard]] bool is_unsigned() const noexcept
+      {
+         return m_type == json::type::UNSIGNED;
+      }
+
+      [[nodiscard]] bool is_integer() const noexcept
+      {
+         return is_signed() || is_unsigned();
+      }
+
+      [[nodiscard]] bool is_double() const noexcept
+      {
+         return m_type == json::type::DOUBLE;
+      }
+
+      [[nodiscard]] bool is_number() const noexcept
+      {
+         return is_integer() || is_double();
+      }
+
+      [[nodiscard]] bool is_string() const noexcept
+      {
+         return m_type == json::type::STRING;
+      }
+
+      [[nodiscard]] bool is_string_type() const noexcept
+      {
+         return is_string();
+      }
+
+      [[nodiscard]] bool is_binary() const noexcept
+      {
+         return m_type == json::type::BINARY;
+      }
+
+      [[nodiscard]] bool is_binary_type() const noexcept
+      {
+         return is_binary();
+      }
+
+      [[nodiscard]] bool is_array() const noexcept
+      {
+         return m_type == json::type::ARRAY;
+      }
+
+      [[nodiscard]] bool is_object() const noexcept
+      {
+         return m_type == json::type::OBJECT;
+      }
+
+      [[nodiscard]] bool is_discarded() const noexcept
+      {
+         return m_type == json::type::DISCARDED;
+      }
+
+      [[nodiscard]] bool is_uninitialized() const noexcept
+      {
+         return m_type == json::type::UNINITIALIZED;
+      }
+
+      // Strings of up to max_inline_string bytes are stored in the value.
+
+      [[nodiscard]] bool is_inline_string() const noexcept
+      {
+         return is_string() && ( inline_size() != heap_marker );
+      }
+
+      // The unsafe_get_*() accessor functions MUST NOT be
+      // called when the type of the value is not the one
+      // corresponding to the type of the accessor!
+
+      [[nodiscard]] bool unsafe_get_boolean() const noexcept
+      {
+         return load< bool >();
+      }
+
+      [[nodiscard]] std::int64_t unsafe_get_signed() const noexcept
+      {
+         return load< std::int64_t >();
+      }
+
+      [[nodiscard]] std::uint64_t unsafe_get_unsigned() const noexcept
+      {
+         return load< std::uint64_t >();
+      }
+
+      [[nodiscard]] double unsafe_get_double() const noexcept
+      {
+         return load< double >();
+      }
+
+      [[nodiscard]] std::string_view unsafe_get_string_type() const noexcept
+      {
+         const auto s = inline_size();
+         if( s != heap_marker ) {
+            return std::string_view( m_data, s );
+         }
+         return std::string_view( load< const char* >(), load< std::uint32_t >( sizeof( void* ) ) );
+      }
+
+      [[nodiscard]] tao::binary_view unsafe_get_binary_type() const noexcept
+      {
+         return *load< binary_t* >();
+      }
+
+      [[nodiscard]] array_t& unsafe_get_array() noexcept
+      {
+         return *load< array_t* >();
+      }
+
+      [[nodiscard]] const array_t& unsafe_get_array() const noexcept
+      {
+         return *load< const array_t* >();
+      }
+
+      [[nodiscard]] object_t& unsafe_get_object() noexcept
+      {
+         return *load< object_t* >();
+      }
+
+      [[nodiscard]] const object_t& unsafe_get_object() const noexcept
+      {
+         return *load< const object_t* >();
+      }
+
+      [[nodiscard]] bool get_boolean() const
+      {
+         validate_json_type( json::type::BOOLEAN );
+         return unsafe_get_boolean();
+      }
+
+      [[nodiscard]] std::int64_t get_signed() const
+      {
+         validate_json_type( json::type::SIGNED );
+         return unsafe_get_signed();
+      }
+
+      [[nodiscard]] std::uint64_t get_unsigned() const
+      {
+         validate_json_type( json::type::UNSIGNED );
+         return unsafe_get_unsigned();
+      }
+
+      [[nodiscard]] double get_double() const
+      {
+         validate_json_type( json::type::DOUBLE );
+         return unsafe_get_double();
+      }
+
+      [[nodiscard]] std::string_view get_string_type() const
+      {
+         validate_json_type( json::type::STRING );
+         return unsafe_get_string_type();
+      }
+
+      [[nodiscard]] tao::binary_view get_binary_type() const
+      {
+         validate_json_type( json::type::BINARY );
+         return unsafe_get_binary_type();
+      }
+
+      [[nodiscard]] array_t& get_array()
+      {
+         validate_json_type( json::type::ARRAY );
+         return unsafe_get_array();
+      }
+
+      [[nodiscard]] const array_t& get_array() const
+      {
+         validate_json_type( json::type::ARRAY );
+         return unsafe_get_array();
+      }
+
+      [[nodiscard]] object_t& get_object()
+      {
+         validate_json_type( json::type::OBJECT );
+         return unsafe_get_object();
+      }
+
+      [[nodiscard]] const object_t& get_object() const
+      {
+         validate_json_type( json::type::OBJECT );
+         return unsafe_get_object();
+      }
+
+      void unsafe_assign_null() noexcept
+      {
+         m_type = json::type::NULL_;
+      }
+
+      void unsafe_assign_boolean( const bool b ) noexcept
+      {
+         store( b );
+         m_type = json::type::BOOLEAN;
+      }
+
+      void unsafe_assign_signed( const std::int64_t i ) noexcept
+      {
+         store( i );
+         m_type = json::type::SIGNED;
+      }
+
+      void unsafe_assign_unsigned( const std::uint64_t u ) noexcept
+      {
+         store( u );
+         m_type = json::type::UNSIGNED;
+      }
+
+      void unsafe_assign_double( const double d ) noexcept
+      {
+         store( d );
+         m_type = json::type::DOUBLE;
+      }
+
+      void unsafe_assign_string( const std::string_view sv )
+      {
+         if( sv.size() <= max_inline_string ) {
+            sv.copy( m_data, sv.size() );
+            m_data[ inline_size_offset ] = static_cast< char >( sv.size() );
+         }
+         else {
+            if( sv.size() > 0xffffffff ) {
+               throw std::length_error( "string too long for tao::json::compact_value" );  // NOLINT
+            }
+            char* p = new char[ sv.size() ];
+            std::memcpy( p, sv.data(), sv.size() );
+            store( static_cast< const char* >( p ) );
+            store( static_cast< std::uint32_t >( sv.size() ), sizeof( void* ) );
+            m_data[ inline_size_offset ] = static_cast< char >( heap_marker );
+         }
+         m_type = json::type::STRING;
+      }
+
+      void unsafe_assign_binary( binary_t&& x )
+      {
+         store( new binary_t( std::move( x ) ) );
+         m_type = json::type::BINARY;
+      }
+
+      void unsafe_assign_array( array_t&& a )
+      {
+         store( new array_t( std::move( a ) ) );
+         m_type = json::type::ARRAY;
+      }
+
+      void unsafe_assign_object( object_t&& o )
+      {
+         store( new object_t( std::move( o ) ) );
+         m_type = json::type::OBJECT;
+      }
+
+      void prepare_array()
+      {
+         switch( m_type ) {
+            case json::type::UNINITIALIZED:
+            case json::type::DISCARDED:
+               unsafe_assign_array( array_t() );
+               [[fallthrough]];
+            case json::type::ARRAY:
+               break;
+            default:
+               throw std::logic_error( internal::format( "invalid json type '", m_type, "' for prepare_array()" ) );  // NOLINT
+         }
+      }
+
+      template< typename... Ts >
+      compact_value& emplace_back( Ts&&... ts )
+      {
+         prepare_array();
+         return unsafe_get_array().emplace_back( std::forward< Ts >( ts )... );
+      }
+
+      void push_back( compact_value v )
+      {
+         emplace_back( std::move( v ) );
+      }
+
+      void prepare_object()
+      {
+         switch( m_type ) {
+            case json::type::UNINITIALIZED:
+            case json::type::DISCARDED:
+               unsafe_assign_object( object_t() );
+               [[fallthrough]];
+            case json::type::OBJECT:
+               break;
+            default:
+               throw std::logic_error( internal::format( "invalid json type '", m_type, "' for prepare_object()" ) );  // NOLINT
+         }
+      }
+
+      template< typename K, typename... Ts >
+      std::pair< object_t::iterator, bool > emplace( K&& k, Ts&&... ts )
+      {
+         prepare_object();
+         auto r = unsafe_get_object().try_emplace( std::string( std::forward< K >( k ) ), std::forward< Ts >( ts )... );
+         if( !r.second ) {
+            throw std::runtime_error( internal::format( "duplicate JSON object key \"", internal::escape( r.first->first ), '"' ) );  // NOLINT
+         }
+         return r;
+      }
+
+      [[nodiscard]] compact_value* find( const std::size_t index )
+      {
+         auto& a = get_array();
+         return ( index < a.size() ) ? ( a.data() + index ) : nullptr;
+      }
+
+      [[nodiscard]] const compact_value* find( const std::size_t index ) const
+      {
+         const auto& a = get_array();
+         return ( index < a.size() ) ? ( a.data() + index ) : nullptr;
+      }
+
+      [[nodiscard]] compact_value* find( const std::string_view key )
+      {
+         auto& o = get_object();
+         const auto it = o.find( key );
+         return ( it != o.end() ) ? ( &it->second ) : nullptr;
+      }
+
+      [[nodiscard]] const compact_value* find( const std::string_view key ) const
+      {
+         const auto& o = get_object();
+         const auto it = o.find( key );
+         return ( it != o.end() ) ? ( &it->second ) : nullptr;
+      }
+
+      [[nodiscard]] const compact_value* find( const pointer& k ) const
+      {
+         const compact_value* v = this;
+         for( const auto& t : k ) {
+            v = v->is_array() ? v->find( t.index() ) : v->find( std::string_view( t.key() ) );
+            if( v == nullptr ) {
+               return nullptr;
+            }
+         }
+         return v;
+      }
+
+      [[nodiscard]] compact_value* find( const pointer& k )
+      {
+         return const_cast< compact_value* >( static_cast< const compact_value& >( *this ).find( k ) );
+      }
+
+      [[nodiscard]] compact_value& at( const std::size_t index )
+      {
+         return const_cast< compact_value& >( static_cast< const compact_value& >( *this ).at( index ) );
+      }
+
+      [[nodiscard]] const compact_value& at( const std::size_t index ) const
+      {
+         const auto& a = get_array();
+         if( index >= a.size() ) {
+            throw std::out_of_range( internal::format( "JSON array index '", index, "' out of bound '", a.size(), '\'' ) );  // NOLINT
+         }
+         return a[ index ];
+      }
+
+      [[nodiscard]] compact_value& at( const std::string_view key )
+      {
+         return const_cast< compact_value& >( static_cast< const compact_value& >( *this ).at( key ) );
+      }
+
+      [[nodiscard]] const compact_value& at( const std::string_view key ) const
+      {
+         const auto* v = find( key );
+         if( v == nullptr ) {
+            throw std::out_of_range( internal::format( "JSON object key \"", internal::escape( key ), "\" not found" ) );  // NOLINT
+         }
+         return *v;
+      }
+
+      [[nodiscard]] const compact_value& at( const pointer& k ) const
+      {
+         const compact_value* v = this;
+         for( const auto& t : k ) {
+            v = v->is_array() ? &v->at( t.index() ) : &v->at( std::string_view( t.key() ) );
+         }
+         return *v;
+      }
+
+      [[nodiscard]] compact_value& at( const pointer& k )
+      {
+         return const_cast< compact_value& >( static_cast< const compact_value& >( *this ).at( k ) );
+      }
+
+      [[nodiscard]] compact_value& operator[]( const std::size_t index ) noexcept
+      {
+         assert( m_type == json::type::ARRAY );
+         return unsafe_get_array()[ index ];
+      }
+
+      [[nodiscard]] const compact_value& operator[]( const std::size_t index ) const noexcept
+      {
+         assert( m_type == json::type::ARRAY );
+         return unsafe_get_array()[ index ];
+      }
+
+      [[nodiscard]] compact_value& operator[]( const std::string_view key )
+      {
+         prepare_object();
+         auto& o = unsafe_get_object();
+         const auto it = o.find( key );
+         if( it != o.end() ) {
+            return it->second;
+         }
+         return o.try_emplace( std::string( key ) ).first->second;
+      }
+
+      void erase( const std::size_t index )
+      {
+         auto& a = get_array();
+         if( index >= a.size() ) {
+            throw std::out_of_range( internal::format( "JSON array index '", index, "' out of bound '", a.size(), '\'' ) );  // NOLINT
+         }
+         a.erase( a.begin() + index );
+      }
+
+      void erase( const std::string_view key )
+      {
+         auto& o = get_object();
+         const auto it = o.find( key );
+         if( it == o.end() ) {
+            throw std::out_of_range( internal::format( "JSON object key \"", internal::escape( key ), "\" not found" ) );  // NOLINT
+         }
+         o.erase( it );
+      }
+
+      void unsafe_discard() noexcept
+      {
+         switch( m_type ) {
+            case json::type::STRING:
+               if( inline_size() == heap_marker ) {
+                  delete[] load< const char* >();
+               }
+               return;
+
+            case json::type::BINARY:
+               delete load< binary_t* >();
+               return;
+
+            case json::type::ARRAY:
+               delete load< array_t* >();
+               return;
+
+            case json::type::OBJECT:
+               delete load< object_t* >();
+               return;
+
+            default:
+               return;
+         }
+      }
+
+      void discard() noexcept
+      {
+         unsafe_discard();
+         m_type = json::type::DISCARDED;
+      }
+
+      void reset() noexcept
+      {
+         unsafe_discard();
+         m_type = json::type::UNINITIALIZED;
+      }
+
+      void validate_json_type( const json::type t ) const
+      {
+         if( m_type != t ) {
+            throw std::logic_error( internal::format( "invalid json type '", m_type, "', expected '", t, '\'' ) );  // NOLINT
+         }
+      }
+
+   private:
+      static constexpr std::size_t inline_size_offset = 14;
+      static constexpr std::uint8_t heap_marker = 0xff;
+
+      template< typename T >
+      [[nodiscard]] T load( const std::size_t offset = 0 ) const noexcept
+      {
+         T t;
+         std::memcpy( &t, m_data + offset, sizeof( T ) );
+         return t;
+      }
+
+      template< typename T >
+      void store( const T t, const std::size_t offset = 0 ) noexcept
+      {
+         std::memcpy( m_data + offset, &t, sizeof( T ) );
+      }
+
+      [[nodiscard]] std::uint8_t inline_size() const noexcept
+      {
+         return static_cast< std::uint8_t >( m_data[ inline_size_offset ] );
+      }
+
+      void embed( const compact_value& r )
+      {
+         switch( r.m_type ) {
+            case json::type::DISCARDED:
+               throw std::logic_error( "attempt to use a discarded value" );  // NOLINT
+
+            case json::type::STRING:
+               unsafe_assign_string( r.unsafe_get_string_type() );
+               return;
+
+            case json::type::BINARY:
+               unsafe_assign_binary( binary_t( *r.load< const binary_t* >() ) );
+               return;
+
+            case json::type::ARRAY:
+               unsafe_assign_array( array_t( r.unsafe_get_array() ) );
+               return;
+
+            case json::type::OBJECT:
+               unsafe_assign_object( object_t( r.unsafe_get_object() ) );
+               return;
+
+            default:
+               std::memcpy( m_data, r.m_data, sizeof( m_data ) );
+               m_type = r.m_type;
+               return;
+         }
+      }
+
+      alignas( 8 ) char m_data[ 15 ] = {};
+      json::type m_type = json::type::UNINITIALIZED;
+   };
+
+   static_assert( sizeof( compact_value ) == 16 );
+
+   [[nodiscard]] inline bool operator==( const compact_value& lhs, const compact_value& rhs ) noexcept
+   {
+      if( lhs.type() != rhs.type() ) {
+         switch( lhs.type() ) {
+            case type::SIGNED:
+               if( rhs.type() == type::UNSIGNED ) {
+                  const auto v = lhs.unsafe_get_signed();
+                  return ( v >= 0 ) && ( static_cast< std::uint64_t >( v ) == rhs.unsafe_get_unsigned() );
+               }
+               if( rhs.type() == type::DOUBLE ) {
+                  return lhs.unsafe_get_signed() == rhs.unsafe_get_double();
+               }
+               break;
+
+            case type::UNSIGNED:
+               if( rhs.type() == type::SIGNED ) {
+                  const auto v = rhs.unsafe_get_signed();
+                  return ( v >= 0 ) && ( lhs.unsafe_get_unsigned() == static_cast< std::uint64_t >( v ) );
+               }
+               if( rhs.type() == type::DOUBLE ) {
+                  return lhs.unsafe_get_unsigned() == rhs.unsafe_get_double();
+               }
+               break;
+
+            case type::DOUBLE:
+               if( rhs.type() == type::SIGNED ) {
+                  return lhs.unsafe_get_double() == rhs.unsafe_get_signed();
+               }
+               if( rhs.type() == type::UNSIGNED ) {
+                  return lhs.unsafe_get_double() == rhs.unsafe_get_unsigned();
+               }
+               break;
+
+            default:
+               break;
+         }
+         return false;
+      }
+
+      switch( lhs.type() ) {
+         case type::BOOLEAN:
+            return lhs.unsafe_get_boolean() == rhs.unsafe_get_boolean();
+
+         case type::SIGNED:
+            return lhs.unsafe_get_signed() == rhs.unsafe_get_signed();
+
+         case type::UNSIGNED:
+            return lhs.unsafe_get_unsigned() == rhs.unsafe_get_unsigned();
+
+         case type::DOUBLE:
+            return lhs.unsafe_get_double() == rhs.unsafe_get_double();
+
+         case type::STRING:
+            return lhs.unsafe_get_string_type() == rhs.unsafe_get_string_type();
+
+         case type::BINARY:
+            return lhs.unsafe_get_binary_type() == rhs.unsafe_get_binary_type();
+
+         case type::ARRAY:
+            return lhs.unsafe_get_array() == rhs.unsafe_get_array();
+
+         case type::OBJECT:
+            return lhs.unsafe_get_object() == rhs.unsafe_get_object();
+
+         default:
+            return true;
+      }
+   }
+
+   [[nodiscard]] inline bool operator!=( const compact_value& lhs, const compact_value& rhs ) noexcept
+   {
+      return !( lhs == rhs );
+   }
+
+   namespace events
+   {
+      // Events consumer to build a compact_value.
+
+      struct to_compact_value
+      {
+         std::vector< compact_value > stack_;
+         std::vector< std::string > keys_;
+         compact_value value;
+
+         void null()
+         {
+            value.unsafe_assign_null();
+         }
+
+         void boolean( const bool v )
+         {
+            value.unsafe_assign_boolean( v );
+         }
+
+         void number( const std::int64_t v )
+         {
+            value.unsafe_assign_signed( v );
+         }
+
+         void number( const std::uint64_t v )
+         {
+            value.unsafe_assign_unsigned( v );
+         }
+
+         void number( const double v )
+         {
+            value.unsafe_assign_double( v );
+         }
+
+         void string( const std::string_view v )
+         {
+            value.unsafe_assign_string( v );
+         }
+
+         void binary( const tao::binary_view v )
+         {
+            value.unsafe_assign_binary( compact_value::binary_t( v.begin(), v.end() ) );
+         }
+
+         void binary( std::vector< std::byte >&& v )
+         {
+            value.unsafe_assign_binary( std::move( v ) );
+         }
+
+         void begin_array( const std::size_t size = 0 )
+         {
+            stack_.emplace_back( empty_array );
+            stack_.back().unsafe_get_array().reserve( size );
+         }
+
+         void element()
+         {
+            stack_.back().unsafe_get_array().emplace_back( std::move( value ) );
+         }
+
+         void end_array( const std::size_t /*unused*/ = 0 )
+         {
+            value = std::move( stack_.back() );
+            stack_.pop_back();
+         }
+
+         void begin_object( const std::size_t /*unused*/ = 0 )
+         {
+            stack_.emplace_back( empty_object );
+         }
+
+         void key( const std::string_view v )
+         {
+            keys_.emplace_back( v );
+         }
+
+         void key( std::string&& v )
+         {
+            keys_.emplace_back( std::move( v ) );
+         }
+
+         void member()
+         {
+            stack_.back().emplace( std::move( keys_.back() ), std::move( value ) );
+            keys_.pop_back();
+         }
+
+         void end_object( const std::size_t /*unused*/ = 0 )
+         {
+            value = std::move( stack_.back() );
+            stack_.pop_back();
+         }
+      };
+
+      // Events producer to generate events from a compact_value.
+
+      template< typename Consumer >
+      void from_compact_value( Consumer& consumer, const compact_value& v )
+      {
+         switch( v.type() ) {
+            case type::UNINITIALIZED:
+               throw std::logic_error( "unable to produce events from uninitialized values" );  // NOLINT
+
+            case type::DISCARDED:
+               throw std::logic_error( "unable to produce events from discarded values" );  // NOLINT
+
+            case type::NULL_:
+               consumer.null();
+               return;
+
+            case type::BOOLEAN:
+               consumer.boolean( v.unsafe_get_boolean() );
+               return;
+
+            case type::SIGNED:
+               consumer.number( v.unsafe_get_signed() );
+               return;
+
+            case type::UNSIGNED:
+               consumer.number( v.unsafe_get_unsigned() );
+               return;
+
+            case type::DOUBLE:
+               consumer.number( v.unsafe_get_double() );
+               return;
+
+            case type::STRING:
+               consumer.string( v.unsafe_get_string_type() );
+               return;
+
+            case type::BINARY:
+               consumer.binary( v.unsafe_get_binary_type() );
+               return;
+
+            case type::ARRAY: {
+               const auto& a = v.unsafe_get_array();
+               const auto s = a.size();
+               consumer.begin_array( s );
+               for( const auto& e : a ) {
+                  events::from_compact_value( consumer, e );
+                  consumer.element();
+               }
+               consumer.end_array( s );
+               return;
+            }
+
+            case type::OBJECT: {
+               const auto& o = v.unsafe_get_object();
+               const auto s = o.size();
+               consumer.begin_object( s );
+               for( const auto& e : o ) {
+                  consumer.key( e.first );
+                  events::from_compact_value( consumer, e.second );
+                  consumer.member();
+               }
+               consumer.end_object( s );
+               return;
+            }
+
+            default:
+               break;
+         }
+         throw std::logic_error( internal::format( "invalid value '", static_cast< std::uint8_t >( v.type() ), "' for tao::json::compact_value" ) );  // NOLINT, LCOV_EXCL_LINE
+      }
+
+   }  // namespace events
+
+   template< template< typename... > class... Transformers, typename... Ts >
+   [[nodiscard]] compact_value compact_from_string( Ts&&... ts )
+   {
+      events::transformer< events::to_compact_value, Transformers... > consumer;
+      events::from_string( consumer, std::forward< Ts >( ts )... );
+      return std::move( consumer.value );
+   }
+
+   inline std::ostream& operator<<( std::ostream& o, const compact_value& v )
+   {
+      events::to_stream consumer( o );
+      events::from_compact_value( consumer, v );
+      return o;
+   }
+
+}  // namespace tao::json
+
+#endif
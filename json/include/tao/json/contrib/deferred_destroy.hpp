@@ -0,0 +1,222 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_CONTRIB_DEFERRED_DESTROY_HPP
+#define TAO_JSON_CONTRIB_DEFERRED_DESTROY_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../basic_value.hpp"
+
+namespace tao::json
+{
+   namespace internal
+   {
+      // Approximates the heap memory used by a Value, excluding the Value
+      // itself; stops counting as soon as the result reaches limit.
+
+      template< template< typename... > class Traits >
+      [[nodiscard]] std::size_t estimate_size( const basic_value< Traits >& v, const std::size_t limit )
+      {
+         using array_t = typename basic_value< Traits >::array_t;
+         using object_t = typename basic_value< Traits >::object_t;
+
+         std::size_t result = 0;
+         std::vector< const basic_value< Traits >* > stack( 1, &v );
+         while( !stack.empty() && ( result < limit ) ) {
+            const auto& e = *stack.back();
+            stack.pop_back();
+            switch( e.type() ) {
+               case type::STRING:
+                  result += e.unsafe_get_string().capacity();
+                  break;
+
+               case type::BINARY:
+                  result += e.unsafe_get_binary().capacity();
+                  break;
+
+               case type::ARRAY: {
+                  const auto& a = e.unsafe_get_array();
+                  result += a.size() * sizeof( typename array_t::value_type );
+                  if( result < limit ) {
+                     for( const auto& i : a ) {
+                        stack.push_back( &i );
+                     }
+                  }
+               } break;
+
+               case type::OBJECT: {
+                  const auto& o = e.unsafe_get_object();
+                  result += o.size() * ( sizeof( typename object_t::value_type ) + 4 * sizeof( void* ) );
+                  if( result < limit ) {
+                     for( const auto& i : o ) {
+                        result += i.first.size();
+                        stack.push_back( &i.second );
+                     }
+                  }
+               } break;
+
+               default:
+                  break;
+            }
+         }
+         return result;
+      }
+
+   }  // namespace internal
+
+   // Destroys Values in a background thread to keep the latency of freeing
+   // large documents off the calling thread. Only Values that use at least
+   // min_bytes of memory are deferred, and when max_queue Values are already
+   // waiting to be destroyed, the calling thread destroys the Value itself.
+
+   class reclaimer
+   {
+   public:
+      struct statistics
+      {
+         std::size_t depth = 0;      // Values currently waiting.
+         std::size_t max_depth = 0;  // Largest depth so far.
+         std::size_t deferred = 0;   // Values passed to the background thread.
+         std::size_t reclaimed = 0;  // Values destroyed by the background thread.
+         std::size_t direct = 0;     // Values destroyed by the calling thread.
+      };
+
+      explicit reclaimer( const std::size_t min_bytes = 1024 * 1024, const std::size_t max_queue = 64 )
+         : m_min_bytes( min_bytes ),
+           m_max_queue( max_queue ),
+           m_thread( [this]() { run(); } )
+      {}
+
+      reclaimer( const reclaimer& ) = delete;
+      reclaimer( reclaimer&& ) = delete;
+
+      ~reclaimer()
+      {
+         {
+            const std::lock_guard lock( m_mutex );
+            m_stop = true;
+         }
+         m_wake.notify_one();
+         m_thread.join();
+      }
+
+      void operator=( const reclaimer& ) = delete;
+      void operator=( reclaimer&& ) = delete;
+
+      template< template< typename... > class Traits >
+      void destroy( basic_value< Traits >&& v )
+      {
+         basic_value< Traits > t( std::move( v ) );
+         if( ( m_max_queue == 0 ) || ( internal::estimate_size( t, m_min_bytes ) < m_min_bytes ) ) {
+            const std::lock_guard lock( m_mutex );
+            ++m_statistics.direct;
+            return;
+         }
+         auto g = std::make_unique< garbage< basic_value< Traits > > >( std::move( t ) );
+         {
+            const std::lock_guard lock( m_mutex );
+            if( m_queue.size() >= m_max_queue ) {
+               ++m_statistics.direct;
+               return;
+            }
+            m_queue.emplace_back( std::move( g ) );
+            ++m_statistics.deferred;
+            m_statistics.depth = m_queue.size();
+            m_statistics.max_depth = std::max( m_statistics.max_depth, m_statistics.depth );
+         }
+         m_wake.notify_one();
+      }
+
+      // Blocks until all deferred Values are destroyed.
+      void wait()
+      {
+         std::unique_lock lock( m_mutex );
+         m_idle.wait( lock, [this]() { return m_queue.empty() && !m_busy; } );
+      }
+
+      [[nodiscard]] statistics stats() const
+      {
+         const std::lock_guard lock( m_mutex );
+         return m_statistics;
+      }
+
+      [[nodiscard]] static reclaimer& global()
+      {
+         static reclaimer r;
+         return r;
+      }
+
+   private:
+      struct garbage_base
+      {
+         virtual ~garbage_base() = default;
+      };
+
+      template< typename T >
+      struct garbage
+         : garbage_base
+      {
+         explicit garbage( T&& t ) noexcept
+            : value( std::move( t ) )
+         {}
+
+         T value;
+      };
+
+      void run()
+      {
+         std::unique_lock lock( m_mutex );
+         while( true ) {
+            m_wake.wait( lock, [this]() { return m_stop || !m_queue.empty(); } );
+            if( m_queue.empty() ) {
+               return;
+            }
+            auto g = std::move( m_queue.front() );
+            m_queue.pop_front();
+            m_statistics.depth = m_queue.size();
+            m_busy = true;
+            lock.unlock();
+            g.reset();
+            lock.lock();
+            m_busy = false;
+            ++m_statistics.reclaimed;
+            if( m_queue.empty() ) {
+               m_idle.notify_all();
+            }
+         }
+      }
+
+      const std::size_t m_min_bytes;
+      const std::size_t m_max_queue;
+
+      mutable std::mutex m_mutex;
+      std::condition_variable m_wake;
+      std::condition_variable m_idle;
+      std::deque< std::unique_ptr< garbage_base > > m_queue;
+      statistics m_statistics;
+      bool m_busy = false;
+      bool m_stop = false;
+
+      std::thread m_thread;
+   };
+
+   // Moves the Value to reclaimer::global() for destruction.
+
+   template< template< typename... > class Traits >
+   void deferred_destroy( basic_value< Traits >&& v )
+   {
+      reclaimer::global().destroy( std::move( v ) );
+   }
+
+}  // namespace tao::json
+
+#endif
@@ -4,27 +4,92 @@
 #ifndef TAO_JSON_CONTRIB_DIFF_HPP
 #define TAO_JSON_CONTRIB_DIFF_HPP
 
-#include <algorithm>
-#include <iterator>
+#include <cstddef>
 #include <stdexcept>
 #include <utility>
 
 #include "../pointer.hpp"
 #include "../value.hpp"
 
+#include "../internal/type_traits.hpp"
+
 namespace tao::json
 {
    namespace internal
    {
-      template< typename... Ts >
-      void move_append( std::vector< Ts... >& lhs, std::vector< Ts... >& rhs )
+      template< template< typename... > class Traits >
+      [[nodiscard]] bool is_same_container( const basic_value< Traits >& lhs, const basic_value< Traits >& rhs ) noexcept
+      {
+         return lhs.is_array() ? is_same_storage( lhs.unsafe_get_array(), rhs.unsafe_get_array() ) : is_same_storage( lhs.unsafe_get_object(), rhs.unsafe_get_object() );
+      }
+
+      // Appends the operations to result; path is extended and restored
+      // instead of copied on every level of the recursion.
+
+      template< template< typename... > class Traits >
+      void diff( const basic_value< Traits >& source, const basic_value< Traits >& destination, pointer& path, basic_value< Traits >& result )
       {
-         if( lhs.empty() ) {
-            lhs = std::move( rhs );
+         if( ( source.type() != destination.type() ) || !( source.is_array() || source.is_object() ) ) {
+            // Arrays and Objects are not compared as a whole since that would
+            // compare them again on every level of the recursion.
+            if( !( source == destination ) ) {
+               result.push_back( { { "op", "replace" },
+                                   { "path", to_string( path ) },
+                                   { "value", destination } } );
+            }
+            return;
          }
-         else if( !rhs.empty() ) {
-            lhs.reserve( lhs.size() + rhs.size() );
-            std::move( std::begin( rhs ), std::end( rhs ), std::back_inserter( lhs ) );
+         if( is_same_container( source, destination ) ) {
+            return;
+         }
+         if( source.is_array() ) {
+            const auto ss = source.unsafe_get_array().size();
+            const auto ds = destination.unsafe_get_array().size();
+            std::size_t i = 0;
+            while( ( i < ss ) && ( i < ds ) ) {
+               path += i;
+               diff( source.unsafe_at( i ), destination.unsafe_at( i ), path, result );
+               path.pop_back();
+               ++i;
+            }
+            const auto s = ss + i - 1;
+            while( i < ss ) {
+               result.push_back( { { "op", "remove" },
+                                   { "path", to_string( path + ( s - i ) ) } } );
+               ++i;
+            }
+            while( i < ds ) {
+               result.push_back( { { "op", "add" },
+                                   { "path", to_string( path + i ) },
+                                   { "value", destination.unsafe_at( i ) } } );
+               ++i;
+            }
+         }
+         else {
+            const auto& sm = source.unsafe_get_object();
+            const auto& dm = destination.unsafe_get_object();
+            auto sit = sm.begin();
+            auto dit = dm.begin();
+            while( ( sit != sm.end() ) || ( dit != dm.end() ) ) {
+               if( ( sit == sm.end() ) || ( ( dit != dm.end() ) && ( sit->first > dit->first ) ) ) {
+                  result.push_back( { { "op", "add" },
+                                      { "path", to_string( path + dit->first ) },
+                                      { "value", dit->second } } );
+                  ++dit;
+               }
+               else if( ( dit == dm.end() ) || ( ( sit != sm.end() ) && ( sit->first < dit->first ) ) ) {
+                  result.push_back( { { "op", "remove" },
+                                      { "path", to_string( path + sit->first ) } } );
+                  ++sit;
+               }
+               else {
+                  path += sit->first;
+                  diff( sit->second, dit->second, path, result );
+                  path.pop_back();
+                  ++sit;
+                  ++dit;
+               }
+            }
          }
       }
 
@@ -34,69 +99,8 @@ namespace tao::json
    [[nodiscard]] basic_value< Traits > diff( const basic_value< Traits >& source, const basic_value< Traits >& destination, const pointer& path = pointer() )
    {
       basic_value< Traits > result = empty_array;
-      if( source == destination ) {
-         return result;
-      }
-      if( source.type() != destination.type() ) {
-         result.push_back( { { "op", "replace" },
-                             { "path", to_string( path ) },
-                             { "value", destination } } );
-      }
-      else {
-         switch( source.type() ) {
-            case type::ARRAY: {
-               const auto ss = source.unsafe_get_array().size();
-               const auto ds = destination.unsafe_get_array().size();
-               std::size_t i = 0;
-               while( ( i < ss ) && ( i < ds ) ) {
-                  internal::move_append( result.unsafe_get_array(), diff( source.unsafe_at( i ), destination.unsafe_at( i ), path + i ).unsafe_get_array() );
-                  ++i;
-               }
-               const auto s = ss + i - 1;
-               while( i < ss ) {
-                  result.push_back( { { "op", "remove" },
-                                      { "path", to_string( path + ( s - i ) ) } } );
-                  ++i;
-               }
-               while( i < ds ) {
-                  result.push_back( { { "op", "add" },
-                                      { "path", to_string( path + i ) },
-                                      { "value", destination.unsafe_at( i ) } } );
-                  ++i;
-               }
-            } break;
-
-            case type::OBJECT: {
-               const auto& sm = source.unsafe_get_object();
-               const auto& dm = destination.unsafe_get_object();
-               auto sit = sm.begin();
-               auto dit = dm.begin();
-               while( ( sit != sm.end() ) || ( dit != dm.end() ) ) {
-                  if( ( sit == sm.end() ) || ( ( dit != dm.end() ) && ( sit->first > dit->first ) ) ) {
-                     result.push_back( { { "op", "add" },
-                                         { "path", to_string( path + dit->first ) },
-                                         { "value", dit->second } } );
-                     ++dit;
-                  }
-                  else if( ( dit == dm.end() ) || ( ( sit != sm.end() ) && ( sit->first < dit->first ) ) ) {
-                     result.push_back( { { "op", "remove" },
-                                         { "path", to_string( path + sit->first ) } } );
-                     ++sit;
-                  }
-                  else {
-                     internal::move_append( result.unsafe_get_array(), diff( sit->second, dit->second, path + sit->first ).unsafe_get_array() );
-                     ++sit;
-                     ++dit;
-                  }
-               }
-            } break;
-
-            default:
-               result.push_back( { { "op", "replace" },
-                                   { "path", to_string( path ) },
-                                   { "value", destination } } );
-         }
-      }
+      pointer p = path;
+      internal::diff( source, destination, p, result );
       return result;
    }
 
@@ -0,0 +1,348 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_CONTRIB_FLAT_OBJECT_HPP
+#define TAO_JSON_CONTRIB_FLAT_OBJECT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../basic_value.hpp"
+#include "../events/from_string.hpp"
+#include "../events/to_value.hpp"
+#include "../events/transformer.hpp"
+#include "../internal/format.hpp"
+#include "../traits.hpp"
+
+namespace tao::json
+{
+   // Object storage for basic_value backed by a sorted std::vector of
+   // key/value pairs. The interface is the subset of std::map that the
+   // library uses, with the same iteration order, but lookups are binary
+   // searches in contiguous memory and there is no allocation per member.
+   // Insertions and erasures move the following members and invalidate
+   // iterators and references to them, unlike std::map.
+
+   // The key type K must be constructible from, and convertible to, a
+   // std::string_view, and comparable with std::string_view; see
+   // contrib/interned_key.hpp for an alternative to std::string.
+
+   // The events::to_basic_value consumer collects the members of an object
+   // in a scratch buffer and moves them into the flat_object in end_object()
+   // with unsafe_assign_unsorted(), i.e. with one allocation and one sort.
+
+   template< typename V, typename K = std::string >
+   class flat_object
+   {
+   public:
+      using key_type = K;
+      using mapped_type = V;
+      using value_type = std::pair< K, V >;
+      using container_type = std::vector< value_type >;
+      using size_type = typename container_type::size_type;
+      using iterator = typename container_type::iterator;
+      using const_iterator = typename container_type::const_iterator;
+
+      flat_object() = default;
+
+      flat_object( std::initializer_list< value_type > l )
+      {
+         m_data.reserve( l.size() );
+         for( const auto& e : l ) {
+            emplace( e );
+         }
+      }
+
+      [[nodiscard]] bool empty() const noexcept
+      {
+         return m_data.empty();
+      }
+
+      [[nodiscard]] size_type size() const noexcept
+      {
+         return m_data.size();
+      }
+
+      void reserve( const size_type n )
+      {
+         m_data.reserve( n );
+      }
+
+      void clear() noexcept
+      {
+         m_data.clear();
+      }
+
+      [[nodiscard]] iterator begin() noexcept
+      {
+         return m_data.begin();
+      }
+
+      [[nodiscard]] const_iterator begin() const noexcept
+      {
+         return m_data.begin();
+      }
+
+      [[nodiscard]] const_iterator cbegin() const noexcept
+      {
+         return m_data.cbegin();
+      }
+
+      [[nodiscard]] iterator end() noexcept
+      {
+         return m_data.end();
+      }
+
+      [[nodiscard]] const_iterator end() const noexcept
+      {
+         return m_data.end();
+      }
+
+      [[nodiscard]] const_iterator cend() const noexcept
+      {
+         return m_data.cend();
+      }
+
+      [[nodiscard]] iterator lower_bound( const std::string_view k ) noexcept
+      {
+         return std::lower_bound( m_data.begin(), m_data.end(), k, key_less() );
+      }
+
+      [[nodiscard]] const_iterator lower_bound( const std::string_view k ) const noexcept
+      {
+         return std::lower_bound( m_data.begin(), m_data.end(), k, key_less() );
+      }
+
+      [[nodiscard]] iterator find( const std::string_view k ) noexcept
+      {
+         const auto it = lower_bound( k );
+         return ( ( it != m_data.end() ) && ( it->first == k ) ) ? it : m_data.end();
+      }
+
+      [[nodiscard]] const_iterator find( const std::string_view k ) const noexcept
+      {
+         const auto it = lower_bound( k );
+         return ( ( it != m_data.end() ) && ( it->first == k ) ) ? it : m_data.end();
+      }
+
+      [[nodiscard]] size_type count( const std::string_view k ) const noexcept
+      {
+         return ( find( k ) == m_data.end() ) ? 0 : 1;
+      }
+
+      [[nodiscard]] V& at( const std::string_view k )
+      {
+         const auto it = find( k );
+         if( it == m_data.end() ) {
+            throw std::out_of_range( internal::format( "key \"", k, "\" not found in flat_object" ) );
+         }
+         return it->second;
+      }
+
+      [[nodiscard]] const V& at( const std::string_view k ) const
+      {
+         const auto it = find( k );
+         if( it == m_data.end() ) {
+            throw std::out_of_range( internal::format( "key \"", k, "\" not found in flat_object" ) );
+         }
+         return it->second;
+      }
+
+      template< typename T >
+      [[nodiscard]] V& operator[]( T&& k )
+      {
+         return try_emplace( std::forward< T >( k ) ).first->second;
+      }
+
+      std::pair< iterator, bool > insert( value_type&& t )
+      {
+         const auto it = lower_bound( t.first );
+         if( ( it != m_data.end() ) && ( it->first == t.first ) ) {
+            return { it, false };
+         }
+         return { m_data.insert( it, std::move( t ) ), true };
+      }
+
+      std::pair< iterator, bool > insert( const value_type& t )
+      {
+         return insert( value_type( t ) );
+      }
+
+      template< typename... Ts >
+      std::pair< iterator, bool > emplace( Ts&&... ts )
+      {
+         return insert( value_type( std::forward< Ts >( ts )... ) );
+      }
+
+      template< typename T, typename... Ts >
+      std::pair< iterator, bool > try_emplace( T&& k, Ts&&... ts )
+      {
+         const std::string_view sv = k;
+         const auto it = lower_bound( sv );
+         if( ( it != m_data.end() ) && ( it->first == sv ) ) {
+            return { it, false };
+         }
+         return { m_data.emplace( it, std::piecewise_construct, std::forward_as_tuple( std::forward< T >( k ) ), std::forward_as_tuple( std::forward< Ts >( ts )... ) ), true };
+      }
+
+      size_type erase( const std::string_view k )
+      {
+         const auto it = find( k );
+         if( it == m_data.end() ) {
+            return 0;
+         }
+         m_data.erase( it );
+         return 1;
+      }
+
+      iterator erase( const const_iterator it )
+      {
+         return m_data.erase( it );
+      }
+
+      // Replaces the contents with the members in [b, e), which are moved
+      // from and can be in any order. Returns an iterator to a member with
+      // a duplicate key, or end() when all keys are unique.
+      template< typename I >
+      [[nodiscard]] iterator unsafe_assign_unsorted( const I b, const I e )
+      {
+         const std::size_t n = e - b;
+         m_data.clear();
+         m_data.reserve( n );
+         if( std::adjacent_find( b, e, key_greater_equal() ) == e ) {
+            m_data.insert( m_data.end(), std::make_move_iterator( b ), std::make_move_iterator( e ) );
+            return m_data.end();
+         }
+         if( n <= small_size ) {
+            // Sort an index instead of the members so that each is moved once.
+            std::array< std::size_t, small_size > index;
+            for( std::size_t i = 0; i < n; ++i ) {
+               std::size_t j = i;
+               while( ( j > 0 ) && ( b[ i ].first < b[ index[ j - 1 ] ].first ) ) {
+                  index[ j ] = index[ j - 1 ];
+                  --j;
+               }
+               index[ j ] = i;
+            }
+            for( std::size_t i = 0; i < n; ++i ) {
+               m_data.emplace_back( std::move( b[ index[ i ] ] ) );
+            }
+         }
+         else {
+            m_data.insert( m_data.end(), std::make_move_iterator( b ), std::make_move_iterator( e ) );
+            std::sort( m_data.begin(), m_data.end(), []( const value_type& l, const value_type& r ) { return l.first < r.first; } );
+         }
+         return std::adjacent_find( m_data.begin(), m_data.end(), []( const value_type& l, const value_type& r ) { return l.first == r.first; } );
+      }
+
+      [[nodiscard]] friend bool operator==( const flat_object& l, const flat_object& r )
+      {
+         return l.m_data == r.m_data;
+      }
+
+      [[nodiscard]] friend bool operator!=( const flat_object& l, const flat_object& r )
+      {
+         return !( l == r );
+      }
+
+      [[nodiscard]] friend bool operator<( const flat_object& l, const flat_object& r )
+      {
+         return l.m_data < r.m_data;
+      }
+
+      [[nodiscard]] friend bool operator>( const flat_object& l, const flat_object& r )
+      {
+         return r < l;
+      }
+
+      [[nodiscard]] friend bool operator<=( const flat_object& l, const flat_object& r )
+      {
+         return !( r < l );
+      }
+
+      [[nodiscard]] friend bool operator>=( const flat_object& l, const flat_object& r )
+      {
+         return !( l < r );
+      }
+
+   private:
+      static constexpr std::size_t small_size = 32;
+
+      struct key_greater_equal
+      {
+         [[nodiscard]] bool operator()( const value_type& l, const value_type& r ) const noexcept
+         {
+            return !( l.first < r.first );
+         }
+      };
+
+      struct key_less
+      {
+         [[nodiscard]] bool operator()( const value_type& l, const std::string_view r ) const noexcept
+         {
+            return l.first < r;
+         }
+      };
+
+      container_type m_data;
+   };
+
+   template< typename T >
+   struct flat_traits
+      : public traits< T >
+   {};
+
+   template<>
+   struct flat_traits< void >
+      : public traits< void >
+   {
+      template< typename V >
+      using object_t = flat_object< V >;
+   };
+
+   template< template< typename... > class Traits, typename K >
+   struct traits< flat_object< basic_value< Traits >, K > >
+   {
+      static void assign( basic_value< Traits >& v, const flat_object< basic_value< Traits >, K >& o )
+      {
+         v.unsafe_assign_object( o );
+      }
+
+      static void assign( basic_value< Traits >& v, flat_object< basic_value< Traits >, K >&& o ) noexcept
+      {
+         v.unsafe_assign_object( std::move( o ) );
+      }
+
+      template< template< typename... > class, typename Consumer >
+      static void produce( Consumer& c, const flat_object< basic_value< Traits >, K >& o )
+      {
+         c.begin_object( o.size() );
+         for( const auto& i : o ) {
+            c.key( i.first );
+            Traits< basic_value< Traits > >::produce( c, i.second );
+            c.member();
+         }
+         c.end_object( o.size() );
+      }
+   };
+
+   using flat_value = basic_value< flat_traits >;
+
+   template< template< typename... > class... Transformers >
+   [[nodiscard]] flat_value flat_from_string( const std::string_view data, const std::string& source = std::string() )
+   {
+      json::events::transformer< json::events::to_basic_value< flat_traits >, Transformers... > consumer;
+      json::events::from_string( consumer, data, source );
+      return std::move( consumer.value );
+   }
+
+}  // namespace tao::json
+
+#endif
@@ -0,0 +1,411 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_CONTRIB_HASH_OBJECT_HPP
+#define TAO_JSON_CONTRIB_HASH_OBJECT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../basic_value.hpp"
+#include "../events/from_string.hpp"
+#include "../events/to_value.hpp"
+#include "../events/transformer.hpp"
+#include "../internal/format.hpp"
+#include "../traits.hpp"
+
+#include "flat_object.hpp"
+
+namespace tao::json
+{
+   // Object storage for basic_value for Objects with many members. The
+   // members are kept in a flat_object, i.e. a sorted std::vector, so the
+   // iteration order is that of std::map, and Objects with more than
+   // small_size members additionally get an open-addressing hash table
+   // with linear probing that maps the keys to positions in the vector.
+   // Lookups are therefore O(1) and touch two cache lines in the common
+   // case, smaller Objects use the binary search of flat_object.
+
+   // Insertions and erasures are linear in the size of the Object, as for
+   // flat_object, except for insertions of keys that are greater than all
+   // other keys; parsing builds the table once per Object.
+
+   template< typename V, typename K = std::string >
+   class hash_object
+   {
+   public:
+      using key_type = K;
+      using mapped_type = V;
+      using container_type = flat_object< V, K >;
+      using value_type = typename container_type::value_type;
+      using size_type = typename container_type::size_type;
+      using iterator = typename container_type::iterator;
+      using const_iterator = typename container_type::const_iterator;
+
+      static constexpr std::size_t small_size = 16;
+
+      hash_object() = default;
+
+      hash_object( std::initializer_list< value_type > l )
+      {
+         m_data.reserve( l.size() );
+         for( const auto& e : l ) {
+            emplace( e );
+         }
+      }
+
+      [[nodiscard]] bool empty() const noexcept
+      {
+         return m_data.empty();
+      }
+
+      [[nodiscard]] size_type size() const noexcept
+      {
+         return m_data.size();
+      }
+
+      void reserve( const size_type n )
+      {
+         m_data.reserve( n );
+      }
+
+      void clear() noexcept
+      {
+         m_data.clear();
+         m_index.clear();
+      }
+
+      [[nodiscard]] iterator begin() noexcept
+      {
+         return m_data.begin();
+      }
+
+      [[nodiscard]] const_iterator begin() const noexcept
+      {
+         return m_data.begin();
+      }
+
+      [[nodiscard]] const_iterator cbegin() const noexcept
+      {
+         return m_data.cbegin();
+      }
+
+      [[nodiscard]] iterator end() noexcept
+      {
+         return m_data.end();
+      }
+
+      [[nodiscard]] const_iterator end() const noexcept
+      {
+         return m_data.end();
+      }
+
+      [[nodiscard]] const_iterator cend() const noexcept
+      {
+         return m_data.cend();
+      }
+
+      [[nodiscard]] iterator lower_bound( const std::string_view k ) noexcept
+      {
+         return m_data.lower_bound( k );
+      }
+
+      [[nodiscard]] const_iterator lower_bound( const std::string_view k ) const noexcept
+      {
+         return m_data.lower_bound( k );
+      }
+
+      [[nodiscard]] iterator find( const std::string_view k ) noexcept
+      {
+         return m_data.begin() + ( std::as_const( *this ).find( k ) - m_data.cbegin() );
+      }
+
+      [[nodiscard]] const_iterator find( const std::string_view k ) const noexcept
+      {
+         if( m_index.empty() ) {
+            return m_data.find( k );
+         }
+         const std::uint32_t h = hash( k );
+         for( std::size_t i = h & mask();; i = ( i + 1 ) & mask() ) {
+            const slot s = m_index[ i ];
+            if( s.position == 0 ) {
+               return m_data.end();
+            }
+            if( s.hash == h ) {
+               const auto it = m_data.begin() + ( s.position - 1 );
+               if( it->first == k ) {
+                  return it;
+               }
+            }
+         }
+      }
+
+      [[nodiscard]] size_type count( const std::string_view k ) const noexcept
+      {
+         return ( find( k ) == m_data.end() ) ? 0 : 1;
+      }
+
+      [[nodiscard]] V& at( const std::string_view k )
+      {
+         const auto it = find( k );
+         if( it == m_data.end() ) {
+            throw std::out_of_range( internal::format( "key \"", k, "\" not found in hash_object" ) );
+         }
+         return it->second;
+      }
+
+      [[nodiscard]] const V& at( const std::string_view k ) const
+      {
+         const auto it = find( k );
+         if( it == m_data.end() ) {
+            throw std::out_of_range( internal::format( "key \"", k, "\" not found in hash_object" ) );
+         }
+         return it->second;
+      }
+
+      template< typename T >
+      [[nodiscard]] V& operator[]( T&& k )
+      {
+         const auto it = find( k );
+         if( it != m_data.end() ) {
+            return it->second;
+         }
+         return try_emplace( std::forward< T >( k ) ).first->second;
+      }
+
+      std::pair< iterator, bool > insert( value_type&& t )
+      {
+         return inserted( m_data.insert( std::move( t ) ) );
+      }
+
+      std::pair< iterator, bool > insert( const value_type& t )
+      {
+         return insert( value_type( t ) );
+      }
+
+      template< typename... Ts >
+      std::pair< iterator, bool > emplace( Ts&&... ts )
+      {
+         return insert( value_type( std::forward< Ts >( ts )... ) );
+      }
+
+      template< typename T, typename... Ts >
+      std::pair< iterator, bool > try_emplace( T&& k, Ts&&... ts )
+      {
+         return inserted( m_data.try_emplace( std::forward< T >( k ), std::forward< Ts >( ts )... ) );
+      }
+
+      size_type erase( const std::string_view k )
+      {
+         const auto it = find( k );
+         if( it == m_data.end() ) {
+            return 0;
+         }
+         erase( it );
+         return 1;
+      }
+
+      iterator erase( const const_iterator it )
+      {
+         const std::size_t p = it - m_data.cbegin();
+         if( !m_index.empty() ) {
+            if( m_data.size() <= small_size + 1 ) {
+               m_index.clear();
+            }
+            else {
+               unindex( p );
+            }
+         }
+         return m_data.erase( it );
+      }
+
+      // See flat_object::unsafe_assign_unsorted().
+      template< typename I >
+      [[nodiscard]] iterator unsafe_assign_unsorted( const I b, const I e )
+      {
+         const auto it = m_data.unsafe_assign_unsorted( b, e );
+         reindex();
+         return it;
+      }
+
+      [[nodiscard]] friend bool operator==( const hash_object& l, const hash_object& r )
+      {
+         return l.m_data == r.m_data;
+      }
+
+      [[nodiscard]] friend bool operator!=( const hash_object& l, const hash_object& r )
+      {
+         return !( l == r );
+      }
+
+      [[nodiscard]] friend bool operator<( const hash_object& l, const hash_object& r )
+      {
+         return l.m_data < r.m_data;
+      }
+
+      [[nodiscard]] friend bool operator>( const hash_object& l, const hash_object& r )
+      {
+         return r < l;
+      }
+
+      [[nodiscard]] friend bool operator<=( const hash_object& l, const hash_object& r )
+      {
+         return !( r < l );
+      }
+
+      [[nodiscard]] friend bool operator>=( const hash_object& l, const hash_object& r )
+      {
+         return !( l < r );
+      }
+
+   private:
+      // The position in m_data plus one, zero for an empty slot, and the
+      // hash of the key, whose lower bits are the preferred slot.
+      struct slot
+      {
+         std::uint32_t position;
+         std::uint32_t hash;
+      };
+
+      [[nodiscard]] static std::uint32_t hash( const std::string_view k ) noexcept
+      {
+         const std::uint64_t h = std::hash< std::string_view >()( k );
+         return static_cast< std::uint32_t >( h ^ ( h >> 32 ) );
+      }
+
+      [[nodiscard]] std::size_t mask() const noexcept
+      {
+         return m_index.size() - 1;
+      }
+
+      void place( const std::size_t p )
+      {
+         const std::uint32_t h = hash( m_data.begin()[ p ].first );
+         std::size_t i = h & mask();
+         while( m_index[ i ].position != 0 ) {
+            i = ( i + 1 ) & mask();
+         }
+         m_index[ i ] = { static_cast< std::uint32_t >( p + 1 ), h };
+      }
+
+      // Rebuilds the table with a load factor of at most one half.
+      void reindex()
+      {
+         m_index.clear();
+         if( m_data.size() > small_size ) {
+            std::size_t n = 2 * small_size;
+            while( n < 2 * m_data.size() ) {
+               n *= 2;
+            }
+            m_index.resize( n, slot{ 0, 0 } );
+            for( std::size_t p = 0; p < m_data.size(); ++p ) {
+               place( p );
+            }
+         }
+      }
+
+      std::pair< iterator, bool > inserted( const std::pair< iterator, bool > r )
+      {
+         if( r.second ) {
+            const std::size_t p = r.first - m_data.begin();
+            if( ( m_data.size() <= small_size ) || ( 2 * m_data.size() > m_index.size() ) ) {
+               reindex();
+            }
+            else {
+               if( p + 1 != m_data.size() ) {
+                  for( auto& s : m_index ) {
+                     s.position += ( s.position > p );
+                  }
+               }
+               place( p );
+            }
+         }
+         return r;
+      }
+
+      // Removes the slot for position p and closes the gap in the cluster
+      // by moving slots backwards, Knuth's algorithm R.
+      void unindex( const std::size_t p ) noexcept
+      {
+         const std::uint32_t h = hash( m_data.begin()[ p ].first );
+         std::size_t i = h & mask();
+         while( m_index[ i ].position != p + 1 ) {
+            i = ( i + 1 ) & mask();
+         }
+         for( std::size_t j = ( i + 1 ) & mask(); m_index[ j ].position != 0; j = ( j + 1 ) & mask() ) {
+            // Moves the slot into the gap unless its preferred slot is in ( i, j ].
+            const slot s = m_index[ j ];
+            if( ( ( j - s.hash ) & mask() ) >= ( ( j - i ) & mask() ) ) {
+               m_index[ i ] = s;
+               i = j;
+            }
+         }
+         m_index[ i ] = slot{ 0, 0 };
+         for( auto& s : m_index ) {
+            s.position -= ( s.position > p + 1 );
+         }
+      }
+
+      container_type m_data;
+      std::vector< slot > m_index;
+   };
+
+   template< typename T >
+   struct hash_traits
+      : public traits< T >
+   {};
+
+   template<>
+   struct hash_traits< void >
+      : public traits< void >
+   {
+      template< typename V >
+      using object_t = hash_object< V >;
+   };
+
+   template< template< typename... > class Traits, typename K >
+   struct traits< hash_object< basic_value< Traits >, K > >
+   {
+      static void assign( basic_value< Traits >& v, const hash_object< basic_value< Traits >, K >& o )
+      {
+         v.unsafe_assign_object( o );
+      }
+
+      static void assign( basic_value< Traits >& v, hash_object< basic_value< Traits >, K >&& o ) noexcept
+      {
+         v.unsafe_assign_object( std::move( o ) );
+      }
+
+      template< template< typename... > class, typename Consumer >
+      static void produce( Consumer& c, const hash_object< basic_value< Traits >, K >& o )
+      {
+         c.begin_object( o.size() );
+         for( const auto& i : o ) {
+            c.key( i.first );
+            Traits< basic_value< Traits > >::produce( c, i.second );
+            c.member();
+         }
+         c.end_object( o.size() );
+      }
+   };
+
+   using hash_value = basic_value< hash_traits >;
+
+   template< template< typename... > class... Transformers >
+   [[nodiscard]] hash_value hash_from_string( const std::string_view data, const std::string& source = std::string() )
+   {
+      json::events::transformer< json::events::to_basic_value< hash_traits >, Transformers... > consumer;
+      json::events::from_string( consumer, data, source );
+      return std::move( consumer.value );
+   }
+
+}  // namespace tao::json
+
+#endif
@@ -0,0 +1,222 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_CONTRIB_INTERNED_KEY_HPP
+#define TAO_JSON_CONTRIB_INTERNED_KEY_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+#include "../basic_value.hpp"
+#include "../events/from_string.hpp"
+#include "../events/to_value.hpp"
+#include "../events/transformer.hpp"
+#include "../traits.hpp"
+
+#include "flat_object.hpp"
+
+namespace tao::json
+{
+   // A thread-safe pool of strings that hands out a stable pointer for
+   // every distinct string. The strings are never released, the pool is
+   // intended for the limited set of object keys used by an application.
+
+   class key_pool
+   {
+   public:
+      key_pool() = default;
+
+      key_pool( const key_pool& ) = delete;
+      key_pool( key_pool&& ) = delete;
+
+      ~key_pool() = default;
+
+      void operator=( const key_pool& ) = delete;
+      void operator=( key_pool&& ) = delete;
+
+      [[nodiscard]] const std::string_view* intern( const std::string_view k )
+      {
+         {
+            const std::shared_lock lock( m_mutex );
+            const auto it = m_keys.find( k );
+            if( it != m_keys.end() ) {
+               return &*it;
+            }
+         }
+         const std::unique_lock lock( m_mutex );
+         const auto it = m_keys.find( k );
+         if( it != m_keys.end() ) {
+            return &*it;
+         }
+         auto* p = static_cast< char* >( m_chars.allocate( k.size() + 1, 1 ) );
+         std::memcpy( p, k.data(), k.size() );
+         return &*m_keys.emplace( p, k.size() ).first;
+      }
+
+      [[nodiscard]] std::size_t size() const
+      {
+         const std::shared_lock lock( m_mutex );
+         return m_keys.size();
+      }
+
+      [[nodiscard]] static key_pool& global()
+      {
+         static key_pool pool;
+         return pool;
+      }
+
+   private:
+      mutable std::shared_mutex m_mutex;
+      std::pmr::monotonic_buffer_resource m_chars;
+      std::unordered_set< std::string_view > m_keys;
+   };
+
+   // An object key interned in key_pool::global(); the size of a pointer,
+   // equality is a pointer comparison, and the ordering is the same as for
+   // the strings themselves.
+
+   class interned_key
+   {
+   public:
+      explicit interned_key( const std::string_view k )
+         : m_key( key_pool::global().intern( k ) )
+      {}
+
+      [[nodiscard]] std::string_view view() const noexcept
+      {
+         return *m_key;
+      }
+
+      operator std::string_view() const noexcept
+      {
+         return *m_key;
+      }
+
+      [[nodiscard]] const char* data() const noexcept
+      {
+         return m_key->data();
+      }
+
+      [[nodiscard]] std::size_t size() const noexcept
+      {
+         return m_key->size();
+      }
+
+      [[nodiscard]] bool empty() const noexcept
+      {
+         return m_key->empty();
+      }
+
+      [[nodiscard]] friend bool operator==( const interned_key l, const interned_key r ) noexcept
+      {
+         return l.m_key == r.m_key;
+      }
+
+      [[nodiscard]] friend bool operator!=( const interned_key l, const interned_key r ) noexcept
+      {
+         return l.m_key != r.m_key;
+      }
+
+      [[nodiscard]] friend bool operator<( const interned_key l, const interned_key r ) noexcept
+      {
+         return ( l.m_key != r.m_key ) && ( *l.m_key < *r.m_key );
+      }
+
+      [[nodiscard]] friend bool operator>( const interned_key l, const interned_key r ) noexcept
+      {
+         return r < l;
+      }
+
+      [[nodiscard]] friend bool operator<=( const interned_key l, const interned_key r ) noexcept
+      {
+         return !( r < l );
+      }
+
+      [[nodiscard]] friend bool operator>=( const interned_key l, const interned_key r ) noexcept
+      {
+         return !( l < r );
+      }
+
+      [[nodiscard]] friend bool operator==( const interned_key l, const std::string_view r ) noexcept
+      {
+         return *l.m_key == r;
+      }
+
+      [[nodiscard]] friend bool operator==( const std::string_view l, const interned_key r ) noexcept
+      {
+         return l == *r.m_key;
+      }
+
+      [[nodiscard]] friend bool operator!=( const interned_key l, const std::string_view r ) noexcept
+      {
+         return *l.m_key != r;
+      }
+
+      [[nodiscard]] friend bool operator!=( const std::string_view l, const interned_key r ) noexcept
+      {
+         return l != *r.m_key;
+      }
+
+      [[nodiscard]] friend bool operator<( const interned_key l, const std::string_view r ) noexcept
+      {
+         return *l.m_key < r;
+      }
+
+      [[nodiscard]] friend bool operator<( const std::string_view l, const interned_key r ) noexcept
+      {
+         return l < *r.m_key;
+      }
+
+   private:
+      const std::string_view* m_key;
+   };
+
+   inline std::ostream& operator<<( std::ostream& o, const interned_key k )
+   {
+      return o << k.view();
+   }
+
+   template< typename T >
+   struct interned_traits
+      : public traits< T >
+   {};
+
+   template<>
+   struct interned_traits< void >
+      : public traits< void >
+   {
+      template< typename V >
+      using object_t = flat_object< V, interned_key >;
+   };
+
+   using interned_value = basic_value< interned_traits >;
+
+   template< template< typename... > class... Transformers >
+   [[nodiscard]] interned_value interned_from_string( const std::string_view data, const std::string& source = std::string() )
+   {
+      json::events::transformer< json::events::to_basic_value< interned_traits >, Transformers... > consumer;
+      json::events::from_string( consumer, data, source );
+      return std::move( consumer.value );
+   }
+
+}  // namespace tao::json
+
+template<>
+struct std::hash< tao::json::interned_key >
+{
+   [[nodiscard]] std::size_t operator()( const tao::json::interned_key k ) const noexcept
+   {
+      return std::hash< const char* >()( k.data() );
+   }
+};
+
+#endif
@@ -0,0 +1,486 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_CONTRIB_LAZY_VALUE_HPP
+#define TAO_JSON_CONTRIB_LAZY_VALUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../external/pegtl/memory_input.hpp"
+#include "../external/pegtl/parse.hpp"
+
+#include "../events/discard.hpp"
+#include "../events/to_stream.hpp"
+#include "../events/to_value.hpp"
+#include "../internal/action.hpp"
+#include "../internal/errors.hpp"
+#include "../internal/escape.hpp"
+#include "../internal/format.hpp"
+#include "../internal/grammar.hpp"
+#include "../internal/unescape_action.hpp"
+#include "../pointer.hpp"
+#include "../type.hpp"
+#include "../value.hpp"
+
+namespace tao::json
+{
+   // A lazy_document validates a JSON text once with the grammar and the
+   // events::discard consumer, and then gives access to it through lazy_value cursors.
+   // Accessing an array element or object member scans forward over the
+   // preceding elements or members with a structural skipper that only
+   // looks for quotes, escapes and brackets; scalars are only decoded when
+   // they are read. The positions of the elements and members that were
+   // scanned are cached in the document, later accesses to the same array
+   // or object continue where the last scan stopped.
+
+   // The document does not own the text, which must outlive the document
+   // and all lazy_value instances. The cache makes const accesses mutate
+   // the document, it must not be accessed concurrently from multiple
+   // threads. When an object has duplicate keys, the first member wins.
+
+   class lazy_document;
+
+   namespace internal
+   {
+      [[nodiscard]] inline std::size_t lazy_skip_ws( const std::string_view d, std::size_t i ) noexcept
+      {
+         while( ( i < d.size() ) && ( ( d[ i ] == ' ' ) || ( d[ i ] == '\t' ) || ( d[ i ] == '\n' ) || ( d[ i ] == '\r' ) ) ) {
+            ++i;
+         }
+         return i;
+      }
+
+      // Returns the position after the closing quote of the string that starts at i.
+      [[nodiscard]] inline std::size_t lazy_skip_string( const std::string_view d, std::size_t i ) noexcept
+      {
+         ++i;
+         while( d[ i ] != '"' ) {
+            i += ( d[ i ] == '\\' ) ? 2 : 1;
+         }
+         return i + 1;
+      }
+
+      // Returns the position after the value that starts at i.
+      [[nodiscard]] inline std::size_t lazy_skip_value( const std::string_view d, std::size_t i ) noexcept
+      {
+         switch( d[ i ] ) {
+            case '"':
+               return lazy_skip_string( d, i );
+            case '[':
+            case '{': {
+               std::size_t depth = 0;
+               do {
+                  switch( d[ i ] ) {
+                     case '"':
+                        i = lazy_skip_string( d, i );
+                        continue;
+                     case '[':
+                     case '{':
+                        ++depth;
+                        break;
+                     case ']':
+                     case '}':
+                        --depth;
+                        break;
+                  }
+                  ++i;
+               } while( depth != 0 );
+               return i;
+            }
+            default:
+               while( ( i < d.size() ) && ( d[ i ] != ',' ) && ( d[ i ] != ']' ) && ( d[ i ] != '}' ) && ( d[ i ] != ' ' ) && ( d[ i ] != '\t' ) && ( d[ i ] != '\n' ) && ( d[ i ] != '\r' ) ) {
+                  ++i;
+               }
+               return i;
+         }
+      }
+
+      // Unescapes the contents of a string, raw must include the closing quote.
+      [[nodiscard]] inline std::string lazy_unescape( const std::string_view raw )
+      {
+         std::string result;
+         pegtl::memory_input< pegtl::tracking_mode::lazy, pegtl::eol::lf_crlf, const char* > in( raw.data(), raw.data() + raw.size(), "lazy_value" );
+         pegtl::parse< rules::string_content, unescape_action >( in, result );
+         return result;
+      }
+
+      struct lazy_entry
+      {
+         std::size_t key;  // Position of the opening quote of the key, unused for arrays.
+         std::size_t value;
+      };
+
+      struct lazy_index
+      {
+         std::vector< lazy_entry > entries;
+         std::size_t resume;
+         bool complete = false;
+      };
+
+   }  // namespace internal
+
+   class lazy_value
+   {
+   public:
+      lazy_value( const lazy_document& d, const std::size_t offset ) noexcept
+         : m_document( &d ),
+           m_offset( offset )
+      {}
+
+      [[nodiscard]] const lazy_document& document() const noexcept
+      {
+         return *m_document;
+      }
+
+      [[nodiscard]] std::size_t offset() const noexcept
+      {
+         return m_offset;
+      }
+
+      // The text of the value, without surrounding whitespace.
+      [[nodiscard]] std::string_view raw() const noexcept;
+
+      [[nodiscard]] json::type type() const;
+
+      [[nodiscard]] bool is_null() const noexcept
+      {
+         return first() == 'n';
+      }
+
+      [[nodiscard]] bool is_boolean() const noexcept
+      {
+         return ( first() == 't' ) || ( first() == 'f' );
+      }
+
+      [[nodiscard]] bool is_number() const noexcept
+      {
+         return ( first() == '-' ) || ( ( '0' <= first() ) && ( first() <= '9' ) );
+      }
+
+      [[nodiscard]] bool is_string() const noexcept
+      {
+         return first() == '"';
+      }
+
+      [[nodiscard]] bool is_array() const noexcept
+      {
+         return first() == '[';
+      }
+
+      [[nodiscard]] bool is_object() const noexcept
+      {
+         return first() == '{';
+      }
+
+      [[nodiscard]] bool get_boolean() const
+      {
+         if( !is_boolean() ) {
+            throw std::logic_error( internal::format( "invalid json type '", type(), "', expected 'boolean'" ) );  // NOLINT
+         }
+         return first() == 't';
+      }
+
+      [[nodiscard]] std::int64_t get_signed() const
+      {
+         return to_value().get_signed();
+      }
+
+      [[nodiscard]] std::uint64_t get_unsigned() const
+      {
+         return to_value().get_unsigned();
+      }
+
+      [[nodiscard]] double get_double() const
+      {
+         return to_value().get_double();
+      }
+
+      // Returns the unescaped string; unlike the other accessors this
+      // allocates, use raw() to compare against strings without escapes.
+      [[nodiscard]] std::string get_string() const
+      {
+         if( !is_string() ) {
+            throw std::logic_error( internal::format( "invalid json type '", type(), "', expected 'string'" ) );  // NOLINT
+         }
+         const auto r = raw();
+         return internal::lazy_unescape( r.substr( 1 ) );
+      }
+
+      template< typename T >
+      [[nodiscard]] T as() const
+      {
+         return to_value().template as< T >();
+      }
+
+      // Parses the complete value, including all nested values.
+      [[nodiscard]] json::value to_value() const
+      {
+         events::to_value consumer;
+         produce( consumer );
+         return std::move( consumer.value );
+      }
+
+      template< typename Consumer >
+      void produce( Consumer& consumer ) const
+      {
+         const auto r = raw();
+         pegtl::memory_input< pegtl::tracking_mode::lazy, pegtl::eol::lf_crlf, const char* > in( r.data(), r.data() + r.size(), "lazy_value" );
+         pegtl::parse< internal::embedded, internal::action, internal::errors >( in, consumer );
+      }
+
+      [[nodiscard]] std::size_t size() const;
+
+      [[nodiscard]] std::optional< lazy_value > find( const std::size_t index ) const;
+      [[nodiscard]] std::optional< lazy_value > find( const std::string_view key ) const;
+
+      [[nodiscard]] std::optional< lazy_value > find( const pointer& k ) const
+      {
+         std::optional< lazy_value > v = *this;
+         for( const auto& t : k ) {
+            v = v->is_array() ? v->find( t.index() ) : v->find( std::string_view( t.key() ) );
+            if( !v ) {
+               break;
+            }
+         }
+         return v;
+      }
+
+      [[nodiscard]] lazy_value at( const std::size_t index ) const
+      {
+         if( const auto v = find( index ) ) {
+            return *v;
+         }
+         throw std::out_of_range( internal::format( "JSON array index '", index, "' out of bound '", size(), '\'' ) );  // NOLINT
+      }
+
+      [[nodiscard]] lazy_value at( const std::string_view key ) const
+      {
+         if( const auto v = find( key ) ) {
+            return *v;
+         }
+         throw std::out_of_range( internal::format( "JSON object key \"", internal::escape( key ), "\" not found" ) );  // NOLINT
+      }
+
+      [[nodiscard]] lazy_value at( const pointer& k ) const
+      {
+         if( const auto v = find( k ) ) {
+            return *v;
+         }
+         throw std::out_of_range( internal::format( "JSON pointer \"", to_string( k ), "\" not found" ) );  // NOLINT
+      }
+
+      [[nodiscard]] lazy_value operator[]( const std::size_t index ) const
+      {
+         return at( index );
+      }
+
+      [[nodiscard]] lazy_value operator[]( const std::string_view key ) const
+      {
+         return at( key );
+      }
+
+      [[nodiscard]] lazy_value operator[]( const pointer& k ) const
+      {
+         return at( k );
+      }
+
+      void validate_json_type( const json::type t ) const
+      {
+         if( ( t == json::type::ARRAY ) ? !is_array() : !is_object() ) {
+            throw std::logic_error( internal::format( "invalid json type '", type(), "', expected '", t, '\'' ) );  // NOLINT
+         }
+      }
+
+   private:
+      [[nodiscard]] char first() const noexcept;
+
+      const lazy_document* m_document;
+      std::size_t m_offset;
+   };
+
+   class lazy_document
+   {
+   public:
+      explicit lazy_document( const std::string_view data, const std::string& source = "tao::json::lazy_document" )
+         : m_data( data )
+      {
+         pegtl::memory_input< pegtl::tracking_mode::lazy, pegtl::eol::lf_crlf, const char* > in( data.data(), data.data() + data.size(), source.c_str() );
+         events::discard consumer;
+         pegtl::parse< internal::grammar, internal::action, internal::errors >( in, consumer );
+         m_root = internal::lazy_skip_ws( m_data, 0 );
+      }
+
+      // Skips the validation for text that is known to be valid JSON, e.g.
+      // because it was produced by the library; the behaviour is undefined
+      // for invalid JSON.
+      struct trusted_t
+      {
+         explicit trusted_t() = default;
+      };
+
+      static constexpr trusted_t trusted{};
+
+      lazy_document( const std::string_view data, trusted_t /*unused*/ ) noexcept
+         : m_data( data ),
+           m_root( internal::lazy_skip_ws( m_data, 0 ) )
+      {}
+
+      lazy_document( const lazy_document& ) = delete;
+      lazy_document( lazy_document&& ) = delete;
+
+      ~lazy_document() = default;
+
+      void operator=( const lazy_document& ) = delete;
+      void operator=( lazy_document&& ) = delete;
+
+      [[nodiscard]] std::string_view data() const noexcept
+      {
+         return m_data;
+      }
+
+      [[nodiscard]] lazy_value root() const noexcept
+      {
+         return lazy_value( *this, m_root );
+      }
+
+      // The number of arrays and objects with cached positions.
+      [[nodiscard]] std::size_t cached() const noexcept
+      {
+         return m_cache.size();
+      }
+
+      void clear_cache() noexcept
+      {
+         m_cache.clear();
+      }
+
+      // Returns the cached positions of the array or object at offset,
+      // after scanning forward until either the predicate returns true,
+      // or the end of the array or object is reached.
+      template< typename F >
+      const internal::lazy_index& scan( const std::size_t offset, const F& f ) const
+      {
+         auto [ it, inserted ] = m_cache.try_emplace( offset );
+         auto& x = it->second;
+         if( inserted ) {
+            x.resume = offset + 1;
+         }
+         const bool object = m_data[ offset ] == '{';
+         while( !x.complete && !f( x ) ) {
+            auto i = internal::lazy_skip_ws( m_data, x.resume );
+            if( ( m_data[ i ] == ']' ) || ( m_data[ i ] == '}' ) ) {
+               x.complete = true;
+               break;
+            }
+            if( m_data[ i ] == ',' ) {
+               i = internal::lazy_skip_ws( m_data, i + 1 );
+            }
+            internal::lazy_entry e{ i, i };
+            if( object ) {
+               i = internal::lazy_skip_ws( m_data, internal::lazy_skip_string( m_data, i ) );  // Key.
+               e.value = internal::lazy_skip_ws( m_data, i + 1 );  // Name separator.
+            }
+            x.resume = internal::lazy_skip_value( m_data, e.value );
+            x.entries.emplace_back( e );
+         }
+         return x;
+      }
+
+   private:
+      std::string_view m_data;
+      std::size_t m_root;
+      mutable std::unordered_map< std::size_t, internal::lazy_index > m_cache;
+   };
+
+   inline char lazy_value::first() const noexcept
+   {
+      return m_document->data()[ m_offset ];
+   }
+
+   inline std::string_view lazy_value::raw() const noexcept
+   {
+      const auto d = m_document->data();
+      return d.substr( m_offset, internal::lazy_skip_value( d, m_offset ) - m_offset );
+   }
+
+   inline json::type lazy_value::type() const
+   {
+      switch( first() ) {
+         case 'n':
+            return json::type::NULL_;
+         case 't':
+         case 'f':
+            return json::type::BOOLEAN;
+         case '"':
+            return json::type::STRING;
+         case '[':
+            return json::type::ARRAY;
+         case '{':
+            return json::type::OBJECT;
+         default:
+            return to_value().type();
+      }
+   }
+
+   inline std::size_t lazy_value::size() const
+   {
+      if( !is_array() && !is_object() ) {
+         throw std::logic_error( internal::format( "invalid json type '", type(), "', expected 'array' or 'object'" ) );  // NOLINT
+      }
+      return m_document->scan( m_offset, []( const internal::lazy_index& /*unused*/ ) { return false; } ).entries.size();
+   }
+
+   inline std::optional< lazy_value > lazy_value::find( const std::size_t index ) const
+   {
+      validate_json_type( json::type::ARRAY );
+      const auto& x = m_document->scan( m_offset, [ = ]( const internal::lazy_index& y ) { return y.entries.size() > index; } );
+      if( index < x.entries.size() ) {
+         return lazy_value( *m_document, x.entries[ index ].value );
+      }
+      return std::nullopt;
+   }
+
+   inline std::optional< lazy_value > lazy_value::find( const std::string_view key ) const
+   {
+      validate_json_type( json::type::OBJECT );
+      const auto d = m_document->data();
+      const auto match = [ & ]( const internal::lazy_entry& e ) {
+         const auto r = d.substr( e.key + 1, internal::lazy_skip_string( d, e.key ) - e.key - 1 );
+         if( r.find( '\\' ) == std::string_view::npos ) {
+            return r.substr( 0, r.size() - 1 ) == key;
+         }
+         return internal::lazy_unescape( r ) == key;
+      };
+      // Check the members that were already scanned before continuing the scan.
+      const auto& x = m_document->scan( m_offset, []( const internal::lazy_index& /*unused*/ ) { return true; } );
+      for( const auto& e : x.entries ) {
+         if( match( e ) ) {
+            return lazy_value( *m_document, e.value );
+         }
+      }
+      const auto n = x.entries.size();
+      m_document->scan( m_offset, [ & ]( const internal::lazy_index& y ) { return ( y.entries.size() > n ) && match( y.entries.back() ); } );
+      if( ( x.entries.size() > n ) && match( x.entries.back() ) ) {
+         return lazy_value( *m_document, x.entries.back().value );
+      }
+      return std::nullopt;
+   }
+
+   inline std::ostream& operator<<( std::ostream& o, const lazy_value& v )
+   {
+      events::to_stream consumer( o );
+      v.produce( consumer );
+      return o;
+   }
+
+}  // namespace tao::json
+
+#endif
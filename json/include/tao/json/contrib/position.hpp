@@ -150,6 +150,8 @@ namespace tao::json
    [[nodiscard]] auto basic_parse_file_with_position( const std::string& filename )
    {
       events::transformer< events::to_basic_value< Traits >, Transformers... > consumer;
+      // Eager tracking since the position of every value is needed, with lazy
+      // tracking each position would be counted from the start of the input.
       pegtl::file_input< pegtl::tracking_mode::eager > in( filename );
       pegtl::parse< internal::grammar, internal::position_action, internal::errors >( in, consumer );
       return std::move( consumer.value );
@@ -20,6 +20,7 @@
 #include "../events/compare.hpp"
 #include "../events/from_value.hpp"
 #include "../events/hash.hpp"
+#include "../internal/first_sor.hpp"
 #include "../pointer.hpp"
 #include "../value.hpp"
 
@@ -32,7 +33,7 @@ namespace tao::json
    {
       // TODO: Check if these grammars are correct.
       struct local_part_label
-         : pegtl::plus< pegtl::sor< pegtl::alnum, pegtl::one< '!', '#', '$', '%', '&', '\'', '*', '+', '-', '/', '=', '?', '^', '_', '`', '{', '|', '}', '~' > > >
+         : pegtl::plus< first_sor< pegtl::alnum, pegtl::one< '!', '#', '$', '%', '&', '\'', '*', '+', '-', '/', '=', '?', '^', '_', '`', '{', '|', '}', '~' > > >
       {};
 
       struct local_part
@@ -54,7 +55,7 @@ namespace tao::json
       template< typename Rule >
       [[nodiscard]] bool parse( const std::string_view v )  // NOLINT
       {
-         pegtl::memory_input in( v.data(), v.size(), "" );
+         pegtl::memory_input< pegtl::tracking_mode::lazy > in( v.data(), v.size(), "" );
          return pegtl::parse< pegtl::seq< Rule, pegtl::eof > >( in );
       }
 
@@ -0,0 +1,391 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_CONTRIB_SHARED_VALUE_HPP
+#define TAO_JSON_CONTRIB_SHARED_VALUE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../basic_value.hpp"
+#include "../events/from_string.hpp"
+#include "../events/to_value.hpp"
+#include "../events/transformer.hpp"
+#include "../traits.hpp"
+
+namespace tao::json
+{
+   namespace internal
+   {
+      template< typename C, typename = void >
+      struct shared_container_keys
+      {};
+
+      template< typename C >
+      struct shared_container_keys< C, std::void_t< typename C::key_type > >
+      {
+         using key_type = typename C::key_type;
+         using mapped_type = typename C::mapped_type;
+      };
+
+   }  // namespace internal
+
+   // Array or object storage for basic_value that shares the container C
+   // between copies through a std::shared_ptr and copies it on the first
+   // access through a non-const member function while it is shared, i.e.
+   // copy-on-write. Copying a Value is therefore O(1), and changing a
+   // sub-value of a copy only copies the containers on the path to it,
+   // their elements are again shared.
+
+   // Every non-const member function copies a shared container, also those
+   // that are used only for reading like begin(), end(), front(), back(),
+   // operator[], at() and find(), since the references and iterators they
+   // return can be used for writing. Read through a const reference, e.g.
+   // std::as_const( v ).at( k ), or with get() to keep the container shared.
+
+   // The reference count is atomic, copies can be used concurrently from
+   // different threads. The usual copy-on-write caveat applies: references
+   // and iterators obtained with non-const access must not be used to
+   // modify the container after the Value was copied.
+
+   template< typename C >
+   class shared_container
+      : public internal::shared_container_keys< C >
+   {
+   public:
+      using container_type = C;
+      using value_type = typename C::value_type;
+      using size_type = typename C::size_type;
+      using difference_type = typename C::difference_type;
+      using reference = typename C::reference;
+      using const_reference = typename C::const_reference;
+      using iterator = typename C::iterator;
+      using const_iterator = typename C::const_iterator;
+
+      shared_container() noexcept = default;
+
+      shared_container( const C& c )  // NOLINT
+         : m_data( std::make_shared< storage >( c ) )
+      {}
+
+      shared_container( C&& c )  // NOLINT
+         : m_data( std::make_shared< storage >( std::move( c ) ) )
+      {}
+
+      shared_container( std::initializer_list< value_type > l )
+         : m_data( std::make_shared< storage >( C( l ) ) )
+      {}
+
+      // The container for read access, never copies.
+      [[nodiscard]] const C& get() const noexcept
+      {
+         return m_data ? m_data->container : empty_container();
+      }
+
+      // The container for write access, copies it first when it is shared.
+      [[nodiscard]] C& mutate()
+      {
+         if( !m_data ) {
+            m_data = std::make_shared< storage >( C() );
+         }
+         else if( m_data.use_count() > 1 ) {
+            m_data = std::make_shared< storage >( m_data->container );
+         }
+         return m_data->container;
+      }
+
+      [[nodiscard]] bool is_shared() const noexcept
+      {
+         return m_data.use_count() > 1;
+      }
+
+      [[nodiscard]] bool empty() const noexcept
+      {
+         return get().empty();
+      }
+
+      [[nodiscard]] size_type size() const noexcept
+      {
+         return get().size();
+      }
+
+      [[nodiscard]] const_iterator begin() const noexcept
+      {
+         return get().begin();
+      }
+
+      [[nodiscard]] const_iterator end() const noexcept
+      {
+         return get().end();
+      }
+
+      [[nodiscard]] const_iterator cbegin() const noexcept
+      {
+         return get().begin();
+      }
+
+      [[nodiscard]] const_iterator cend() const noexcept
+      {
+         return get().end();
+      }
+
+      [[nodiscard]] iterator begin()
+      {
+         return mutate().begin();
+      }
+
+      [[nodiscard]] iterator end()
+      {
+         return mutate().end();
+      }
+
+      [[nodiscard]] const_reference front() const
+      {
+         return get().front();
+      }
+
+      [[nodiscard]] const_reference back() const
+      {
+         return get().back();
+      }
+
+      [[nodiscard]] reference front()
+      {
+         return mutate().front();
+      }
+
+      [[nodiscard]] reference back()
+      {
+         return mutate().back();
+      }
+
+      template< typename K >
+      [[nodiscard]] decltype( auto ) operator[]( K&& k ) const
+      {
+         return get()[ std::forward< K >( k ) ];
+      }
+
+      template< typename K >
+      [[nodiscard]] decltype( auto ) operator[]( K&& k )
+      {
+         return mutate()[ std::forward< K >( k ) ];
+      }
+
+      template< typename K >
+      [[nodiscard]] decltype( auto ) at( const K& k ) const
+      {
+         return get().at( k );
+      }
+
+      template< typename K >
+      [[nodiscard]] decltype( auto ) at( const K& k )
+      {
+         return mutate().at( k );
+      }
+
+      template< typename K >
+      [[nodiscard]] const_iterator find( const K& k ) const
+      {
+         return get().find( k );
+      }
+
+      template< typename K >
+      [[nodiscard]] iterator find( const K& k )
+      {
+         return mutate().find( k );
+      }
+
+      template< typename K >
+      [[nodiscard]] size_type count( const K& k ) const
+      {
+         return get().count( k );
+      }
+
+      void reserve( const size_type n )
+      {
+         mutate().reserve( n );
+      }
+
+      void clear() noexcept
+      {
+         m_data.reset();
+      }
+
+      template< typename... Ts >
+      decltype( auto ) push_back( Ts&&... ts )
+      {
+         return mutate().push_back( std::forward< Ts >( ts )... );
+      }
+
+      template< typename... Ts >
+      decltype( auto ) emplace_back( Ts&&... ts )
+      {
+         return mutate().emplace_back( std::forward< Ts >( ts )... );
+      }
+
+      void pop_back()
+      {
+         mutate().pop_back();
+      }
+
+      template< typename... Ts >
+      void resize( Ts&&... ts )
+      {
+         mutate().resize( std::forward< Ts >( ts )... );
+      }
+
+      template< typename... Ts >
+      decltype( auto ) emplace( Ts&&... ts )
+      {
+         return mutate().emplace( std::forward< Ts >( ts )... );
+      }
+
+      template< typename... Ts >
+      decltype( auto ) try_emplace( Ts&&... ts )
+      {
+         return mutate().try_emplace( std::forward< Ts >( ts )... );
+      }
+
+      template< typename... Ts >
+      decltype( auto ) insert( Ts&&... ts )
+      {
+         return mutate().insert( std::forward< Ts >( ts )... );
+      }
+
+      template< typename... Ts >
+      decltype( auto ) erase( Ts&&... ts )
+      {
+         return mutate().erase( std::forward< Ts >( ts )... );
+      }
+
+      [[nodiscard]] friend bool operator==( const shared_container& l, const shared_container& r )
+      {
+         return ( l.m_data == r.m_data ) || ( l.get() == r.get() );
+      }
+
+      [[nodiscard]] friend bool operator!=( const shared_container& l, const shared_container& r )
+      {
+         return !( l == r );
+      }
+
+      [[nodiscard]] friend bool operator<( const shared_container& l, const shared_container& r )
+      {
+         return ( l.m_data != r.m_data ) && ( l.get() < r.get() );
+      }
+
+      [[nodiscard]] friend bool operator>( const shared_container& l, const shared_container& r )
+      {
+         return r < l;
+      }
+
+      [[nodiscard]] friend bool operator<=( const shared_container& l, const shared_container& r )
+      {
+         return !( r < l );
+      }
+
+      [[nodiscard]] friend bool operator>=( const shared_container& l, const shared_container& r )
+      {
+         return !( l < r );
+      }
+
+   private:
+      struct storage
+      {
+         explicit storage( const C& c )
+            : container( c )
+         {}
+
+         explicit storage( C&& c )
+            : container( std::move( c ) )
+         {}
+
+         C container;
+      };
+
+      [[nodiscard]] static const C& empty_container() noexcept
+      {
+         static const C c;
+         return c;
+      }
+
+      std::shared_ptr< storage > m_data;
+   };
+
+   template< typename T >
+   struct shared_traits
+      : public traits< T >
+   {};
+
+   template<>
+   struct shared_traits< void >
+      : public traits< void >
+   {
+      template< typename V >
+      using array_t = shared_container< std::vector< V > >;
+
+      template< typename V >
+      using object_t = shared_container< std::map< std::string, V, std::less<> > >;
+   };
+
+   template< template< typename... > class Traits >
+   struct traits< shared_container< std::vector< basic_value< Traits > > > >
+   {
+      static void assign( basic_value< Traits >& v, const shared_container< std::vector< basic_value< Traits > > >& a )
+      {
+         v.unsafe_assign_array( a );
+      }
+
+      template< template< typename... > class, typename Consumer >
+      static void produce( Consumer& c, const shared_container< std::vector< basic_value< Traits > > >& a )
+      {
+         c.begin_array( a.size() );
+         for( const auto& i : a ) {
+            Traits< basic_value< Traits > >::produce( c, i );
+            c.element();
+         }
+         c.end_array( a.size() );
+      }
+   };
+
+   template< template< typename... > class Traits >
+   struct traits< shared_container< std::map< std::string, basic_value< Traits >, std::less<> > > >
+   {
+      static void assign( basic_value< Traits >& v, const shared_container< std::map< std::string, basic_value< Traits >, std::less<> > >& o )
+      {
+         v.unsafe_assign_object( o );
+      }
+
+      template< template< typename... > class, typename Consumer >
+      static void produce( Consumer& c, const shared_container< std::map< std::string, basic_value< Traits >, std::less<> > >& o )
+      {
+         c.begin_object( o.size() );
+         for( const auto& i : o ) {
+            c.key( i.first );
+            Traits< basic_value< Traits > >::produce( c, i.second );
+            c.member();
+         }
+         c.end_object( o.size() );
+      }
+   };
+
+   using shared_value = basic_value< shared_traits >;
+
+   template< template< typename... > class... Transformers >
+   [[nodiscard]] shared_value shared_from_string( const std::string_view data, const std::string& source = std::string() )
+   {
+      json::events::transformer< json::events::to_basic_value< shared_traits >, Transformers... > consumer;
+      json::events::from_string( consumer, data, source );
+      return std::move( consumer.value );
+   }
+
+}  // namespace tao::json
+
+#endif
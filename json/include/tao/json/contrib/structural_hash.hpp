@@ -0,0 +1,176 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_CONTRIB_STRUCTURAL_HASH_HPP
+#define TAO_JSON_CONTRIB_STRUCTURAL_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include "../basic_value.hpp"
+#include "../binary_view.hpp"
+
+namespace tao::json
+{
+   namespace internal
+   {
+      [[nodiscard]] inline std::uint64_t hash_mix( std::uint64_t h ) noexcept
+      {
+         h ^= h >> 30;
+         h *= 0xbf58476d1ce4e5b9;
+         h ^= h >> 27;
+         h *= 0x94d049bb133111eb;
+         h ^= h >> 31;
+         return h;
+      }
+
+      [[nodiscard]] inline std::uint64_t hash_combine( const std::uint64_t h, const std::uint64_t v ) noexcept
+      {
+         return hash_mix( h + 0x9e3779b97f4a7c15 + v );
+      }
+
+      [[nodiscard]] inline std::uint64_t hash_bytes( const std::string_view v ) noexcept
+      {
+         return std::hash< std::string_view >()( v );
+      }
+
+      [[nodiscard]] inline std::uint64_t hash_bytes( const tao::binary_view v ) noexcept
+      {
+         return hash_bytes( std::string_view( reinterpret_cast< const char* >( v.data() ), v.size() ) );
+      }
+
+      // All numbers are hashed as double since operator== compares numbers
+      // of different types by value, e.g. 1 == 1U == 1.0 and -0.0 == 0.0.
+
+      [[nodiscard]] inline std::uint64_t hash_number( const double d ) noexcept
+      {
+         const double n = ( d == 0.0 ) ? 0.0 : d;
+         std::uint64_t v;
+         std::memcpy( &v, &n, sizeof( v ) );
+         return hash_combine( 4, v );
+      }
+
+      template< template< typename... > class Traits >
+      [[nodiscard]] std::uint64_t hash_scalar( const basic_value< Traits >& v ) noexcept
+      {
+         switch( v.type() ) {
+            case type::NULL_:
+               return 1;
+
+            case type::BOOLEAN:
+               return v.unsafe_get_boolean() ? 3 : 2;
+
+            case type::SIGNED:
+               return hash_number( static_cast< double >( v.unsafe_get_signed() ) );
+
+            case type::UNSIGNED:
+               return hash_number( static_cast< double >( v.unsafe_get_unsigned() ) );
+
+            case type::DOUBLE:
+               return hash_number( v.unsafe_get_double() );
+
+            case type::STRING:
+               return hash_combine( 5, hash_bytes( v.unsafe_get_string() ) );
+
+            case type::STRING_VIEW:
+               return hash_combine( 5, hash_bytes( v.unsafe_get_string_view() ) );
+
+            case type::BINARY:
+               return hash_combine( 6, hash_bytes( tao::binary_view( v.unsafe_get_binary() ) ) );
+
+            case type::BINARY_VIEW:
+               return hash_combine( 6, hash_bytes( v.unsafe_get_binary_view() ) );
+
+            default:
+               return 0;
+         }
+      }
+
+   }  // namespace internal
+
+   // A 64-bit hash of a Value that is consistent with operator==, i.e.
+   // Values that compare equal have the same hash. The hash is computed
+   // from all sub-values on every call and never cached, since a sub-value
+   // can be modified through a reference without its parents noticing.
+
+   template< template< typename... > class Traits >
+   [[nodiscard]] std::uint64_t structural_hash( const basic_value< Traits >& v )
+   {
+      using array_t = typename basic_value< Traits >::array_t;
+      using object_t = typename basic_value< Traits >::object_t;
+
+      struct frame
+      {
+         const basic_value< Traits >* v;
+         typename array_t::const_iterator a;
+         typename object_t::const_iterator o;
+         std::uint64_t h;
+      };
+      std::byte buffer[ 1024 ];
+      std::pmr::monotonic_buffer_resource resource( buffer, sizeof( buffer ) );
+      std::pmr::vector< frame > stack( &resource );
+      std::uint64_t h = 0;
+
+      // Sets h and returns false, or pushes a frame for an Array or Object
+      // and returns true.
+      const auto enter = [ & ]( const basic_value< Traits >& e ) {
+         if( e.is_array() ) {
+            stack.push_back( { &e, e.unsafe_get_array().begin(), {}, 7 } );
+            return true;
+         }
+         if( e.is_object() ) {
+            stack.push_back( { &e, {}, e.unsafe_get_object().begin(), 8 } );
+            return true;
+         }
+         h = internal::hash_scalar( e );
+         return false;
+      };
+
+      if( !enter( v.skip_value_ptr() ) ) {
+         return h;
+      }
+      while( !stack.empty() ) {
+         auto& f = stack.back();
+         const basic_value< Traits >* n = nullptr;
+         if( f.v->is_array() ) {
+            if( f.a != f.v->unsafe_get_array().end() ) {
+               n = &( f.a++ )->skip_value_ptr();
+            }
+         }
+         else if( f.o != f.v->unsafe_get_object().end() ) {
+            f.h = internal::hash_combine( f.h, internal::hash_bytes( f.o->first ) );
+            n = &( f.o++ )->second.skip_value_ptr();
+         }
+         if( n != nullptr ) {
+            if( !enter( *n ) ) {
+               f.h = internal::hash_combine( f.h, h );
+            }
+            continue;
+         }
+         const std::size_t size = f.v->is_array() ? f.v->unsafe_get_array().size() : f.v->unsafe_get_object().size();
+         h = internal::hash_combine( f.h, size );
+         stack.pop_back();
+         if( !stack.empty() ) {
+            stack.back().h = internal::hash_combine( stack.back().h, h );
+         }
+      }
+      return h;
+   }
+
+}  // namespace tao::json
+
+template< template< typename... > class Traits >
+struct std::hash< tao::json::basic_value< Traits > >
+{
+   [[nodiscard]] std::size_t operator()( const tao::json::basic_value< Traits >& v ) const
+   {
+      return static_cast< std::size_t >( tao::json::structural_hash( v ) );
+   }
+};
+
+#endif
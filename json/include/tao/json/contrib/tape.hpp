@@ -0,0 +1,775 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_CONTRIB_TAPE_HPP
+#define TAO_JSON_CONTRIB_TAPE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../binary_view.hpp"
+#include "../events/from_string.hpp"
+#include "../events/parse_file.hpp"
+#include "../events/to_stream.hpp"
+#include "../events/transformer.hpp"
+#include "../internal/escape.hpp"
+#include "../internal/format.hpp"
+#include "../pointer.hpp"
+#include "../type.hpp"
+
+namespace tao::json
+{
+   // An immutable JSON document stored as a flat array of 64-bit words and
+   // a buffer for the contents of strings, keys and binary data.
+
+   // Every word has a tag in the top 8 bits and a 56-bit payload.
+   // - Null and booleans use one word without payload.
+   // - Numbers use two words, the second holds the raw 64 bits.
+   // - Strings, keys and binary data use two words, the payload of the first
+   //   is the offset into the buffer, the second word holds the size.
+   // - Arrays and objects are enclosed in a begin and an end word; the
+   //   payload of the begin word is the index of the end word, the payload
+   //   of the end word is the number of elements or members.
+   // - Object members are a key followed by the value, in input order.
+
+   enum class tape_tag : std::uint8_t
+   {
+      NULL_,
+      TRUE_,
+      FALSE_,
+      SIGNED,
+      UNSIGNED,
+      DOUBLE,
+      STRING,
+      BINARY,
+      BEGIN_ARRAY,
+      END_ARRAY,
+      BEGIN_OBJECT,
+      END_OBJECT
+   };
+
+   class tape;
+   class tape_ref;
+
+   namespace internal
+   {
+      inline constexpr std::uint64_t tape_payload_mask = ( std::uint64_t( 1 ) << 56 ) - 1;
+
+      [[nodiscard]] constexpr std::uint64_t tape_word( const tape_tag t, const std::uint64_t p = 0 ) noexcept
+      {
+         return ( std::uint64_t( t ) << 56 ) | p;
+      }
+
+      [[nodiscard]] constexpr tape_tag tape_word_tag( const std::uint64_t w ) noexcept
+      {
+         return static_cast< tape_tag >( w >> 56 );
+      }
+
+      [[nodiscard]] constexpr std::uint64_t tape_word_payload( const std::uint64_t w ) noexcept
+      {
+         return w & tape_payload_mask;
+      }
+
+   }  // namespace internal
+
+   class tape
+   {
+   public:
+      [[nodiscard]] bool empty() const noexcept
+      {
+         return m_words.empty();
+      }
+
+      [[nodiscard]] const std::vector< std::uint64_t >& words() const noexcept
+      {
+         return m_words;
+      }
+
+      [[nodiscard]] const std::string& strings() const noexcept
+      {
+         return m_strings;
+      }
+
+      [[nodiscard]] inline tape_ref root() const;
+
+      void clear() noexcept
+      {
+         m_words.clear();
+         m_strings.clear();
+      }
+
+      void unsafe_append( const tape_tag t, const std::uint64_t p = 0 )
+      {
+         m_words.emplace_back( internal::tape_word( t, p ) );
+      }
+
+      void unsafe_append_raw( const std::uint64_t w )
+      {
+         m_words.emplace_back( w );
+      }
+
+      void unsafe_append_data( const tape_tag t, const void* data, const std::size_t size )
+      {
+         unsafe_append( t, m_strings.size() );
+         m_words.emplace_back( size );
+         m_strings.append( static_cast< const char* >( data ), size );
+      }
+
+      [[nodiscard]] std::size_t unsafe_begin_container( const tape_tag t )
+      {
+         m_words.emplace_back( internal::tape_word( t ) );
+         return m_words.size() - 1;
+      }
+
+      void unsafe_end_container( const std::size_t begin, const tape_tag t, const std::size_t count )
+      {
+         m_words[ begin ] |= m_words.size();
+         unsafe_append( t, count );
+      }
+
+      // Index of the word following the value that starts at index i.
+      [[nodiscard]] std::size_t skip( const std::size_t i ) const noexcept
+      {
+         const auto w = m_words[ i ];
+         switch( internal::tape_word_tag( w ) ) {
+            case tape_tag::NULL_:
+            case tape_tag::TRUE_:
+            case tape_tag::FALSE_:
+            case tape_tag::END_ARRAY:
+            case tape_tag::END_OBJECT:
+               return i + 1;
+            case tape_tag::BEGIN_ARRAY:
+            case tape_tag::BEGIN_OBJECT:
+               return internal::tape_word_payload( w ) + 1;
+            default:
+               return i + 2;
+         }
+      }
+
+   private:
+      std::vector< std::uint64_t > m_words;
+      std::string m_strings;
+   };
+
+   struct tape_member;
+
+   template< typename T >
+   class tape_iterator
+   {
+   public:
+      tape_iterator( const tape& t, const std::size_t i ) noexcept
+         : m_tape( &t ),
+           m_index( i )
+      {}
+
+      [[nodiscard]] inline T operator*() const;
+
+      tape_iterator& operator++() noexcept
+      {
+         m_index = m_tape->skip( std::is_same_v< T, tape_member > ? ( m_index + 2 ) : m_index );
+         return *this;
+      }
+
+      [[nodiscard]] bool operator==( const tape_iterator& r ) const noexcept
+      {
+         return m_index == r.m_index;
+      }
+
+      [[nodiscard]] bool operator!=( const tape_iterator& r ) const noexcept
+      {
+         return m_index != r.m_index;
+      }
+
+   private:
+      const tape* m_tape;
+      std::size_t m_index;
+   };
+
+   template< typename T >
+   class tape_range
+   {
+   public:
+      tape_range( const tape& t, const std::size_t begin, const std::size_t end, const std::size_t size ) noexcept
+         : m_begin( t, begin ),
+           m_end( t, end ),
+           m_size( size )
+      {}
+
+      [[nodiscard]] tape_iterator< T > begin() const noexcept
+      {
+         return m_begin;
+      }
+
+      [[nodiscard]] tape_iterator< T > end() const noexcept
+      {
+         return m_end;
+      }
+
+      [[nodiscard]] std::size_t size() const noexcept
+      {
+         return m_size;
+      }
+
+      [[nodiscard]] bool empty() const noexcept
+      {
+         return m_size == 0;
+      }
+
+   private:
+      tape_iterator< T > m_begin;
+      tape_iterator< T > m_end;
+      std::size_t m_size;
+   };
+
+   // A lightweight cursor to a value in a tape; it is only valid as long as
+   // the tape is alive and unchanged. Lookups by index or key are linear in
+   // the number of elements or members, nested values are skipped in O(1).
+
+   class tape_ref
+   {
+   public:
+      tape_ref( const tape& t, const std::size_t i ) noexcept
+         : m_tape( &t ),
+           m_index( i )
+      {}
+
+      [[nodiscard]] const tape& get_tape() const noexcept
+      {
+         return *m_tape;
+      }
+
+      [[nodiscard]] std::size_t index() const noexcept
+      {
+         return m_index;
+      }
+
+      [[nodiscard]] tape_tag tag() const noexcept
+      {
+         return internal::tape_word_tag( word() );
+      }
+
+      [[nodiscard]] json::type type() const noexcept
+      {
+         switch( tag() ) {
+            case tape_tag::NULL_:
+               return json::type::NULL_;
+            case tape_tag::TRUE_:
+            case tape_tag::FALSE_:
+               return json::type::BOOLEAN;
+            case tape_tag::SIGNED:
+               return json::type::SIGNED;
+            case tape_tag::UNSIGNED:
+               return json::type::UNSIGNED;
+            case tape_tag::DOUBLE:
+               return json::type::DOUBLE;
+            case tape_tag::STRING:
+               return json::type::STRING;
+            case tape_tag::BINARY:
+               return json::type::BINARY;
+            case tape_tag::BEGIN_ARRAY:
+               return json::type::ARRAY;
+            case tape_tag::BEGIN_OBJECT:
+               return json::type::OBJECT;
+            default:
+               break;
+         }
+         return json::type::UNINITIALIZED;  // LCOV_EXCL_LINE
+      }
+
+      [[nodiscard]] bool is_null() const noexcept
+      {
+         return tag() == tape_tag::NULL_;
+      }
+
+      [[nodiscard]] bool is_boolean() const noexcept
+      {
+         return type() == json::type::BOOLEAN;
+      }
+
+      [[nodiscard]] bool is_signed() const noexcept
+      {
+         return tag() == tape_tag::SIGNED;
+      }
+
+      [[nodiscard]] bool is_unsigned() const noexcept
+      {
+         return tag() == tape_tag::UNSIGNED;
+      }
+
+      [[nodiscard]] bool is_integer() const noexcept
+      {
+         return is_signed() || is_unsigned();
+      }
+
+      [[nodiscard]] bool is_double() const noexcept
+      {
+         return tag() == tape_tag::DOUBLE;
+      }
+
+      [[nodiscard]] bool is_number() const noexcept
+      {
+         return is_integer() || is_double();
+      }
+
+      [[nodiscard]] bool is_string() const noexcept
+      {
+         return tag() == tape_tag::STRING;
+      }
+
+      [[nodiscard]] bool is_binary() const noexcept
+      {
+         return tag() == tape_tag::BINARY;
+      }
+
+      [[nodiscard]] bool is_array() const noexcept
+      {
+         return tag() == tape_tag::BEGIN_ARRAY;
+      }
+
+      [[nodiscard]] bool is_object() const noexcept
+      {
+         return tag() == tape_tag::BEGIN_OBJECT;
+      }
+
+      [[nodiscard]] bool unsafe_get_boolean() const noexcept
+      {
+         return tag() == tape_tag::TRUE_;
+      }
+
+      [[nodiscard]] std::int64_t unsafe_get_signed() const noexcept
+      {
+         return static_cast< std::int64_t >( next_word() );
+      }
+
+      [[nodiscard]] std::uint64_t unsafe_get_unsigned() const noexcept
+      {
+         return next_word();
+      }
+
+      [[nodiscard]] double unsafe_get_double() const noexcept
+      {
+         const auto w = next_word();
+         double d;
+         std::memcpy( &d, &w, sizeof( d ) );
+         return d;
+      }
+
+      [[nodiscard]] std::string_view unsafe_get_string_type() const noexcept
+      {
+         return std::string_view( m_tape->strings().data() + internal::tape_word_payload( word() ), next_word() );
+      }
+
+      [[nodiscard]] tao::binary_view unsafe_get_binary_type() const noexcept
+      {
+         return tao::binary_view( reinterpret_cast< const std::byte* >( m_tape->strings().data() + internal::tape_word_payload( word() ) ), next_word() );
+      }
+
+      [[nodiscard]] std::size_t unsafe_size() const noexcept
+      {
+         return internal::tape_word_payload( m_tape->words()[ end_index() ] );
+      }
+
+      [[nodiscard]] tape_range< tape_ref > unsafe_get_array() const noexcept
+      {
+         return tape_range< tape_ref >( *m_tape, m_index + 1, end_index(), unsafe_size() );
+      }
+
+      [[nodiscard]] tape_range< tape_member > unsafe_get_object() const noexcept
+      {
+         return tape_range< tape_member >( *m_tape, m_index + 1, end_index(), unsafe_size() );
+      }
+
+      [[nodiscard]] bool get_boolean() const
+      {
+         validate_json_type( json::type::BOOLEAN );
+         return unsafe_get_boolean();
+      }
+
+      [[nodiscard]] std::int64_t get_signed() const
+      {
+         validate_json_type( json::type::SIGNED );
+         return unsafe_get_signed();
+      }
+
+      [[nodiscard]] std::uint64_t get_unsigned() const
+      {
+         validate_json_type( json::type::UNSIGNED );
+         return unsafe_get_unsigned();
+      }
+
+      [[nodiscard]] double get_double() const
+      {
+         validate_json_type( json::type::DOUBLE );
+         return unsafe_get_double();
+      }
+
+      [[nodiscard]] std::string_view get_string_type() const
+      {
+         validate_json_type( json::type::STRING );
+         return unsafe_get_string_type();
+      }
+
+      [[nodiscard]] tao::binary_view get_binary_type() const
+      {
+         validate_json_type( json::type::BINARY );
+         return unsafe_get_binary_type();
+      }
+
+      [[nodiscard]] tape_range< tape_ref > get_array() const
+      {
+         validate_json_type( json::type::ARRAY );
+         return unsafe_get_array();
+      }
+
+      [[nodiscard]] tape_range< tape_member > get_object() const
+      {
+         validate_json_type( json::type::OBJECT );
+         return unsafe_get_object();
+      }
+
+      [[nodiscard]] std::size_t size() const
+      {
+         if( !is_array() && !is_object() ) {
+            throw std::logic_error( internal::format( "invalid json type '", type(), "', expected 'array' or 'object'" ) );  // NOLINT
+         }
+         return unsafe_size();
+      }
+
+      [[nodiscard]] std::optional< tape_ref > find( std::size_t index ) const
+      {
+         validate_json_type( json::type::ARRAY );
+         const auto e = end_index();
+         for( auto i = m_index + 1; i != e; i = m_tape->skip( i ) ) {
+            if( index-- == 0 ) {
+               return tape_ref( *m_tape, i );
+            }
+         }
+         return std::nullopt;
+      }
+
+      [[nodiscard]] std::optional< tape_ref > find( const std::string_view key ) const
+      {
+         validate_json_type( json::type::OBJECT );
+         const auto e = end_index();
+         for( auto i = m_index + 1; i != e; i = m_tape->skip( i + 2 ) ) {
+            if( tape_ref( *m_tape, i ).unsafe_get_string_type() == key ) {
+               return tape_ref( *m_tape, i + 2 );
+            }
+         }
+         return std::nullopt;
+      }
+
+      [[nodiscard]] std::optional< tape_ref > find( const pointer& k ) const
+      {
+         std::optional< tape_ref > v = *this;
+         for( const auto& t : k ) {
+            v = v->is_array() ? v->find( t.index() ) : v->find( std::string_view( t.key() ) );
+            if( !v ) {
+               break;
+            }
+         }
+         return v;
+      }
+
+      [[nodiscard]] tape_ref at( const std::size_t index ) const
+      {
+         if( const auto v = find( index ) ) {
+            return *v;
+         }
+         throw std::out_of_range( internal::format( "JSON array index '", index, "' out of bound '", unsafe_size(), '\'' ) );  // NOLINT
+      }
+
+      [[nodiscard]] tape_ref at( const std::string_view key ) const
+      {
+         if( const auto v = find( key ) ) {
+            return *v;
+         }
+         throw std::out_of_range( internal::format( "JSON object key \"", internal::escape( key ), "\" not found" ) );  // NOLINT
+      }
+
+      [[nodiscard]] tape_ref at( const pointer& k ) const
+      {
+         if( const auto v = find( k ) ) {
+            return *v;
+         }
+         throw std::out_of_range( internal::format( "JSON pointer \"", to_string( k ), "\" not found" ) );  // NOLINT
+      }
+
+      [[nodiscard]] tape_ref operator[]( const std::size_t index ) const
+      {
+         return at( index );
+      }
+
+      [[nodiscard]] tape_ref operator[]( const std::string_view key ) const
+      {
+         return at( key );
+      }
+
+      [[nodiscard]] tape_ref operator[]( const pointer& k ) const
+      {
+         return at( k );
+      }
+
+      void validate_json_type( const json::type t ) const
+      {
+         if( type() != t ) {
+            throw std::logic_error( internal::format( "invalid json type '", type(), "', expected '", t, '\'' ) );  // NOLINT
+         }
+      }
+
+   private:
+      [[nodiscard]] std::uint64_t word() const noexcept
+      {
+         return m_tape->words()[ m_index ];
+      }
+
+      [[nodiscard]] std::uint64_t next_word() const noexcept
+      {
+         return m_tape->words()[ m_index + 1 ];
+      }
+
+      [[nodiscard]] std::size_t end_index() const noexcept
+      {
+         return internal::tape_word_payload( word() );
+      }
+
+      const tape* m_tape;
+      std::size_t m_index;
+   };
+
+   struct tape_member
+   {
+      std::string_view first;
+      tape_ref second;
+   };
+
+   inline tape_ref tape::root() const
+   {
+      if( m_words.empty() ) {
+         throw std::logic_error( "empty tape has no root" );  // NOLINT
+      }
+      return tape_ref( *this, 0 );
+   }
+
+   template< typename T >
+   T tape_iterator< T >::operator*() const
+   {
+      if constexpr( std::is_same_v< T, tape_member > ) {
+         return tape_member{ tape_ref( *m_tape, m_index ).unsafe_get_string_type(), tape_ref( *m_tape, m_index + 2 ) };
+      }
+      else {
+         return tape_ref( *m_tape, m_index );
+      }
+   }
+
+   namespace events
+   {
+      // Events consumer to build a tape.
+
+      struct to_tape
+      {
+         tape value;
+         std::vector< std::size_t > stack_;
+         std::vector< std::size_t > count_;
+
+         void null()
+         {
+            value.unsafe_append( tape_tag::NULL_ );
+         }
+
+         void boolean( const bool v )
+         {
+            value.unsafe_append( v ? tape_tag::TRUE_ : tape_tag::FALSE_ );
+         }
+
+         void number( const std::int64_t v )
+         {
+            value.unsafe_append( tape_tag::SIGNED );
+            value.unsafe_append_raw( static_cast< std::uint64_t >( v ) );
+         }
+
+         void number( const std::uint64_t v )
+         {
+            value.unsafe_append( tape_tag::UNSIGNED );
+            value.unsafe_append_raw( v );
+         }
+
+         void number( const double v )
+         {
+            std::uint64_t w;
+            std::memcpy( &w, &v, sizeof( w ) );
+            value.unsafe_append( tape_tag::DOUBLE );
+            value.unsafe_append_raw( w );
+         }
+
+         void string( const std::string_view v )
+         {
+            value.unsafe_append_data( tape_tag::STRING, v.data(), v.size() );
+         }
+
+         void binary( const tao::binary_view v )
+         {
+            value.unsafe_append_data( tape_tag::BINARY, v.data(), v.size() );
+         }
+
+         void begin_array( const std::size_t /*unused*/ = 0 )
+         {
+            stack_.emplace_back( value.unsafe_begin_container( tape_tag::BEGIN_ARRAY ) );
+            count_.emplace_back( 0 );
+         }
+
+         void element() noexcept
+         {
+            ++count_.back();
+         }
+
+         void end_array( const std::size_t /*unused*/ = 0 )
+         {
+            value.unsafe_end_container( stack_.back(), tape_tag::END_ARRAY, count_.back() );
+            stack_.pop_back();
+            count_.pop_back();
+         }
+
+         void begin_object( const std::size_t /*unused*/ = 0 )
+         {
+            stack_.emplace_back( value.unsafe_begin_container( tape_tag::BEGIN_OBJECT ) );
+            count_.emplace_back( 0 );
+         }
+
+         void key( const std::string_view v )
+         {
+            string( v );
+         }
+
+         void member() noexcept
+         {
+            ++count_.back();
+         }
+
+         void end_object( const std::size_t /*unused*/ = 0 )
+         {
+            value.unsafe_end_container( stack_.back(), tape_tag::END_OBJECT, count_.back() );
+            stack_.pop_back();
+            count_.pop_back();
+         }
+      };
+
+      // Events producer to generate events from a tape (or a part thereof);
+      // a single pass over the words of the value, without recursion.
+
+      template< typename Consumer >
+      void from_tape( Consumer& consumer, const tape_ref r )
+      {
+         const auto& t = r.get_tape();
+         const auto end = t.skip( r.index() );
+         std::vector< bool > objects;
+         bool key = false;
+
+         for( std::size_t i = r.index(); i != end; ) {
+            const tape_ref v( t, i );
+            switch( v.tag() ) {
+               case tape_tag::NULL_:
+                  consumer.null();
+                  break;
+               case tape_tag::TRUE_:
+               case tape_tag::FALSE_:
+                  consumer.boolean( v.unsafe_get_boolean() );
+                  break;
+               case tape_tag::SIGNED:
+                  consumer.number( v.unsafe_get_signed() );
+                  break;
+               case tape_tag::UNSIGNED:
+                  consumer.number( v.unsafe_get_unsigned() );
+                  break;
+               case tape_tag::DOUBLE:
+                  consumer.number( v.unsafe_get_double() );
+                  break;
+               case tape_tag::STRING:
+                  if( key ) {
+                     consumer.key( v.unsafe_get_string_type() );
+                     key = false;
+                     i += 2;
+                     continue;
+                  }
+                  consumer.string( v.unsafe_get_string_type() );
+                  break;
+               case tape_tag::BINARY:
+                  consumer.binary( v.unsafe_get_binary_type() );
+                  break;
+               case tape_tag::BEGIN_ARRAY:
+                  consumer.begin_array( v.unsafe_size() );
+                  objects.push_back( false );
+                  ++i;
+                  continue;
+               case tape_tag::BEGIN_OBJECT:
+                  consumer.begin_object( v.unsafe_size() );
+                  objects.push_back( true );
+                  key = true;
+                  ++i;
+                  continue;
+               case tape_tag::END_ARRAY:
+                  consumer.end_array( internal::tape_word_payload( t.words()[ i ] ) );
+                  objects.pop_back();
+                  break;
+               case tape_tag::END_OBJECT:
+                  consumer.end_object( internal::tape_word_payload( t.words()[ i ] ) );
+                  objects.pop_back();
+                  key = false;
+                  break;
+            }
+            i = t.skip( i );
+            if( !objects.empty() ) {
+               if( objects.back() ) {
+                  consumer.member();
+                  key = true;
+               }
+               else {
+                  consumer.element();
+               }
+            }
+         }
+      }
+
+      template< typename Consumer >
+      void from_tape( Consumer& consumer, const tape& t )
+      {
+         events::from_tape( consumer, t.root() );
+      }
+
+   }  // namespace events
+
+   template< template< typename... > class... Transformers, typename... Ts >
+   [[nodiscard]] tape tape_from_string( Ts&&... ts )
+   {
+      events::transformer< events::to_tape, Transformers... > consumer;
+      events::from_string( consumer, std::forward< Ts >( ts )... );
+      return std::move( consumer.value );
+   }
+
+   template< template< typename... > class... Transformers >
+   [[nodiscard]] tape tape_parse_file( const std::string& filename )
+   {
+      events::transformer< events::to_tape, Transformers... > consumer;
+      events::parse_file( consumer, filename );
+      return std::move( consumer.value );
+   }
+
+   inline std::ostream& operator<<( std::ostream& o, const tape_ref r )
+   {
+      events::to_stream consumer( o );
+      events::from_tape( consumer, r );
+      return o;
+   }
+
+}  // namespace tao::json
+
+#endif
@@ -7,8 +7,10 @@
 // Events producers
 #include "events/from_stream.hpp"
 #include "events/from_string.hpp"
+#include "events/from_string_indexed.hpp"
 #include "events/from_value.hpp"
 #include "events/parse_file.hpp"
+#include "events/parse_file_indexed.hpp"
 #include "events/produce.hpp"
 
 // Events consumers
@@ -16,6 +18,7 @@
 #include "events/to_stream.hpp"
 #include "events/to_string.hpp"
 #include "events/to_value.hpp"
+#include "events/to_view_value.hpp"
 
 // Events transformers
 #include "events/binary_to_base64.hpp"
@@ -0,0 +1,50 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_EVENTS_FROM_STRING_INDEXED_HPP
+#define TAO_JSON_EVENTS_FROM_STRING_INDEXED_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../internal/indexed_parser.hpp"
+
+#include "from_string.hpp"
+
+namespace tao::json::events
+{
+   // Events producer to parse a JSON string representation with the indexed
+   // parser, a drop-in replacement for events::from_string() that first
+   // finds all tokens with SIMD instructions and then parses them without
+   // the PEGTL, see internal/structural_index.hpp. Inputs of 4GB and more
+   // are parsed with events::from_string().
+
+   template< typename Consumer >
+   void from_string_indexed( Consumer& consumer, const char* data, const std::size_t size, const char* source = nullptr, const std::size_t byte = 0, const std::size_t line = 1, const std::size_t column = 0 )
+   {
+      if( std::uint64_t( size ) > UINT32_MAX ) {
+         events::from_string( consumer, data, size, source, byte, line, column );
+         return;
+      }
+      std::vector< std::uint32_t > indices;
+      internal::indexed_parser< Consumer >( consumer, data, size, source ? source : "tao::json::events::from_string_indexed", byte, line, column ).parse( indices );
+   }
+
+   template< typename Consumer >
+   void from_string_indexed( Consumer& consumer, const char* data, const std::size_t size, const std::string& source, const std::size_t byte = 0, const std::size_t line = 1, const std::size_t column = 0 )
+   {
+      events::from_string_indexed( consumer, data, size, source.c_str(), byte, line, column );
+   }
+
+   template< typename Consumer, typename... Ts >
+   void from_string_indexed( Consumer& consumer, const std::string_view data, Ts&&... ts )
+   {
+      events::from_string_indexed( consumer, data.data(), data.size(), std::forward< Ts >( ts )... );
+   }
+
+}  // namespace tao::json::events
+
+#endif
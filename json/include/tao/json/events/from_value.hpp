@@ -4,7 +4,10 @@
 #ifndef TAO_JSON_EVENTS_FROM_VALUE_HPP
 #define TAO_JSON_EVENTS_FROM_VALUE_HPP
 
+#include <cstddef>
+#include <memory_resource>
 #include <stdexcept>
+#include <vector>
 
 #include "../basic_value.hpp"
 #include "../internal/format.hpp"
@@ -103,10 +106,83 @@ namespace tao::json::events
       throw std::logic_error( internal::format( "invalid value '", static_cast< std::uint8_t >( v.type() ), "' for tao::json::type" ) );  // NOLINT, LCOV_EXCL_LINE
    }
 
+   // Without an explicit Recurse the nested Arrays and Objects are visited
+   // with an explicit stack instead of recursion, the depth of the Value is
+   // only limited by the available memory.
+
    template< typename Consumer, template< typename... > class Traits >
    void from_value( Consumer& consumer, const basic_value< Traits >& v )
    {
-      from_value< static_cast< void ( * )( Consumer&, const basic_value< Traits >& ) >( &from_value< Consumer, Traits > ), Consumer, Traits >( consumer, v );
+      struct frame
+      {
+         const basic_value< Traits >* v;
+         typename basic_value< Traits >::array_t::const_iterator a;
+         typename basic_value< Traits >::object_t::const_iterator o;
+      };
+      std::byte buffer[ 1024 ];
+      std::pmr::monotonic_buffer_resource resource( buffer, sizeof( buffer ) );
+      std::pmr::vector< frame > stack( &resource );
+      const basic_value< Traits >* p = &v;
+      while( true ) {
+         switch( p->type() ) {
+            case type::ARRAY: {
+               const auto& a = p->unsafe_get_array();
+               consumer.begin_array( a.size() );
+               if( !a.empty() ) {
+                  stack.push_back( { p, a.begin(), {} } );
+                  p = &*a.begin();
+                  continue;
+               }
+               consumer.end_array( a.size() );
+            } break;
+
+            case type::OBJECT: {
+               const auto& o = p->unsafe_get_object();
+               consumer.begin_object( o.size() );
+               if( !o.empty() ) {
+                  stack.push_back( { p, {}, o.begin() } );
+                  consumer.key( o.begin()->first );
+                  p = &o.begin()->second;
+                  continue;
+               }
+               consumer.end_object( o.size() );
+            } break;
+
+            case type::VALUE_PTR:
+               p = p->unsafe_get_value_ptr();
+               continue;
+
+            default:
+               from_value< static_cast< void ( * )( Consumer&, const basic_value< Traits >& ) >( &from_value< Consumer, Traits > ), Consumer, Traits >( consumer, *p );
+               break;
+         }
+         while( true ) {
+            if( stack.empty() ) {
+               return;
+            }
+            auto& f = stack.back();
+            if( f.v->is_array() ) {
+               const auto& a = f.v->unsafe_get_array();
+               consumer.element();
+               if( ++f.a != a.end() ) {
+                  p = &*f.a;
+                  break;
+               }
+               consumer.end_array( a.size() );
+            }
+            else {
+               const auto& o = f.v->unsafe_get_object();
+               consumer.member();
+               if( ++f.o != o.end() ) {
+                  consumer.key( f.o->first );
+                  p = &f.o->second;
+                  break;
+               }
+               consumer.end_object( o.size() );
+            }
+            stack.pop_back();
+         }
+      }
    }
 
    // Events producer to generate events from an rvalue JSON value.
@@ -181,7 +257,8 @@ namespace tao::json::events
             return;
 
          case type::VALUE_PTR:
-            Recurse( consumer, *v.unsafe_get_value_ptr() );
+            // The pointee is not owned by v and must not be moved from.
+            from_value( consumer, *v.unsafe_get_value_ptr() );
             return;
 
          case type::OPAQUE_PTR: {
@@ -197,7 +274,76 @@ namespace tao::json::events
    template< typename Consumer, template< typename... > class Traits >
    void from_value( Consumer& consumer, basic_value< Traits >&& v )
    {
-      from_value< static_cast< void ( * )( Consumer&, basic_value< Traits > && ) >( &from_value< Consumer, Traits > ), Consumer, Traits >( consumer, std::move( v ) );
+      struct frame
+      {
+         basic_value< Traits >* v;
+         typename basic_value< Traits >::array_t::iterator a;
+         typename basic_value< Traits >::object_t::iterator o;
+      };
+      std::byte buffer[ 1024 ];
+      std::pmr::monotonic_buffer_resource resource( buffer, sizeof( buffer ) );
+      std::pmr::vector< frame > stack( &resource );
+      basic_value< Traits >* p = &v;
+      while( true ) {
+         switch( p->type() ) {
+            case type::ARRAY: {
+               auto& a = p->unsafe_get_array();
+               consumer.begin_array( a.size() );
+               if( !a.empty() ) {
+                  stack.push_back( { p, a.begin(), {} } );
+                  p = &*stack.back().a;
+                  continue;
+               }
+               consumer.end_array( a.size() );
+            } break;
+
+            case type::OBJECT: {
+               auto& o = p->unsafe_get_object();
+               consumer.begin_object( o.size() );
+               if( !o.empty() ) {
+                  stack.push_back( { p, {}, o.begin() } );
+                  consumer.key( stack.back().o->first );
+                  p = &stack.back().o->second;
+                  continue;
+               }
+               consumer.end_object( o.size() );
+            } break;
+
+            case type::VALUE_PTR:
+               from_value( consumer, *p->unsafe_get_value_ptr() );
+               break;
+
+            default:
+               from_value< static_cast< void ( * )( Consumer&, basic_value< Traits > && ) >( &from_value< Consumer, Traits > ), Consumer, Traits >( consumer, std::move( *p ) );
+               break;
+         }
+         while( true ) {
+            if( stack.empty() ) {
+               return;
+            }
+            auto& f = stack.back();
+            if( f.v->is_array() ) {
+               auto& a = f.v->unsafe_get_array();
+               consumer.element();
+               if( ++f.a != a.end() ) {
+                  p = &*f.a;
+                  break;
+               }
+               consumer.end_array( a.size() );
+            }
+            else {
+               auto& o = f.v->unsafe_get_object();
+               consumer.member();
+               if( ++f.o != o.end() ) {
+                  consumer.key( f.o->first );
+                  p = &f.o->second;
+                  break;
+               }
+               consumer.end_object( o.size() );
+            }
+            stack.pop_back();
+         }
+      }
    }
 
 }  // namespace tao::json::events
@@ -14,6 +14,8 @@ namespace tao::json::events
    {
       using Consumer::Consumer;
 
+      static constexpr bool disable_number_raw = true;
+
       using Consumer::number;
 
       void number( const double v )
@@ -0,0 +1,27 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_EVENTS_PARSE_FILE_INDEXED_HPP
+#define TAO_JSON_EVENTS_PARSE_FILE_INDEXED_HPP
+
+#include <utility>
+
+#include "../external/pegtl/file_input.hpp"
+
+#include "from_string_indexed.hpp"
+
+namespace tao::json::events
+{
+   // Events producer to parse a file containing a JSON string representation
+   // with the indexed parser, see events::from_string_indexed().
+
+   template< typename T, typename Consumer >
+   void parse_file_indexed( Consumer& consumer, T&& filename )
+   {
+      const pegtl::file_input< pegtl::tracking_mode::lazy > in( std::forward< T >( filename ) );
+      events::from_string_indexed( consumer, in.begin(), in.size(), in.source() );
+   }
+
+}  // namespace tao::json::events
+
+#endif
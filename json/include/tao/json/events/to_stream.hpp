@@ -81,6 +81,14 @@ namespace tao::json::events
          ryu::d2s_stream( os, v );
       }
 
+      // Called by the JSON parsers instead of number() with the original
+      // text of the number, which is therefore written without conversion.
+      void number_raw( const std::string_view v )
+      {
+         next();
+         os.write( v.data(), v.size() );
+      }
+
       void string( const std::string_view v )
       {
          next();
@@ -6,11 +6,16 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "../internal/escape.hpp"
+#include "../internal/format.hpp"
+#include "../internal/type_traits.hpp"
+
 #include "../binary_view.hpp"
 #include "../value.hpp"
 
@@ -21,10 +26,18 @@ namespace tao::json::events
    template< template< typename... > class Traits >
    struct to_basic_value
    {
+      using object_t = typename basic_value< Traits >::object_t;
+
+      static constexpr bool bulk_objects = internal::has_unsafe_assign_unsorted< object_t >;
+
       std::vector< basic_value< Traits > > stack_;
-      std::vector< std::string > keys_;
+      std::vector< typename object_t::key_type > keys_;
       basic_value< Traits > value;
 
+      // Members of open objects when object_t supports bulk construction.
+      std::vector< typename object_t::value_type > members_;
+      std::vector< std::size_t > offsets_;
+
       void null()
       {
          value.unsafe_assign_null();
@@ -101,6 +114,9 @@ namespace tao::json::events
       void begin_object( const std::size_t /*unused*/ = 0 )
       {
          stack_.emplace_back( empty_object );
+         if constexpr( bulk_objects ) {
+            offsets_.emplace_back( members_.size() );
+         }
       }
 
       void key( const std::string_view v )
@@ -120,16 +136,42 @@ namespace tao::json::events
 
       void member()
       {
-         stack_.back().unsafe_emplace( std::move( keys_.back() ), std::move( value ) );
+         if constexpr( bulk_objects ) {
+            members_.emplace_back( std::move( keys_.back() ), std::move( value ) );
+         }
+         else {
+            stack_.back().unsafe_emplace( std::move( keys_.back() ), std::move( value ) );
+         }
          value.discard();
          keys_.pop_back();
       }
 
       void end_object( const std::size_t /*unused*/ = 0 )
       {
+         if constexpr( bulk_objects ) {
+            auto& o = stack_.back().unsafe_get_object();
+            const auto b = members_.begin() + offsets_.back();
+            const auto it = o.unsafe_assign_unsorted( b, members_.end() );
+            members_.erase( b, members_.end() );
+            offsets_.pop_back();
+            if( it != o.end() ) {
+               throw std::runtime_error( internal::format( "duplicate JSON object key \"", internal::escape( it->first ), '"' ) );  // NOLINT
+            }
+         }
          value = std::move( stack_.back() );
          stack_.pop_back();
       }
+
+      // Prepares for the next Value; unlike a new instance this keeps the
+      // capacity of the internal buffers, also after an exception.
+      void reset() noexcept
+      {
+         stack_.clear();
+         keys_.clear();
+         members_.clear();
+         offsets_.clear();
+         value.reset();
+      }
    };
 
    using to_value = to_basic_value< traits >;
@@ -0,0 +1,47 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_EVENTS_TO_VIEW_VALUE_HPP
+#define TAO_JSON_EVENTS_TO_VIEW_VALUE_HPP
+
+#include <string_view>
+
+#include "../binary_view.hpp"
+#include "../value.hpp"
+
+#include "to_value.hpp"
+
+namespace tao::json::events
+{
+   // Events consumer to build a JSON Value that stores strings and binary
+   // data received as views as STRING_VIEW and BINARY_VIEW, i.e. without
+   // copying; strings received as std::string&& are stored as STRING.
+
+   // The JSON parser passes strings without escape sequences as views into
+   // the input, therefore, when parsing from a memory_input, mmap_input or
+   // the from_string() functions, the Value references the input buffer,
+   // which must outlive the Value. Keys are always copied.
+
+   template< template< typename... > class Traits >
+   struct to_basic_view_value
+      : to_basic_value< Traits >
+   {
+      using to_basic_value< Traits >::string;
+      using to_basic_value< Traits >::binary;
+
+      void string( const std::string_view v )
+      {
+         this->value.unsafe_assign_string_view( v );
+      }
+
+      void binary( const tao::binary_view v )
+      {
+         this->value.unsafe_assign_binary_view( v );
+      }
+   };
+
+   using to_view_value = to_basic_view_value< traits >;
+
+}  // namespace tao::json::events
+
+#endif
@@ -0,0 +1,337 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_INCREMENTAL_PARSER_HPP
+#define TAO_JSON_INCREMENTAL_PARSER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "external/pegtl/internal/iterator.hpp"
+#include "external/pegtl/parse_error.hpp"
+#include "external/pegtl/position.hpp"
+
+#include "internal/indexed_parser.hpp"
+#include "internal/scan_string.hpp"
+
+namespace tao::json
+{
+   // A push parser for JSON texts that arrive in chunks of arbitrary size,
+   // e.g. from a non-blocking socket. Every call to feed() processes the
+   // whole chunk and calls the Events Interface functions for everything
+   // that is complete, the state between chunks is an explicit stack of the
+   // open Arrays and Objects plus the string, number or literal that was cut
+   // off at the end of the chunk, only such partial tokens are copied. After
+   // the last chunk finish() throws when the JSON text is incomplete, and
+   // resets the parser for the next text otherwise. The parser accepts the
+   // same texts and calls the same functions as events::from_string(), the
+   // errors are reported as pegtl::parse_error with the position within the
+   // whole input; after an exception the parser must not be used again.
+
+   template< typename Consumer >
+   class incremental_parser
+   {
+   public:
+      explicit incremental_parser( Consumer& consumer, std::string source = "tao::json::incremental_parser" )
+         : m_consumer( consumer ),
+           m_source( std::move( source ) )
+      {}
+
+      void feed( const std::string_view chunk )
+      {
+         const char* p = chunk.data();
+         const char* const e = p + chunk.size();
+         m_chunk = p;
+         if( m_token != token::none ) {
+            p = resume( p, e );
+         }
+         while( p != e ) {
+            switch( *p ) {
+               case '\n':
+                  ++m_line;
+                  m_line_start = byte( p ) + 1;
+                  [[fallthrough]];
+               case ' ':
+               case '\t':
+               case '\r':
+                  ++p;
+                  break;
+               default:
+                  p = structure( p, e );
+            }
+         }
+         m_byte += chunk.size();
+      }
+
+      void finish()
+      {
+         m_chunk = nullptr;
+         switch( m_token ) {
+            case token::none:
+               break;
+            case token::scalar:
+               complete( m_buffer.data(), m_buffer.data() + m_buffer.size() );
+               break;
+            default:
+               error( "unterminated string", m_byte );
+         }
+         if( !m_stack.empty() || ( m_state != state::next ) ) {
+            error( "incomplete JSON text", m_byte );
+         }
+         m_byte = 0;
+         m_line = 1;
+         m_line_start = 0;
+         m_state = state::start_value;
+      }
+
+   private:
+      enum class state : char
+      {
+         start_value,
+         first_element,
+         first_key,
+         key,
+         colon,
+         next
+      };
+
+      enum class token : char
+      {
+         none,
+         string,
+         key,
+         scalar
+      };
+
+      Consumer& m_consumer;
+      std::string m_source;
+
+      std::size_t m_byte = 0;  // Of the beginning of the current chunk.
+      std::size_t m_line = 1;
+      std::size_t m_line_start = 0;
+      const char* m_chunk = nullptr;
+
+      state m_state = state::start_value;
+      std::vector< char > m_stack;
+
+      token m_token = token::none;
+      bool m_escape = false;  // Whether the partial string ends with an unfinished escape sequence.
+      std::string m_buffer;
+      std::size_t m_token_byte = 0;
+      std::size_t m_token_column = 0;
+
+      [[nodiscard]] std::size_t byte( const char* p ) const noexcept
+      {
+         return m_byte + std::size_t( p - m_chunk );
+      }
+
+      [[noreturn]] void error( const char* message, const std::size_t b ) const
+      {
+         throw pegtl::parse_error( message, pegtl::position( pegtl::internal::iterator( nullptr, b, m_line, b - m_line_start ), m_source ) );
+      }
+
+      [[noreturn]] void error( const char* message, const char* p ) const
+      {
+         error( message, byte( p ) );
+      }
+
+      [[nodiscard]] static bool is_delimiter( const char c ) noexcept
+      {
+         switch( c ) {
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+            case ',':
+            case ':':
+            case '[':
+            case ']':
+            case '{':
+            case '}':
+            case '"':
+               return true;
+            default:
+               return false;
+         }
+      }
+
+      // Returns the position of the closing quote, or e when the string
+      // continues in the next chunk.
+      [[nodiscard]] const char* string_end( const char* p, const char* const e ) noexcept
+      {
+         if( m_escape ) {
+            if( p == e ) {
+               return e;
+            }
+            m_escape = false;
+            ++p;
+         }
+         for( ;; ) {
+            p += internal::scan_string< '"' >( p, e - p );
+            if( p == e ) {
+               return e;
+            }
+            if( *p == '"' ) {
+               return p;
+            }
+            if( ( *p == '\\' ) && ( ++p == e ) ) {
+               m_escape = true;
+               return e;
+            }
+            do {
+               ++p;
+            } while( ( p != e ) && ( static_cast< unsigned char >( *p ) >= 0x80 ) );
+         }
+      }
+
+      // Returns the position after the end of the token that continues at p,
+      // or nullptr when it also continues in the next chunk.
+      [[nodiscard]] const char* token_end( const char* p, const char* const e ) noexcept
+      {
+         if( m_token == token::scalar ) {
+            while( ( p != e ) && !is_delimiter( *p ) ) {
+               ++p;
+            }
+            return ( p == e ) ? nullptr : p;
+         }
+         p = string_end( p, e );
+         return ( p == e ) ? nullptr : ( p + 1 );
+      }
+
+      [[nodiscard]] const char* begin_token( const token t, const char* p, const char* const e )
+      {
+         m_token = t;
+         m_escape = false;
+         m_token_byte = byte( p );
+         m_token_column = m_token_byte - m_line_start;
+         if( const char* q = token_end( ( t == token::scalar ) ? p : ( p + 1 ), e ) ) {
+            complete( p, q );
+            return q;
+         }
+         m_buffer.assign( p, e );
+         return e;
+      }
+
+      [[nodiscard]] const char* resume( const char* p, const char* const e )
+      {
+         if( const char* q = token_end( p, e ) ) {
+            m_buffer.append( p, q );
+            complete( m_buffer.data(), m_buffer.data() + m_buffer.size() );
+            return q;
+         }
+         m_buffer.append( p, e );
+         return e;
+      }
+
+      void complete( const char* b, const char* e )
+      {
+         internal::indexed_parser< Consumer > parser( m_consumer, b, e - b, m_source.c_str(), m_token_byte, m_line, m_token_column );
+         parser.token( m_token == token::key );
+         if( m_token == token::key ) {
+            m_state = state::colon;
+         }
+         else {
+            value_done();
+         }
+         m_token = token::none;
+      }
+
+      void value_done()
+      {
+         m_state = state::next;
+         if( !m_stack.empty() ) {
+            if( m_stack.back() == '[' ) {
+               m_consumer.element();
+            }
+            else {
+               m_consumer.member();
+            }
+         }
+      }
+
+      // Handles the character at p, which is not whitespace, and returns the
+      // position of the next character.
+      [[nodiscard]] const char* structure( const char* p, const char* const e )
+      {
+         switch( m_state ) {
+            case state::first_element:
+               if( *p == ']' ) {
+                  m_consumer.end_array();
+                  m_stack.pop_back();
+                  value_done();
+                  return p + 1;
+               }
+               [[fallthrough]];
+            case state::start_value:
+               switch( *p ) {
+                  case '[':
+                     m_consumer.begin_array();
+                     m_stack.push_back( '[' );
+                     m_state = state::first_element;
+                     return p + 1;
+                  case '{':
+                     m_consumer.begin_object();
+                     m_stack.push_back( '{' );
+                     m_state = state::first_key;
+                     return p + 1;
+                  case '"':
+                     return begin_token( token::string, p, e );
+                  case ']':
+                  case '}':
+                  case ',':
+                  case ':':
+                     error( "expected JSON value", p );
+                  default:
+                     return begin_token( token::scalar, p, e );
+               }
+            case state::first_key:
+               if( *p == '}' ) {
+                  m_consumer.end_object();
+                  m_stack.pop_back();
+                  value_done();
+                  return p + 1;
+               }
+               [[fallthrough]];
+            case state::key:
+               if( *p != '"' ) {
+                  error( "expected key", p );
+               }
+               return begin_token( token::key, p, e );
+            case state::colon:
+               if( *p != ':' ) {
+                  error( "expected ':'", p );
+               }
+               m_state = state::start_value;
+               return p + 1;
+            case state::next:
+               break;
+         }
+         if( m_stack.empty() ) {
+            error( "unexpected character after JSON value", p );
+         }
+         const bool array = ( m_stack.back() == '[' );
+         if( *p == ',' ) {
+            m_state = array ? state::start_value : state::key;
+            return p + 1;
+         }
+         if( array && ( *p == ']' ) ) {
+            m_consumer.end_array();
+         }
+         else if( !array && ( *p == '}' ) ) {
+            m_consumer.end_object();
+         }
+         else {
+            error( array ? "expected ',' or ']'" : "expected ',' or '}'", p );
+         }
+         m_stack.pop_back();
+         value_done();
+         return p + 1;
+      }
+   };
+
+}  // namespace tao::json
+
+#endif
@@ -5,12 +5,18 @@
 #define TAO_JSON_INTERNAL_ACTION_HPP
 
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
+#include "../external/pegtl/apply_mode.hpp"
+#include "../external/pegtl/match.hpp"
 #include "../external/pegtl/nothing.hpp"
+#include "../external/pegtl/rewind_mode.hpp"
 
 #include "grammar.hpp"
 #include "number_state.hpp"
+#include "type_traits.hpp"
 #include "unescape_action.hpp"
 
 namespace tao::json::internal
@@ -116,7 +122,12 @@ namespace tao::json::internal
       template< typename Consumer >
       static void apply0( Consumer& consumer )
       {
-         consumer.number( std::uint64_t( 0 ) );
+         if constexpr( has_number_raw< Consumer > ) {
+            consumer.number_raw( "0" );
+         }
+         else {
+            consumer.number( std::uint64_t( 0 ) );
+         }
       }
    };
 
@@ -126,7 +137,12 @@ namespace tao::json::internal
       template< typename Consumer >
       static void apply0( Consumer& consumer )
       {
-         consumer.number( std::int64_t( 0 ) );
+         if constexpr( has_number_raw< Consumer > ) {
+            consumer.number_raw( "-0" );
+         }
+         else {
+            consumer.number( std::int64_t( 0 ) );
+         }
       }
    };
 
@@ -156,17 +172,7 @@ namespace tao::json::internal
             throw pegtl::parse_error( "JSON number with 1 megabyte digits", in );  // NOLINT
          }
 
-         const auto c = ( std::min )( s, max_mantissa_digits );
-         std::memcpy( result.mantissa, in.begin(), c );
-         result.exponent10 += static_cast< typename number_state< NEG >::exponent10_t >( s - c );
-         result.msize = static_cast< typename number_state< NEG >::msize_t >( c );
-
-         for( std::size_t i = c; i < s; ++i ) {
-            if( in.peek_char( i ) != '0' ) {
-               result.drop = true;
-               return;
-            }
-         }
+         result.idigits( in.begin(), s );
       }
    };
 
@@ -176,31 +182,7 @@ namespace tao::json::internal
       template< typename Input, bool NEG >
       static void apply( const Input& in, number_state< NEG >& result )
       {
-         result.isfp = true;
-
-         const auto* b = in.begin();
-         const auto* e = in.end();
-
-         while( ( e > b ) && ( e[ -1 ] == '0' ) ) {
-            --e;
-         }
-         if( !result.msize ) {
-            while( ( b < e ) && ( b[ 0 ] == '0' ) ) {
-               ++b;
-               --result.exponent10;
-            }
-         }
-         const auto c = ( std::min )( std::size_t( e - b ), max_mantissa_digits - result.msize );
-         std::memcpy( result.mantissa + result.msize, b, c );
-         result.exponent10 -= static_cast< typename number_state< NEG >::exponent10_t >( c );
-         result.msize += static_cast< typename number_state< NEG >::msize_t >( c );
-
-         for( const auto* r = b + c; r < e; ++r ) {
-            if( *r != '0' ) {
-               result.drop = true;
-               return;
-            }
-         }
+         result.fdigits( in.begin(), in.end() );
       }
    };
 
@@ -210,8 +192,6 @@ namespace tao::json::internal
       template< typename Input, bool NEG >
       static void apply( const Input& in, number_state< NEG >& result )
       {
-         result.isfp = true;
-
          const char* b = in.begin();
 
          while( ( b < in.end() ) && ( b[ 0 ] == '0' ) ) {
@@ -220,20 +200,42 @@ namespace tao::json::internal
          if( ( in.end() - b ) > 9 ) {
             throw pegtl::parse_error( "JSON exponent has more than 9 significant digits", in );  // NOLINT
          }
-         int exponent10 = 0;
-
-         while( b < in.end() ) {
-            exponent10 = ( exponent10 * 10 ) + ( b[ 0 ] - '0' );
-            ++b;
-         }
-         result.exponent10 += ( result.eneg ? -exponent10 : exponent10 );
+         result.edigits( b, in.end() );
       }
    };
 
+   // A consumer with number_raw(), see has_number_raw, receives the text of
+   // the number, including a minus sign, which is checked by the grammar,
+   // but neither converted nor subject to the limits of the conversion.
+
    template< bool NEG >
    struct action< rules::number< NEG > >
       : pegtl::change_states< number_state< NEG > >
    {
+      template< typename Rule,
+                pegtl::apply_mode A,
+                pegtl::rewind_mode M,
+                template< typename... >
+                class Action,
+                template< typename... >
+                class Control,
+                typename Input,
+                typename... States >
+      [[nodiscard]] static bool match( Input& in, States&&... st )
+      {
+         if constexpr( ( A == pegtl::apply_mode::action ) && ( sizeof...( States ) == 1 ) && ( has_number_raw< std::decay_t< States > > && ... ) ) {
+            const char* b = in.current() - NEG;
+            if( pegtl::match< Rule, A, M, pegtl::nothing, Control >( in ) ) {
+               ( st.number_raw( std::string_view( b, in.current() - b ) ), ... );
+               return true;
+            }
+            return false;
+         }
+         else {
+            return pegtl::change_states< number_state< NEG > >::template match< Rule, A, M, Action, Control >( in, st... );
+         }
+      }
+
       template< typename Input, typename Consumer >
       static void success( const Input& /*unused*/, number_state< NEG >& state, Consumer& consumer )
       {
@@ -241,25 +243,28 @@ namespace tao::json::internal
       }
    };
 
+   // Strings and keys without escape sequences are passed to the consumer
+   // as std::string_view into the input, all others as std::string&&.
+
    template<>
    struct action< rules::string::content >
-      : pegtl::change_action_and_states< unescape_action, std::string >
+      : pegtl::change_action_and_states< unescape_view_action, string_state >
    {
       template< typename Input, typename Consumer >
-      static void success( const Input& /*unused*/, std::string& unescaped, Consumer& consumer )
+      static void success( const Input& /*unused*/, string_state& state, Consumer& consumer )
       {
-         consumer.string( std::move( unescaped ) );
+         state.string( consumer );
       }
    };
 
    template<>
    struct action< rules::key::content >
-      : pegtl::change_action_and_states< unescape_action, std::string >
+      : pegtl::change_action_and_states< unescape_view_action, string_state >
    {
       template< typename Input, typename Consumer >
-      static void success( const Input& /*unused*/, std::string& unescaped, Consumer& consumer )
+      static void success( const Input& /*unused*/, string_state& state, Consumer& consumer )
       {
-         consumer.key( std::move( unescaped ) );
+         state.key( consumer );
       }
    };
 
@@ -0,0 +1,388 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_INTERNAL_FIRST_SOR_HPP
+#define TAO_JSON_INTERNAL_FIRST_SOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "../external/pegtl.hpp"
+
+namespace tao::json::internal
+{
+   // The set of bytes that a rule can start with, and whether the rule can
+   // succeed, or raise an exception, without consuming any input. Since it
+   // is only used to skip alternatives it is allowed to contain too much.
+
+   struct first_set
+   {
+      std::uint64_t bits[ 4 ] = {};
+      bool nullable = false;
+
+      constexpr void set( const unsigned char c ) noexcept
+      {
+         bits[ c >> 6 ] |= std::uint64_t( 1 ) << ( c & 63 );
+      }
+
+      constexpr void set( const unsigned lo, const unsigned hi ) noexcept
+      {
+         for( unsigned c = lo; ( c <= hi ) && ( c < 256 ); ++c ) {
+            set( static_cast< unsigned char >( c ) );
+         }
+      }
+
+      [[nodiscard]] constexpr bool test( const unsigned char c ) const noexcept
+      {
+         return ( bits[ c >> 6 ] >> ( c & 63 ) ) & 1;
+      }
+
+      [[nodiscard]] constexpr bool all() const noexcept
+      {
+         return nullable && ( ( bits[ 0 ] & bits[ 1 ] & bits[ 2 ] & bits[ 3 ] ) == ~std::uint64_t( 0 ) );
+      }
+
+      constexpr first_set& operator|=( const first_set& r ) noexcept
+      {
+         for( std::size_t i = 0; i < 4; ++i ) {
+            bits[ i ] |= r.bits[ i ];
+         }
+         nullable = nullable || r.nullable;
+         return *this;
+      }
+   };
+
+   [[nodiscard]] constexpr first_set first_all() noexcept
+   {
+      first_set r;
+      r.set( 0, 255 );
+      r.nullable = true;
+      return r;
+   }
+
+   [[nodiscard]] constexpr first_set first_nullable() noexcept
+   {
+      first_set r;
+      r.nullable = true;
+      return r;
+   }
+
+   // The set for a rule is found by overload resolution on a pointer to the
+   // rule, which also finds the overloads for the PEGTL rule a grammar rule
+   // is derived from. Custom rules, which PEGTL's analysis also only knows
+   // by what they claim in their analyze_t, get the fallback overload that
+   // allows everything, as do rules that can raise a global error.
+
+   template< typename Rule >
+   [[nodiscard]] constexpr first_set first_of() noexcept;
+
+   template< typename... Rules >
+   struct first_sor;
+
+   [[nodiscard]] constexpr first_set first_rule( const void* /*unused*/ ) noexcept
+   {
+      return first_all();
+   }
+
+   template< typename Rule, typename... Rules >
+   [[nodiscard]] constexpr first_set first_seq() noexcept
+   {
+      first_set r = first_of< Rule >();
+      if constexpr( sizeof...( Rules ) > 0 ) {
+         if( r.nullable && !r.all() ) {
+            r.nullable = false;
+            r |= first_seq< Rules... >();
+         }
+      }
+      return r;
+   }
+
+   template< typename... Rules >
+   [[nodiscard]] constexpr first_set first_alternatives() noexcept
+   {
+      first_set r;
+      ( r |= ... |= first_of< Rules >() );
+      return r;
+   }
+
+   template< typename Peek, typename T >
+   [[nodiscard]] constexpr first_set first_chars( const bool negate, const T lo, const T hi ) noexcept
+   {
+      first_set r;
+      if constexpr( std::is_same_v< Peek, pegtl::internal::peek_char > || std::is_same_v< Peek, pegtl::internal::peek_utf8 > ) {
+         const auto l = static_cast< std::uint32_t >( lo );
+         const auto h = static_cast< std::uint32_t >( hi );
+         if( negate ) {
+            r.set( 0, 255 );
+         }
+         else if( std::is_same_v< Peek, pegtl::internal::peek_char > ) {
+            r.set( static_cast< unsigned char >( l ), static_cast< unsigned char >( h ) );
+         }
+         else {
+            r.set( l, ( h < 0x80 ) ? h : 0x7f );
+            if( h >= 0x80 ) {
+               r.set( 0xc0, 0xff );  // Code points from 0x80 start with a lead byte.
+            }
+         }
+      }
+      else {
+         r.set( 0, 255 );
+      }
+      return r;
+   }
+
+   template< typename Peek, typename Peek::data_t... Cs >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::one< pegtl::internal::result_on_found::success, Peek, Cs... >* /*unused*/ ) noexcept
+   {
+      first_set r;
+      ( r |= ... |= first_chars< Peek >( false, Cs, Cs ) );
+      return r;
+   }
+
+   template< typename Peek, typename Peek::data_t... Cs >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::one< pegtl::internal::result_on_found::failure, Peek, Cs... >* /*unused*/ ) noexcept
+   {
+      return first_chars< Peek >( true, 0, 0 );
+   }
+
+   template< pegtl::internal::result_on_found R, typename Peek, typename Peek::data_t Lo, typename Peek::data_t Hi >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::range< R, Peek, Lo, Hi >* /*unused*/ ) noexcept
+   {
+      return first_chars< Peek >( R == pegtl::internal::result_on_found::failure, Lo, Hi );
+   }
+
+   template< typename Peek, typename T >
+   [[nodiscard]] constexpr first_set first_ranges( const T* cs, const std::size_t n ) noexcept
+   {
+      first_set r;
+      for( std::size_t i = 0; i < n; i += 2 ) {
+         r |= first_chars< Peek >( false, cs[ i ], cs[ ( i + 1 < n ) ? ( i + 1 ) : i ] );
+      }
+      return r;
+   }
+
+   template< typename Peek, typename Peek::data_t... Cs >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::ranges< Peek, Cs... >* /*unused*/ ) noexcept
+   {
+      constexpr typename Peek::data_t cs[] = { Cs... };
+      return first_ranges< Peek >( cs, sizeof...( Cs ) );
+   }
+
+   template< char C, char... Cs >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::string< C, Cs... >* /*unused*/ ) noexcept
+   {
+      first_set r;
+      r.set( static_cast< unsigned char >( C ) );
+      return r;
+   }
+
+   template< char C, char... Cs >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::istring< C, Cs... >* /*unused*/ ) noexcept
+   {
+      first_set r;
+      r.set( static_cast< unsigned char >( C ) );
+      if( ( 'a' <= C ) && ( C <= 'z' ) ) {
+         r.set( static_cast< unsigned char >( C - 'a' + 'A' ) );
+      }
+      if( ( 'A' <= C ) && ( C <= 'Z' ) ) {
+         r.set( static_cast< unsigned char >( C - 'A' + 'a' ) );
+      }
+      return r;
+   }
+
+   template< typename Peek >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::any< Peek >* /*unused*/ ) noexcept
+   {
+      first_set r;
+      r.set( 0, 255 );
+      return r;
+   }
+
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::eol* /*unused*/ ) noexcept
+   {
+      first_set r;
+      r.set( '\n' );
+      r.set( '\r' );
+      return r;
+   }
+
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::eolf* /*unused*/ ) noexcept
+   {
+      first_set r;
+      r.set( '\n' );
+      r.set( '\r' );
+      r.nullable = true;
+      return r;
+   }
+
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::eof* /*unused*/ ) noexcept
+   {
+      return first_nullable();
+   }
+
+   template< typename... Rules >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::at< Rules... >* /*unused*/ ) noexcept
+   {
+      return first_nullable();
+   }
+
+   template< typename... Rules >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::not_at< Rules... >* /*unused*/ ) noexcept
+   {
+      return first_nullable();
+   }
+
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::seq<>* /*unused*/ ) noexcept
+   {
+      return first_nullable();
+   }
+
+   template< typename... Rules >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::seq< Rules... >* /*unused*/ ) noexcept
+   {
+      return first_seq< Rules... >();
+   }
+
+   template< typename... Rules >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::sor< Rules... >* /*unused*/ ) noexcept
+   {
+      return first_alternatives< Rules... >();
+   }
+
+   template< typename... Rules >
+   [[nodiscard]] constexpr first_set first_rule( const first_sor< Rules... >* /*unused*/ ) noexcept
+   {
+      return first_alternatives< Rules... >();
+   }
+
+   template< typename... Rules >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::opt< Rules... >* /*unused*/ ) noexcept
+   {
+      first_set r = first_rule( static_cast< const pegtl::internal::seq< Rules... >* >( nullptr ) );
+      r.nullable = true;
+      return r;
+   }
+
+   template< typename Rule, typename... Rules >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::star< Rule, Rules... >* /*unused*/ ) noexcept
+   {
+      first_set r = first_seq< Rule, Rules... >();
+      r.nullable = true;
+      return r;
+   }
+
+   template< typename Rule, typename... Rules >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::plus< Rule, Rules... >* /*unused*/ ) noexcept
+   {
+      return first_seq< Rule, Rules... >();
+   }
+
+   template< unsigned Num, typename... Rules >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::rep< Num, Rules... >* /*unused*/ ) noexcept
+   {
+      if constexpr( ( Num == 0 ) || ( sizeof...( Rules ) == 0 ) ) {
+         return first_nullable();
+      }
+      else {
+         return first_seq< Rules... >();
+      }
+   }
+
+   template< bool Default, typename Cond, typename... Rules >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::if_must< Default, Cond, Rules... >* /*unused*/ ) noexcept
+   {
+      first_set r = first_of< Cond >();
+      if( r.nullable ) {
+         return first_all();
+      }
+      r.nullable = Default;
+      return r;
+   }
+
+   template< typename Cond, typename Then, typename Else >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::if_then_else< Cond, Then, Else >* /*unused*/ ) noexcept
+   {
+      first_set r = first_seq< Cond, Then >();
+      r |= first_of< Else >();
+      return r;
+   }
+
+   template< typename Cond, typename Rule, typename... Rules >
+   [[nodiscard]] constexpr first_set first_rule( const pegtl::internal::until< Cond, Rule, Rules... >* /*unused*/ ) noexcept
+   {
+      first_set r = first_of< Cond >();
+      r |= first_seq< Rule, Rules... >();
+      return r;
+   }
+
+   template< typename Rule >
+   [[nodiscard]] constexpr first_set first_of() noexcept
+   {
+      return first_rule( static_cast< const Rule* >( nullptr ) );
+   }
+
+   // Like pegtl::sor, but with a table, computed at compile time, of which
+   // alternatives can match for each possible first byte of the input, and
+   // for the end of the input, so that only those are tried, in order.
+
+   template< typename... Rules >
+   struct first_sor
+   {
+      static_assert( ( sizeof...( Rules ) > 0 ) && ( sizeof...( Rules ) <= 64 ) );
+
+      using analyze_t = pegtl::analysis::generic< pegtl::analysis::rule_type::sor, Rules... >;
+
+      [[nodiscard]] static constexpr std::array< std::uint64_t, 257 > make_table() noexcept
+      {
+         const first_set sets[] = { first_of< Rules >()... };
+         std::array< std::uint64_t, 257 > r{};
+         for( std::size_t i = 0; i < sizeof...( Rules ); ++i ) {
+            for( std::size_t c = 0; c < 256; ++c ) {
+               if( sets[ i ].nullable || sets[ i ].test( static_cast< unsigned char >( c ) ) ) {
+                  r[ c ] |= std::uint64_t( 1 ) << i;
+               }
+            }
+            if( sets[ i ].nullable ) {
+               r[ 256 ] |= std::uint64_t( 1 ) << i;
+            }
+         }
+         return r;
+      }
+
+      static constexpr std::array< std::uint64_t, 257 > table = make_table();
+
+      template< pegtl::apply_mode A,
+                pegtl::rewind_mode M,
+                template< typename... >
+                class Action,
+                template< typename... >
+                class Control,
+                std::size_t... Is,
+                typename Input,
+                typename... States >
+      [[nodiscard]] static bool match( std::index_sequence< Is... > /*unused*/, const std::uint64_t mask, Input& in, States&&... st )
+      {
+         return ( ( ( ( mask >> Is ) & 1 ) && Control< Rules >::template match< A, ( ( Is == ( sizeof...( Rules ) - 1 ) ) ? M : pegtl::rewind_mode::required ), Action, Control >( in, st... ) ) || ... );
+      }
+
+      template< pegtl::apply_mode A,
+                pegtl::rewind_mode M,
+                template< typename... >
+                class Action,
+                template< typename... >
+                class Control,
+                typename Input,
+                typename... States >
+      [[nodiscard]] static bool match( Input& in, States&&... st )
+      {
+         const std::uint64_t mask = table[ in.size( 1 ) ? std::size_t( in.peek_uint8() ) : 256 ];
+         return match< A, M, Action, Control >( std::index_sequence_for< Rules... >(), mask, in, st... );
+      }
+   };
+
+}  // namespace tao::json::internal
+
+#endif
@@ -18,8 +18,8 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::NULL_ >
    {
-      template< typename T >
-      [[nodiscard]] static null_t get( const value_union< T >& /*unused*/ ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static null_t get( const value_union< T, O, A >& /*unused*/ ) noexcept
       {
          return null;
       }
@@ -28,8 +28,8 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::BOOLEAN >
    {
-      template< typename T >
-      [[nodiscard]] static bool get( const value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static bool get( const value_union< T, O, A >& u ) noexcept
       {
          return u.b;
       }
@@ -38,8 +38,8 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::SIGNED >
    {
-      template< typename T >
-      [[nodiscard]] static std::int64_t get( const value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static std::int64_t get( const value_union< T, O, A >& u ) noexcept
       {
          return u.i;
       }
@@ -48,8 +48,8 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::UNSIGNED >
    {
-      template< typename T >
-      [[nodiscard]] static std::uint64_t get( const value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static std::uint64_t get( const value_union< T, O, A >& u ) noexcept
       {
          return u.u;
       }
@@ -58,8 +58,8 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::DOUBLE >
    {
-      template< typename T >
-      [[nodiscard]] static double get( const value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static double get( const value_union< T, O, A >& u ) noexcept
       {
          return u.d;
       }
@@ -68,14 +68,14 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::STRING >
    {
-      template< typename T >
-      [[nodiscard]] static std::string& get( value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static std::string& get( value_union< T, O, A >& u ) noexcept
       {
          return u.s;
       }
 
-      template< typename T >
-      [[nodiscard]] static const std::string& get( const value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static const std::string& get( const value_union< T, O, A >& u ) noexcept
       {
          return u.s;
       }
@@ -84,8 +84,8 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::STRING_VIEW >
    {
-      template< typename T >
-      [[nodiscard]] static std::string_view get( const value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static std::string_view get( const value_union< T, O, A >& u ) noexcept
       {
          return u.sv;
       }
@@ -94,14 +94,14 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::BINARY >
    {
-      template< typename T >
-      [[nodiscard]] static std::vector< std::byte >& get( value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static std::vector< std::byte >& get( value_union< T, O, A >& u ) noexcept
       {
          return u.x;
       }
 
-      template< typename T >
-      [[nodiscard]] static const std::vector< std::byte >& get( const value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static const std::vector< std::byte >& get( const value_union< T, O, A >& u ) noexcept
       {
          return u.x;
       }
@@ -110,8 +110,8 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::BINARY_VIEW >
    {
-      template< typename T >
-      [[nodiscard]] static tao::binary_view get( const value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static tao::binary_view get( const value_union< T, O, A >& u ) noexcept
       {
          return u.xv;
       }
@@ -120,14 +120,14 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::ARRAY >
    {
-      template< typename T >
-      [[nodiscard]] static std::vector< T >& get( value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static A& get( value_union< T, O, A >& u ) noexcept
       {
          return u.a;
       }
 
-      template< typename T >
-      [[nodiscard]] static const std::vector< T >& get( const value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static const A& get( const value_union< T, O, A >& u ) noexcept
       {
          return u.a;
       }
@@ -136,14 +136,14 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::OBJECT >
    {
-      template< typename T >
-      [[nodiscard]] static std::map< std::string, T >& get( value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static O& get( value_union< T, O, A >& u ) noexcept
       {
          return u.o;
       }
 
-      template< typename T >
-      [[nodiscard]] static const std::map< std::string, T >& get( const value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static const O& get( const value_union< T, O, A >& u ) noexcept
       {
          return u.o;
       }
@@ -152,8 +152,8 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::VALUE_PTR >
    {
-      template< typename T >
-      [[nodiscard]] static const T* get( const value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static const T* get( const value_union< T, O, A >& u ) noexcept
       {
          return u.p;
       }
@@ -162,8 +162,8 @@ namespace tao::json::internal
    template<>
    struct get_by_enum< type::OPAQUE_PTR >
    {
-      template< typename T >
-      [[nodiscard]] static internal::opaque_ptr_t get( const value_union< T >& u ) noexcept
+      template< typename T, typename O, typename A >
+      [[nodiscard]] static internal::opaque_ptr_t get( const value_union< T, O, A >& u ) noexcept
       {
          return u.q;
       }
@@ -7,6 +7,9 @@
 #include "../external/pegtl.hpp"
 #include "../external/pegtl/contrib/abnf.hpp"
 
+#include "first_sor.hpp"
+#include "scan_string.hpp"
+
 namespace tao::json::internal
 {
    // clang-format off
@@ -49,7 +52,7 @@ namespace tao::json::internal
       struct escaped_unicode : list< seq< one< 'u' >, rep< 4, must< xdigit > > >, one< '\\' > > {};
 
       struct escaped_char : one< '"', '\\', '/', 'b', 'f', 'n', 'r', 't' > {};
-      struct escaped : sor< escaped_char, escaped_unicode > {};
+      struct escaped : first_sor< escaped_char, escaped_unicode > {};
 
       struct unescaped
       {
@@ -61,6 +64,11 @@ namespace tao::json::internal
             bool result = false;
 
             while( const std::size_t s = in.size( 4 ) ) {
+               if( const std::size_t n = tao::json::internal::scan_string< '"' >( in.current(), s ) ) {
+                  in.bump_in_this_line( n );
+                  result = true;
+                  continue;
+               }
                if( const auto t = pegtl::internal::peek_utf8::peek( in, s ) ) {
                   if( ( 0x20 <= t.data ) && ( t.data != '\\' ) && ( t.data != '"' ) ) {
                      in.bump_in_this_line( t.size );
@@ -0,0 +1,464 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_INTERNAL_INDEXED_PARSER_HPP
+#define TAO_JSON_INTERNAL_INDEXED_PARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../external/pegtl/contrib/unescape.hpp"
+#include "../external/pegtl/memory_input.hpp"
+#include "../external/pegtl/parse_error.hpp"
+
+#include "number_state.hpp"
+#include "scan_string.hpp"
+#include "structural_index.hpp"
+#include "type_traits.hpp"
+
+namespace tao::json::internal
+{
+   // The second stage of the indexed parser walks the token positions found
+   // by the structural_indexer and calls the same Events Interface functions
+   // as the grammar with internal::action, strings without escape sequences
+   // are also passed as std::string_view. It accepts exactly the same JSON
+   // texts, the checks that the first stage leaves out are done here, with
+   // a stack instead of recursion for nested values. Errors are reported as
+   // pegtl::parse_error with the position of the offending character.
+
+   template< typename Consumer >
+   class indexed_parser
+   {
+   public:
+      indexed_parser( Consumer& consumer, const char* data, const std::size_t size, const char* source, const std::size_t byte, const std::size_t line, const std::size_t column )
+         : m_consumer( consumer ),
+           m_data( data ),
+           m_end( data + size ),
+           m_source( source ),
+           m_byte( byte ),
+           m_line( line ),
+           m_column( column )
+      {}
+
+      void parse( std::vector< std::uint32_t >& indices )
+      {
+         if( !structural_indexer()( m_data, m_end - m_data, indices ) ) {
+            error( "unterminated string", m_end );
+         }
+         m_next = indices.data();
+         m_last = indices.data() + indices.size();
+         advance();
+
+         std::vector< char > stack;
+         do {
+            while( begin_value( stack ) ) {
+            }
+         } while( end_value( stack ) );
+
+         if( m_pos != m_end ) {
+            error( "unexpected character after JSON value", m_pos );
+         }
+      }
+
+      // Parses the single complete string, literal or number that spans the
+      // whole input, this is how the incremental_parser hands over tokens.
+      void token( const bool key )
+      {
+         m_pos = m_data;
+         if( key ) {
+            string< true >();
+         }
+         else {
+            std::vector< char > stack;
+            (void)begin_value( stack );
+         }
+      }
+
+   private:
+      Consumer& m_consumer;
+      const char* m_data;
+      const char* m_end;
+      const char* m_source;
+      std::size_t m_byte;
+      std::size_t m_line;
+      std::size_t m_column;
+
+      const std::uint32_t* m_next = nullptr;
+      const std::uint32_t* m_last = nullptr;
+      const char* m_pos = nullptr;  // The current token, or m_end.
+
+      [[noreturn]] void error( const char* message, const char* at ) const
+      {
+         pegtl::memory_input< pegtl::tracking_mode::lazy, pegtl::eol::lf_crlf, const char* > in( m_data, m_end, m_source, m_byte, m_line, m_column );
+         in.bump( at - m_data );
+         throw pegtl::parse_error( message, in );
+      }
+
+      void advance() noexcept
+      {
+         m_pos = ( m_next == m_last ) ? m_end : ( m_data + *m_next++ );
+      }
+
+      [[nodiscard]] char current() const noexcept
+      {
+         return ( m_pos == m_end ) ? '\0' : *m_pos;
+      }
+
+      [[nodiscard]] static bool is_digit( const char c ) noexcept
+      {
+         return ( '0' <= c ) && ( c <= '9' );
+      }
+
+      // Checks that the literal or number that ended at p is not followed
+      // by more characters that the first stage counted to the same token.
+      void check_end( const char* p ) const
+      {
+         if( p != m_end ) {
+            switch( *p ) {
+               case ' ':
+               case '\t':
+               case '\n':
+               case '\r':
+               case ',':
+               case ':':
+               case '[':
+               case ']':
+               case '{':
+               case '}':
+               case '"':
+                  break;
+               default:
+                  error( "invalid character after JSON value", p );
+            }
+         }
+      }
+
+      void literal( const std::string_view l ) const
+      {
+         if( ( std::size_t( m_end - m_pos ) < l.size() ) || ( std::memcmp( m_pos, l.data(), l.size() ) != 0 ) ) {
+            error( "expected JSON value", m_pos );
+         }
+         check_end( m_pos + l.size() );
+      }
+
+      template< bool NEG >
+      void number( const char* b )
+      {
+         const char* p = b;
+         if( ( p == m_end ) || !is_digit( *p ) ) {
+            error( "incomplete number", p );
+         }
+         if( *p == '0' ) {
+            ++p;
+            if( ( p != m_end ) && is_digit( *p ) ) {
+               error( "invalid leading zero", p );
+            }
+            if( ( p == m_end ) || ( ( *p != '.' ) && ( *p != 'e' ) && ( *p != 'E' ) ) ) {
+               check_end( p );
+               if constexpr( has_number_raw< Consumer > ) {
+                  m_consumer.number_raw( std::string_view( b - NEG, 1 + NEG ) );
+               }
+               else if constexpr( NEG ) {
+                  m_consumer.number( std::int64_t( 0 ) );
+               }
+               else {
+                  m_consumer.number( std::uint64_t( 0 ) );
+               }
+               return;
+            }
+         }
+         while( ( p != m_end ) && is_digit( *p ) ) {
+            ++p;
+         }
+         constexpr bool raw = has_number_raw< Consumer >;
+         number_state< NEG > state;
+         if( !raw && ( ( p - b > 1 ) || ( *b != '0' ) ) ) {
+            if( p - b > ( 1 << 20 ) ) {
+               error( "JSON number with 1 megabyte digits", b );
+            }
+            state.idigits( b, p - b );
+         }
+         if( ( p != m_end ) && ( *p == '.' ) ) {
+            const char* f = ++p;
+            while( ( p != m_end ) && is_digit( *p ) ) {
+               ++p;
+            }
+            if( p == f ) {
+               error( "expected fraction digits", p );
+            }
+            if constexpr( !raw ) {
+               state.fdigits( f, p );
+            }
+         }
+         if( ( p != m_end ) && ( ( *p == 'e' ) || ( *p == 'E' ) ) ) {
+            ++p;
+            if( ( p != m_end ) && ( ( *p == '+' ) || ( *p == '-' ) ) ) {
+               state.eneg = ( *p++ == '-' );
+            }
+            const char* e = p;
+            while( ( p != m_end ) && is_digit( *p ) ) {
+               ++p;
+            }
+            if( p == e ) {
+               error( "expected exponent digits", p );
+            }
+            if constexpr( !raw ) {
+               while( ( e < p ) && ( *e == '0' ) ) {
+                  ++e;
+               }
+               if( p - e > 9 ) {
+                  error( "JSON exponent has more than 9 significant digits", e );
+               }
+               state.edigits( e, p );
+            }
+         }
+         check_end( p );
+         if constexpr( raw ) {
+            m_consumer.number_raw( std::string_view( b - NEG, p - b + NEG ) );
+         }
+         else {
+            state.success( m_consumer );
+         }
+      }
+
+      // Appends the escape sequence at p to s and returns the position after it.
+      [[nodiscard]] const char* unescape( const char* p, std::string& s ) const
+      {
+         const auto hex4 = [ & ]( const char* h ) {
+            if( m_end - h < 4 ) {
+               return -1L;
+            }
+            long r = 0;
+            for( int i = 0; i < 4; ++i ) {
+               const char c = h[ i ];
+               r <<= 4;
+               if( is_digit( c ) ) {
+                  r += c - '0';
+               }
+               else if( ( 'a' <= c ) && ( c <= 'f' ) ) {
+                  r += c - 'a' + 10;
+               }
+               else if( ( 'A' <= c ) && ( c <= 'F' ) ) {
+                  r += c - 'A' + 10;
+               }
+               else {
+                  return -1L;
+               }
+            }
+            return r;
+         };
+         switch( p[ 1 ] ) {
+            case '"':
+            case '\\':
+            case '/':
+               s += p[ 1 ];
+               return p + 2;
+            case 'b':
+               s += '\b';
+               return p + 2;
+            case 'f':
+               s += '\f';
+               return p + 2;
+            case 'n':
+               s += '\n';
+               return p + 2;
+            case 'r':
+               s += '\r';
+               return p + 2;
+            case 't':
+               s += '\t';
+               return p + 2;
+            case 'u': {
+               const long c = hex4( p + 2 );
+               if( c < 0 ) {
+                  error( "invalid escaped unicode code point", p );
+               }
+               if( ( 0xd800 <= c ) && ( c <= 0xdbff ) && ( m_end - p >= 12 ) && ( p[ 6 ] == '\\' ) && ( p[ 7 ] == 'u' ) ) {
+                  const long d = hex4( p + 8 );
+                  if( ( 0xdc00 <= d ) && ( d <= 0xdfff ) ) {
+                     (void)pegtl::unescape::utf8_append_utf32( s, unsigned( ( ( ( c & 0x03ff ) << 10 ) | ( d & 0x03ff ) ) + 0x10000 ) );
+                     return p + 12;
+                  }
+               }
+               if( !pegtl::unescape::utf8_append_utf32( s, unsigned( c ) ) ) {
+                  error( "invalid escaped unicode code point", p );
+               }
+               return p + 6;
+            }
+            default:
+               error( "invalid escape sequence", p );
+         }
+      }
+
+      template< bool KEY >
+      void string()
+      {
+         const char* b = m_pos + 1;
+         const char* p = b;
+         std::string unescaped;
+         bool escaped = false;
+         for( ;; ) {
+            p += scan_string< '"' >( p, m_end - p );
+            if( p == m_end ) {
+               error( "unterminated string", p );
+            }
+            const auto c = static_cast< unsigned char >( *p );
+            if( c == '"' ) {
+               break;
+            }
+            if( c == '\\' ) {
+               unescaped.append( b, p );
+               escaped = true;
+               b = p = unescape( p, unescaped );
+               continue;
+            }
+            if( c < 0x20 ) {
+               error( "invalid character in string", p );
+            }
+            const std::size_t n = utf8_sequence( p, m_end - p );
+            if( n == 0 ) {
+               error( "invalid UTF-8 character in string", p );
+            }
+            p += n;
+         }
+         if( escaped ) {
+            unescaped.append( b, p );
+            if constexpr( KEY ) {
+               m_consumer.key( std::move( unescaped ) );
+            }
+            else {
+               m_consumer.string( std::move( unescaped ) );
+            }
+         }
+         else {
+            if constexpr( KEY ) {
+               m_consumer.key( std::string_view( b, p - b ) );
+            }
+            else {
+               m_consumer.string( std::string_view( b, p - b ) );
+            }
+         }
+      }
+
+      // Parses the key at the current token and the following name separator.
+      void key()
+      {
+         if( current() != '"' ) {
+            error( "expected key", m_pos );
+         }
+         string< true >();
+         advance();
+         if( current() != ':' ) {
+            error( "expected ':'", m_pos );
+         }
+         advance();
+      }
+
+      // Parses the value that starts at the current token; returns true when
+      // it opened a non-empty Array or Object and the current token is now
+      // the first element or the value of the first member.
+      [[nodiscard]] bool begin_value( std::vector< char >& stack )
+      {
+         switch( current() ) {
+            case '[':
+               m_consumer.begin_array();
+               advance();
+               if( current() == ']' ) {
+                  m_consumer.end_array();
+                  return false;
+               }
+               stack.push_back( '[' );
+               return true;
+            case '{':
+               m_consumer.begin_object();
+               advance();
+               if( current() == '}' ) {
+                  m_consumer.end_object();
+                  return false;
+               }
+               stack.push_back( '{' );
+               key();
+               return true;
+            case '"':
+               string< false >();
+               return false;
+            case 'n':
+               literal( "null" );
+               m_consumer.null();
+               return false;
+            case 't':
+               literal( "true" );
+               m_consumer.boolean( true );
+               return false;
+            case 'f':
+               literal( "false" );
+               m_consumer.boolean( false );
+               return false;
+            case '-':
+               number< true >( m_pos + 1 );
+               return false;
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+               number< false >( m_pos );
+               return false;
+            default:
+               error( "expected JSON value", m_pos );
+         }
+      }
+
+      // Finishes the Arrays and Objects that end after the value that was
+      // just parsed; returns true when the current token is now the next
+      // element or the value of the next member, or false at the top level.
+      [[nodiscard]] bool end_value( std::vector< char >& stack )
+      {
+         for( ;; ) {
+            advance();
+            if( stack.empty() ) {
+               return false;
+            }
+            if( stack.back() == '[' ) {
+               m_consumer.element();
+               switch( current() ) {
+                  case ',':
+                     advance();
+                     return true;
+                  case ']':
+                     m_consumer.end_array();
+                     stack.pop_back();
+                     continue;
+                  default:
+                     error( "expected ',' or ']'", m_pos );
+               }
+            }
+            m_consumer.member();
+            switch( current() ) {
+               case ',':
+                  advance();
+                  key();
+                  return true;
+               case '}':
+                  m_consumer.end_object();
+                  stack.pop_back();
+                  continue;
+               default:
+                  error( "expected ',' or '}'", m_pos );
+            }
+         }
+      }
+   };
+
+}  // namespace tao::json::internal
+
+#endif
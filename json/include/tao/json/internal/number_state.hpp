@@ -4,17 +4,24 @@
 #ifndef TAO_JSON_INTERNAL_NUMBER_STATE_HPP
 #define TAO_JSON_INTERNAL_NUMBER_STATE_HPP
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
-#include <cstdlib>
+#include <cstring>
 #include <stdexcept>
 
 #include "../external/double.hpp"
 
+#include "eisel_lemire.hpp"
+
 namespace tao::json::internal
 {
    static const std::size_t max_mantissa_digits = 772;
 
+   // The number of decimal digits that always fit into a std::uint64_t.
+   static const std::size_t max_fast_digits = 19;
+
    template< bool NEG >
    struct number_state  // NOLINT
    {
@@ -36,17 +43,86 @@ namespace tao::json::internal
       bool isfp = false;
       bool eneg = false;
       bool drop = false;
+      std::uint64_t digits = 0;  // Value of the first max_fast_digits digits of the mantissa.
       char mantissa[ max_mantissa_digits + 1 ];
 
+      // Appends c digits to the mantissa, the caller ensures they fit.
+      void append( const char* b, const std::size_t c ) noexcept
+      {
+         std::memcpy( mantissa + msize, b, c );
+         const std::size_t n = ( msize < max_fast_digits ) ? ( std::min )( c, max_fast_digits - msize ) : 0;
+         for( std::size_t i = 0; i < n; ++i ) {
+            digits = digits * 10 + std::uint64_t( b[ i ] - '0' );
+         }
+         msize += static_cast< msize_t >( c );
+      }
+
+      // The digits before the decimal point, except for a single zero.
+      void idigits( const char* b, const std::size_t s ) noexcept
+      {
+         const auto c = ( std::min )( s, max_mantissa_digits );
+         append( b, c );
+         exponent10 += static_cast< exponent10_t >( s - c );
+
+         for( std::size_t i = c; i < s; ++i ) {
+            if( b[ i ] != '0' ) {
+               drop = true;
+               return;
+            }
+         }
+      }
+
+      // The digits after the decimal point.
+      void fdigits( const char* b, const char* e ) noexcept
+      {
+         isfp = true;
+
+         while( ( e > b ) && ( e[ -1 ] == '0' ) ) {
+            --e;
+         }
+         if( !msize ) {
+            while( ( b < e ) && ( b[ 0 ] == '0' ) ) {
+               ++b;
+               --exponent10;
+            }
+         }
+         const auto c = ( std::min )( std::size_t( e - b ), max_mantissa_digits - msize );
+         append( b, c );
+         exponent10 -= static_cast< exponent10_t >( c );
+
+         for( const auto* r = b + c; r < e; ++r ) {
+            if( *r != '0' ) {
+               drop = true;
+               return;
+            }
+         }
+      }
+
+      // The digits of the exponent without leading zeros, at most nine.
+      void edigits( const char* b, const char* e ) noexcept
+      {
+         isfp = true;
+
+         exponent10_t x = 0;
+         while( b < e ) {
+            x = ( x * 10 ) + ( b[ 0 ] - '0' );
+            ++b;
+         }
+         exponent10 += ( eneg ? -x : x );
+      }
+
       template< typename Consumer >
       void success( Consumer& consumer )
       {
-         if( !isfp && msize <= 20 ) {
-            mantissa[ msize ] = 0;
-            char* p;
-            errno = 0;
-            const std::uint64_t ull = std::strtoull( mantissa, &p, 10 );
-            if( ( errno != ERANGE ) && ( p == mantissa + msize ) ) {
+         if( !isfp && ( msize <= max_fast_digits + 1 ) ) {
+            std::uint64_t ull = digits;
+            bool fits = true;
+            if( msize > max_fast_digits ) {
+               const auto l = std::uint64_t( mantissa[ max_fast_digits ] - '0' );
+               fits = ( ull <= ( UINT64_MAX - l ) / 10 );
+               ull = ull * 10 + l;
+            }
+            if( fits ) {
                if constexpr( NEG ) {
                   if( ull < 9223372036854775808ULL ) {
                      consumer.number( -static_cast< std::int64_t >( ull ) );
@@ -63,6 +139,13 @@ namespace tao::json::internal
                }
             }
          }
+         if( !drop && ( msize <= max_fast_digits ) ) {
+            double d;
+            if( eisel_lemire( digits, exponent10, d ) ) {
+               consumer.number( NEG ? -d : d );
+               return;
+            }
+         }
          if( drop ) {
             mantissa[ msize++ ] = '1';
             --exponent10;
@@ -0,0 +1,560 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_INTERNAL_SCAN_STRING_HPP
+#define TAO_JSON_INTERNAL_SCAN_STRING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "simd.hpp"
+
+namespace tao::json::internal
+{
+   // Whether c can be part of a string body without further checks, i.e.
+   // it is printable ASCII other than the delimiter D and the backslash.
+
+   template< char D >
+   [[nodiscard]] constexpr bool is_plain( const char c ) noexcept
+   {
+      return ( c >= 0x20 ) && ( c < 0x7F ) && ( c != D ) && ( c != '\\' );
+   }
+
+   // Returns the length of the valid UTF-8 sequence at p, or zero, with the
+   // same rules as the grammar, i.e. without overlong encodings, surrogates
+   // and code points greater than 0x10FFFF.
+   [[nodiscard]] inline std::size_t utf8_sequence( const char* p, const std::size_t n ) noexcept
+   {
+      const auto b = [ = ]( const std::size_t i ) { return static_cast< unsigned char >( p[ i ] ); };
+      const auto c = b( 0 );
+      if( c < 0x80 ) {
+         return 1;
+      }
+      if( c < 0xc2 ) {
+         return 0;
+      }
+      if( c < 0xe0 ) {
+         return ( ( n >= 2 ) && ( ( b( 1 ) & 0xc0 ) == 0x80 ) ) ? 2 : 0;
+      }
+      if( c < 0xf0 ) {
+         if( ( n < 3 ) || ( ( b( 2 ) & 0xc0 ) != 0x80 ) ) {
+            return 0;
+         }
+         const unsigned lo = ( c == 0xe0 ) ? 0xa0 : 0x80;
+         const unsigned hi = ( c == 0xed ) ? 0x9f : 0xbf;
+         return ( ( lo <= b( 1 ) ) && ( b( 1 ) <= hi ) ) ? 3 : 0;
+      }
+      if( c < 0xf5 ) {
+         if( ( n < 4 ) || ( ( b( 2 ) & 0xc0 ) != 0x80 ) || ( ( b( 3 ) & 0xc0 ) != 0x80 ) ) {
+            return 0;
+         }
+         const unsigned lo = ( c == 0xf0 ) ? 0x90 : 0x80;
+         const unsigned hi = ( c == 0xf4 ) ? 0x8f : 0xbf;
+         return ( ( lo <= b( 1 ) ) && ( b( 1 ) <= hi ) ) ? 4 : 0;
+      }
+      return 0;
+   }
+
+   // Returns i, or the start of the UTF-8 sequence that is cut off at i
+   // when the last complete one before i does not end there.
+   [[nodiscard]] inline std::size_t utf8_boundary( const char* p, std::size_t i ) noexcept
+   {
+      for( std::size_t k = 1; ( k <= 3 ) && ( k <= i ); ++k ) {
+         const auto c = static_cast< unsigned char >( p[ i - k ] );
+         if( c >= 0xc0 ) {
+            return ( ( ( c >= 0xf0 ) ? 4U : ( ( c >= 0xe0 ) ? 3U : 2U ) ) > k ) ? ( i - k ) : i;
+         }
+         if( c < 0x80 ) {
+            break;
+         }
+      }
+      return i;
+   }
+
+   // Advances i over the UTF-8 sequence of a non-ASCII code point at i and
+   // returns true, or returns false when there is none.
+   [[nodiscard]] inline bool utf8_step( const char* p, const std::size_t n, std::size_t& i ) noexcept
+   {
+      if( ( i == n ) || ( static_cast< unsigned char >( p[ i ] ) < 0x80 ) ) {
+         return false;
+      }
+      const std::size_t k = utf8_sequence( p + i, n - i );
+      i += k;
+      return k != 0;
+   }
+
+#if defined( TAO_JSON_HAS_SSSE3 )
+
+   // The vectorised UTF-8 check is the one by John Keiser and Daniel Lemire,
+   // "Validating UTF-8 In Less Than One Instruction Per Byte", that looks up
+   // the error classes of every byte and the byte before it in three nibble
+   // indexed tables and checks the continuations of three and four byte
+   // sequences separately; every byte that is not valid after the three
+   // bytes before it is non-zero in the result.
+
+   namespace utf8_tables
+   {
+      inline constexpr std::uint8_t too_short = 1 << 0;
+      inline constexpr std::uint8_t too_long = 1 << 1;
+      inline constexpr std::uint8_t overlong_3 = 1 << 2;
+      inline constexpr std::uint8_t too_large = 1 << 3;
+      inline constexpr std::uint8_t surrogate = 1 << 4;
+      inline constexpr std::uint8_t overlong_2 = 1 << 5;
+      inline constexpr std::uint8_t too_large_1000 = 1 << 6;
+      inline constexpr std::uint8_t overlong_4 = 1 << 6;
+      inline constexpr std::uint8_t two_conts = 1 << 7;
+      inline constexpr std::uint8_t carry = too_short | too_long | two_conts;
+
+      alignas( 16 ) inline constexpr std::uint8_t byte_1_high[ 16 ] = {
+         too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+         two_conts, two_conts, two_conts, two_conts,
+         too_short | overlong_2,
+         too_short,
+         too_short | overlong_3 | surrogate,
+         too_short | too_large | too_large_1000 | overlong_4
+      };
+
+      alignas( 16 ) inline constexpr std::uint8_t byte_1_low[ 16 ] = {
+         carry | overlong_3 | overlong_2 | overlong_4,
+         carry | overlong_2,
+         carry,
+         carry,
+         carry | too_large,
+         carry | too_large | too_large_1000,
+         carry | too_large | too_large_1000,
+         carry | too_large | too_large_1000,
+         carry | too_large | too_large_1000,
+         carry | too_large | too_large_1000,
+         carry | too_large | too_large_1000,
+         carry | too_large | too_large_1000,
+         carry | too_large | too_large_1000,
+         carry | too_large | too_large_1000 | surrogate,
+         carry | too_large | too_large_1000,
+         carry | too_large | too_large_1000
+      };
+
+      alignas( 16 ) inline constexpr std::uint8_t byte_2_high[ 16 ] = {
+         too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+         too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+         too_long | overlong_2 | two_conts | overlong_3 | too_large,
+         too_long | overlong_2 | two_conts | surrogate | too_large,
+         too_long | overlong_2 | two_conts | surrogate | too_large,
+         too_short, too_short, too_short, too_short
+      };
+
+      // Bytes greater than these at the end of a block start a sequence
+      // that continues in the next block.
+      alignas( 16 ) inline constexpr std::uint8_t incomplete[ 16 ] = {
+         0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf
+      };
+
+      [[nodiscard]] inline __m128i load( const std::uint8_t* t ) noexcept
+      {
+         return _mm_load_si128( reinterpret_cast< const __m128i* >( t ) );  // NOLINT
+      }
+
+   }  // namespace utf8_tables
+
+   [[nodiscard]] TAO_JSON_TARGET_SSSE3 inline __m128i utf8_errors( const __m128i v, const __m128i prev ) noexcept
+   {
+      using namespace utf8_tables;
+      const __m128i f = _mm_set1_epi8( 0x0F );
+      const __m128i prev1 = _mm_alignr_epi8( v, prev, 15 );
+      const __m128i b1h = _mm_shuffle_epi8( load( byte_1_high ), _mm_and_si128( _mm_srli_epi16( prev1, 4 ), f ) );
+      const __m128i b1l = _mm_shuffle_epi8( load( byte_1_low ), _mm_and_si128( prev1, f ) );
+      const __m128i b2h = _mm_shuffle_epi8( load( byte_2_high ), _mm_and_si128( _mm_srli_epi16( v, 4 ), f ) );
+      const __m128i third = _mm_subs_epu8( _mm_alignr_epi8( v, prev, 14 ), _mm_set1_epi8( char( 0xe0 - 0x80 ) ) );
+      const __m128i fourth = _mm_subs_epu8( _mm_alignr_epi8( v, prev, 13 ), _mm_set1_epi8( char( 0xf0 - 0x80 ) ) );
+      const __m128i must23 = _mm_and_si128( _mm_or_si128( third, fourth ), _mm_set1_epi8( char( 0x80 ) ) );
+      return _mm_xor_si128( must23, _mm_and_si128( _mm_and_si128( b1h, b1l ), b2h ) );
+   }
+
+#endif
+
+#if defined( TAO_JSON_HAS_AVX2 )
+
+   [[nodiscard]] TAO_JSON_TARGET_AVX2 inline __m256i utf8_errors( const __m256i v, const __m256i prev ) noexcept
+   {
+      using namespace utf8_tables;
+      const __m256i f = _mm256_set1_epi8( 0x0F );
+      const __m256i p = _mm256_permute2x128_si256( prev, v, 0x21 );
+      const __m256i prev1 = _mm256_alignr_epi8( v, p, 15 );
+      const __m256i b1h = _mm256_shuffle_epi8( _mm256_broadcastsi128_si256( load( byte_1_high ) ), _mm256_and_si256( _mm256_srli_epi16( prev1, 4 ), f ) );
+      const __m256i b1l = _mm256_shuffle_epi8( _mm256_broadcastsi128_si256( load( byte_1_low ) ), _mm256_and_si256( prev1, f ) );
+      const __m256i b2h = _mm256_shuffle_epi8( _mm256_broadcastsi128_si256( load( byte_2_high ) ), _mm256_and_si256( _mm256_srli_epi16( v, 4 ), f ) );
+      const __m256i third = _mm256_subs_epu8( _mm256_alignr_epi8( v, p, 14 ), _mm256_set1_epi8( char( 0xe0 - 0x80 ) ) );
+      const __m256i fourth = _mm256_subs_epu8( _mm256_alignr_epi8( v, p, 13 ), _mm256_set1_epi8( char( 0xf0 - 0x80 ) ) );
+      const __m256i must23 = _mm256_and_si256( _mm256_or_si256( third, fourth ), _mm256_set1_epi8( char( 0x80 ) ) );
+      return _mm256_xor_si256( must23, _mm256_and_si256( _mm256_and_si256( b1h, b1l ), b2h ) );
+   }
+
+#endif
+
+#if defined( TAO_JSON_HAS_AVX512 )
+
+   // The masked broadcasts avoid a false -Wmaybe-uninitialized with GCC.
+
+   [[nodiscard]] TAO_JSON_TARGET_AVX512 inline __m512i utf8_errors( const __m512i v, const __m512i prev ) noexcept
+   {
+      using namespace utf8_tables;
+      const __m512i f = _mm512_set1_epi8( 0x0F );
+      const __m512i p = _mm512_permutex2var_epi64( prev, _mm512_setr_epi64( 6, 7, 8, 9, 10, 11, 12, 13 ), v );
+      const __m512i prev1 = _mm512_alignr_epi8( v, p, 15 );
+      const __m512i b1h = _mm512_shuffle_epi8( _mm512_maskz_broadcast_i32x4( 0xFFFF, load( byte_1_high ) ), _mm512_and_si512( _mm512_srli_epi16( prev1, 4 ), f ) );
+      const __m512i b1l = _mm512_shuffle_epi8( _mm512_maskz_broadcast_i32x4( 0xFFFF, load( byte_1_low ) ), _mm512_and_si512( prev1, f ) );
+      const __m512i b2h = _mm512_shuffle_epi8( _mm512_maskz_broadcast_i32x4( 0xFFFF, load( byte_2_high ) ), _mm512_and_si512( _mm512_srli_epi16( v, 4 ), f ) );
+      const __m512i third = _mm512_subs_epu8( _mm512_alignr_epi8( v, p, 14 ), _mm512_set1_epi8( char( 0xe0 - 0x80 ) ) );
+      const __m512i fourth = _mm512_subs_epu8( _mm512_alignr_epi8( v, p, 13 ), _mm512_set1_epi8( char( 0xf0 - 0x80 ) ) );
+      const __m512i must23 = _mm512_and_si512( _mm512_or_si512( third, fourth ), _mm512_set1_epi8( char( 0x80 ) ) );
+      return _mm512_xor_si512( must23, _mm512_and_si512( _mm512_and_si512( b1h, b1l ), b2h ) );
+   }
+
+#endif
+
+   // The plain_blocks functions advance i over blocks of 64, 32 or 16 plain
+   // characters and return true when they stopped in front of a character
+   // that is not plain, or false at the last incomplete block.
+
+#if defined( TAO_JSON_HAS_AVX512 )
+
+   template< char D >
+   [[nodiscard]] TAO_JSON_TARGET_AVX512 inline bool plain_blocks_avx512( const char* p, const std::size_t n, std::size_t& i ) noexcept
+   {
+      const __m512i d = _mm512_set1_epi8( D );
+      const __m512i b = _mm512_set1_epi8( '\\' );
+      const __m512i s = _mm512_set1_epi8( 0x20 );
+      const __m512i x = _mm512_set1_epi8( 0x7F );
+      for( ; i + 64 <= n; i += 64 ) {
+         const __m512i v = _mm512_loadu_si512( p + i );
+         const __mmask64 m = _mm512_cmpeq_epi8_mask( v, d ) | _mm512_cmpeq_epi8_mask( v, b ) | _mm512_cmplt_epu8_mask( v, s ) | _mm512_cmpge_epu8_mask( v, x );
+         if( m ) {
+            i += count_trailing_zeros( m );
+            return true;
+         }
+      }
+      return false;
+   }
+
+#endif
+
+#if defined( TAO_JSON_HAS_AVX2 )
+
+   template< char D >
+   [[nodiscard]] TAO_JSON_TARGET_AVX2 inline bool plain_blocks_avx2( const char* p, const std::size_t n, std::size_t& i ) noexcept
+   {
+      const __m256i d = _mm256_set1_epi8( D );
+      const __m256i b = _mm256_set1_epi8( '\\' );
+      const __m256i s = _mm256_set1_epi8( 0x20 );
+      const __m256i x = _mm256_set1_epi8( 0x7F );
+      for( ; i + 32 <= n; i += 32 ) {
+         const __m256i v = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( p + i ) );  // NOLINT
+         const __m256i m = _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi8( v, d ), _mm256_cmpeq_epi8( v, b ) ), _mm256_or_si256( _mm256_cmpgt_epi8( s, v ), _mm256_cmpeq_epi8( v, x ) ) );
+         if( const auto r = static_cast< std::uint32_t >( _mm256_movemask_epi8( m ) ) ) {
+            i += count_trailing_zeros( r );
+            return true;
+         }
+      }
+      return false;
+   }
+
+#endif
+
+#if defined( TAO_JSON_USE_SSE2 )
+
+   template< char D >
+   [[nodiscard]] inline bool plain_blocks_sse2( const char* p, const std::size_t n, std::size_t& i ) noexcept
+   {
+      // Signed comparison, bytes from 0x80 are negative and also less than 0x20.
+      const __m128i d = _mm_set1_epi8( D );
+      const __m128i b = _mm_set1_epi8( '\\' );
+      const __m128i s = _mm_set1_epi8( 0x20 );
+      const __m128i x = _mm_set1_epi8( 0x7F );
+      for( ; i + 16 <= n; i += 16 ) {
+         const __m128i v = _mm_loadu_si128( reinterpret_cast< const __m128i* >( p + i ) );  // NOLINT
+         const __m128i m = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, d ), _mm_cmpeq_epi8( v, b ) ), _mm_or_si128( _mm_cmplt_epi8( v, s ), _mm_cmpeq_epi8( v, x ) ) );
+         if( const auto r = static_cast< std::uint32_t >( _mm_movemask_epi8( m ) ) ) {
+            i += count_trailing_zeros( r );
+            return true;
+         }
+      }
+      return false;
+   }
+
+#endif
+
+   // Continues a scan for plain characters at i, 8 bytes at a time, and
+   // returns the index of the first one that is not plain, or n.
+
+   template< char D >
+   [[nodiscard]] inline std::size_t plain_tail( const char* p, const std::size_t n, std::size_t i ) noexcept
+   {
+      {
+         // Finds words that contain a byte that is not plain; there are no
+         // false negatives, and false positives are only possible in bytes
+         // after one that is not plain, which the loop below then finds.
+         constexpr std::uint64_t ones = 0x0101010101010101;
+         constexpr std::uint64_t high = 0x8080808080808080;
+         const auto has_less = []( const std::uint64_t w, const std::uint64_t c ) { return ( w - ones * c ) & ~w & high; };
+         for( ; i + 8 <= n; i += 8 ) {
+            std::uint64_t w;
+            std::memcpy( &w, p + i, sizeof( w ) );
+            if( ( w & high ) | has_less( w, 0x20 ) | has_less( w ^ ( ones * std::uint8_t( D ) ), 1 ) | has_less( w ^ ( ones * '\\' ), 1 ) | has_less( w ^ ( ones * 0x7F ), 1 ) ) {
+               break;
+            }
+         }
+      }
+      while( ( i < n ) && is_plain< D >( p[ i ] ) ) {
+         ++i;
+      }
+      return i;
+   }
+
+   // The scan_plain functions return the length of the longest prefix of
+   // [p, p + n) that consists of plain characters, with the widest vectors
+   // of their instruction set first; the base version uses SSE2 where it
+   // is available, all other platforms process 8 bytes at a time.
+
+   template< char D >
+   [[nodiscard]] inline std::size_t scan_plain_base( const char* p, const std::size_t n ) noexcept
+   {
+      std::size_t i = 0;
+#if defined( TAO_JSON_USE_SSE2 )
+      if( plain_blocks_sse2< D >( p, n, i ) ) {
+         return i;
+      }
+#endif
+      return plain_tail< D >( p, n, i );
+   }
+
+#if defined( TAO_JSON_HAS_AVX2 )
+
+   template< char D >
+   [[nodiscard]] TAO_JSON_TARGET_AVX2 inline std::size_t scan_plain_avx2( const char* p, const std::size_t n ) noexcept
+   {
+      std::size_t i = 0;
+      if( plain_blocks_avx2< D >( p, n, i ) || plain_blocks_sse2< D >( p, n, i ) ) {
+         return i;
+      }
+      return plain_tail< D >( p, n, i );
+   }
+
+#endif
+
+#if defined( TAO_JSON_HAS_AVX512 )
+
+   template< char D >
+   [[nodiscard]] TAO_JSON_TARGET_AVX512 inline std::size_t scan_plain_avx512( const char* p, const std::size_t n ) noexcept
+   {
+      std::size_t i = 0;
+      if( plain_blocks_avx512< D >( p, n, i ) || plain_blocks_avx2< D >( p, n, i ) || plain_blocks_sse2< D >( p, n, i ) ) {
+         return i;
+      }
+      return plain_tail< D >( p, n, i );
+   }
+
+#endif
+
+   template< char D >
+   [[nodiscard]] inline std::size_t scan_plain( const char* p, const std::size_t n, const simd_level level = available_simd_level() ) noexcept
+   {
+#if defined( TAO_JSON_HAS_AVX512 )
+      if( level >= simd_level::avx512 ) {
+         return scan_plain_avx512< D >( p, n );
+      }
+#endif
+#if defined( TAO_JSON_HAS_AVX2 )
+      if( level >= simd_level::avx2 ) {
+         return scan_plain_avx2< D >( p, n );
+      }
+#endif
+      (void)level;
+      return scan_plain_base< D >( p, n );
+   }
+
+   // The utf8_blocks functions advance i over blocks of 64, 32 or 16 bytes
+   // of plain characters and valid UTF-8 sequences, and then back to the
+   // start of a sequence that continues in the block that stopped them; a
+   // block that contains a character that is not plain, or an invalid
+   // sequence, is left to the next narrower loop and finally to the plain
+   // scan and utf8_step(), which stop exactly in front of it.
+
+#if defined( TAO_JSON_HAS_AVX512 )
+
+   template< char D >
+   [[nodiscard]] TAO_JSON_TARGET_AVX512 inline std::size_t utf8_blocks_avx512( const char* p, const std::size_t n, std::size_t i ) noexcept
+   {
+      const __m512i d = _mm512_set1_epi8( D );
+      const __m512i b = _mm512_set1_epi8( '\\' );
+      const __m512i s = _mm512_set1_epi8( 0x20 );
+      const __m512i x = _mm512_set1_epi8( 0x7F );
+      const __m512i e = _mm512_inserti32x4( _mm512_set1_epi8( char( 0xff ) ), utf8_tables::load( utf8_tables::incomplete ), 3 );
+      __m512i prev = _mm512_setzero_si512();
+      __m512i incomplete = _mm512_setzero_si512();
+      for( ; i + 64 <= n; i += 64 ) {
+         const __m512i v = _mm512_loadu_si512( p + i );
+         const __mmask64 m = _mm512_cmpeq_epi8_mask( v, d ) | _mm512_cmpeq_epi8_mask( v, b ) | _mm512_cmplt_epu8_mask( v, s ) | _mm512_cmpeq_epi8_mask( v, x );
+         const __m512i u = _mm512_movepi8_mask( v ) ? utf8_errors( v, prev ) : incomplete;
+         if( m | _mm512_test_epi8_mask( u, u ) ) {
+            break;
+         }
+         incomplete = _mm512_subs_epu8( v, e );
+         prev = v;
+      }
+      return utf8_boundary( p, i );
+   }
+
+#endif
+
+#if defined( TAO_JSON_HAS_AVX2 )
+
+   template< char D >
+   [[nodiscard]] TAO_JSON_TARGET_AVX2 inline std::size_t utf8_blocks_avx2( const char* p, const std::size_t n, std::size_t i ) noexcept
+   {
+      const __m256i d = _mm256_set1_epi8( D );
+      const __m256i b = _mm256_set1_epi8( '\\' );
+      const __m256i s = _mm256_set1_epi8( 0x1F );
+      const __m256i x = _mm256_set1_epi8( 0x7F );
+      const __m256i e = _mm256_inserti128_si256( _mm256_set1_epi8( char( 0xff ) ), utf8_tables::load( utf8_tables::incomplete ), 1 );
+      __m256i prev = _mm256_setzero_si256();
+      __m256i incomplete = _mm256_setzero_si256();
+      for( ; i + 32 <= n; i += 32 ) {
+         const __m256i v = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( p + i ) );  // NOLINT
+         const __m256i m = _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi8( v, d ), _mm256_cmpeq_epi8( v, b ) ), _mm256_or_si256( _mm256_cmpeq_epi8( _mm256_min_epu8( v, s ), v ), _mm256_cmpeq_epi8( v, x ) ) );
+         const __m256i u = _mm256_or_si256( m, _mm256_movemask_epi8( v ) ? utf8_errors( v, prev ) : incomplete );
+         if( !_mm256_testz_si256( u, u ) ) {
+            break;
+         }
+         incomplete = _mm256_subs_epu8( v, e );
+         prev = v;
+      }
+      return utf8_boundary( p, i );
+   }
+
+#endif
+
+#if defined( TAO_JSON_HAS_SSSE3 )
+
+   template< char D >
+   [[nodiscard]] TAO_JSON_TARGET_SSSE3 inline std::size_t utf8_blocks_ssse3( const char* p, const std::size_t n, std::size_t i ) noexcept
+   {
+      const __m128i d = _mm_set1_epi8( D );
+      const __m128i b = _mm_set1_epi8( '\\' );
+      const __m128i s = _mm_set1_epi8( 0x1F );
+      const __m128i x = _mm_set1_epi8( 0x7F );
+      const __m128i z = _mm_setzero_si128();
+      const __m128i e = utf8_tables::load( utf8_tables::incomplete );
+      __m128i prev = z;
+      __m128i incomplete = z;
+      for( ; i + 16 <= n; i += 16 ) {
+         const __m128i v = _mm_loadu_si128( reinterpret_cast< const __m128i* >( p + i ) );  // NOLINT
+         const __m128i m = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, d ), _mm_cmpeq_epi8( v, b ) ), _mm_or_si128( _mm_cmpeq_epi8( _mm_min_epu8( v, s ), v ), _mm_cmpeq_epi8( v, x ) ) );
+         const __m128i u = _mm_or_si128( m, _mm_movemask_epi8( v ) ? utf8_errors( v, prev ) : incomplete );
+         if( _mm_movemask_epi8( _mm_cmpeq_epi8( u, z ) ) != 0xFFFF ) {
+            break;
+         }
+         incomplete = _mm_subs_epu8( v, e );
+         prev = v;
+      }
+      return utf8_boundary( p, i );
+   }
+
+#endif
+
+   // The scan_utf8 functions continue scan_string() at i, which is in front
+   // of a byte from 0x80, with the vectorised UTF-8 check of their
+   // instruction set; the base version checks one sequence at a time.
+
+   template< char D >
+   [[nodiscard]] inline std::size_t scan_utf8_base( const char* p, const std::size_t n, std::size_t i ) noexcept
+   {
+      while( utf8_step( p, n, i ) ) {
+         i += scan_plain_base< D >( p + i, n - i );
+      }
+      return i;
+   }
+
+#if defined( TAO_JSON_HAS_SSSE3 )
+
+   template< char D >
+   [[nodiscard]] TAO_JSON_TARGET_SSSE3 inline std::size_t scan_utf8_ssse3( const char* p, const std::size_t n, std::size_t i ) noexcept
+   {
+      do {
+         i = utf8_blocks_ssse3< D >( p, n, i );
+         i += scan_plain_base< D >( p + i, n - i );
+      } while( utf8_step( p, n, i ) );
+      return i;
+   }
+
+#endif
+
+#if defined( TAO_JSON_HAS_AVX2 )
+
+   template< char D >
+   [[nodiscard]] TAO_JSON_TARGET_AVX2 inline std::size_t scan_utf8_avx2( const char* p, const std::size_t n, std::size_t i ) noexcept
+   {
+      do {
+         i = utf8_blocks_ssse3< D >( p, n, utf8_blocks_avx2< D >( p, n, i ) );
+         i += scan_plain_avx2< D >( p + i, n - i );
+      } while( utf8_step( p, n, i ) );
+      return i;
+   }
+
+#endif
+
+#if defined( TAO_JSON_HAS_AVX512 )
+
+   template< char D >
+   [[nodiscard]] TAO_JSON_TARGET_AVX512 inline std::size_t scan_utf8_avx512( const char* p, const std::size_t n, std::size_t i ) noexcept
+   {
+      do {
+         i = utf8_blocks_ssse3< D >( p, n, utf8_blocks_avx2< D >( p, n, utf8_blocks_avx512< D >( p, n, i ) ) );
+         i += scan_plain_avx512< D >( p + i, n - i );
+      } while( utf8_step( p, n, i ) );
+      return i;
+   }
+
+#endif
+
+   template< char D >
+   [[nodiscard]] inline std::size_t scan_utf8( const char* p, const std::size_t n, const std::size_t i, const simd_level level ) noexcept
+   {
+#if defined( TAO_JSON_HAS_AVX512 )
+      if( level >= simd_level::avx512 ) {
+         return scan_utf8_avx512< D >( p, n, i );
+      }
+#endif
+#if defined( TAO_JSON_HAS_AVX2 )
+      if( level >= simd_level::avx2 ) {
+         return scan_utf8_avx2< D >( p, n, i );
+      }
+#endif
+#if defined( TAO_JSON_HAS_SSSE3 )
+      if( level >= simd_level::ssse3 ) {
+         return scan_utf8_ssse3< D >( p, n, i );
+      }
+#endif
+      (void)level;
+      return scan_utf8_base< D >( p, n, i );
+   }
+
+   // Returns the length of the longest prefix of [p, p + n) that consists
+   // of plain characters and of valid UTF-8 sequences of non-ASCII code
+   // points. The vectorised UTF-8 check is only used after the first byte
+   // from 0x80, which keeps the ASCII strings that JSON mostly consists of
+   // on the shorter path of scan_plain(). The level defaults to the widest
+   // instructions of the CPU, see simd.hpp, and is only given by tests.
+
+   template< char D >
+   [[nodiscard]] inline std::size_t scan_string( const char* p, const std::size_t n, const simd_level level = available_simd_level() ) noexcept
+   {
+      const std::size_t i = scan_plain< D >( p, n, level );
+      if( ( i == n ) || ( static_cast< unsigned char >( p[ i ] ) < 0x80 ) ) {
+         return i;
+      }
+      return scan_utf8< D >( p, n, i, level );
+   }
+
+}  // namespace tao::json::internal
+
+#endif
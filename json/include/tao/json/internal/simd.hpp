@@ -0,0 +1,151 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_INTERNAL_SIMD_HPP
+#define TAO_JSON_INTERNAL_SIMD_HPP
+
+#include <cstdint>
+
+// The vector instructions are selected when the library is compiled, SSE2
+// is always available on x86-64, SSSE3, AVX2, AVX-512 and PCLMUL need e.g.
+// -mssse3, -mavx2, -mavx512bw and -mpclmul, or -march=native; all other
+// platforms use portable fallbacks.
+
+// With GCC and Clang on x86 the scan of string bodies in scan_string.hpp
+// is additionally compiled for SSSE3, AVX2 and AVX-512 with target
+// attributes, and the widest of them that the CPU supports is used, see
+// available_simd_level(); define TAO_JSON_NO_SIMD_DISPATCH to only use the
+// instructions selected when compiling.
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+#define TAO_JSON_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined( __AVX2__ )
+#define TAO_JSON_USE_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined( __AVX512BW__ )
+#define TAO_JSON_USE_AVX512
+#include <immintrin.h>
+#endif
+
+#if defined( __SSSE3__ ) || defined( TAO_JSON_USE_AVX2 ) || defined( TAO_JSON_USE_AVX512 )
+#define TAO_JSON_USE_SSSE3
+#include <tmmintrin.h>
+#endif
+
+#if defined( __PCLMUL__ ) && defined( TAO_JSON_USE_SSE2 )
+#define TAO_JSON_USE_PCLMUL
+#include <wmmintrin.h>
+#endif
+
+#if defined( TAO_JSON_USE_SSE2 ) && defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) && !defined( TAO_JSON_NO_SIMD_DISPATCH )
+#define TAO_JSON_SIMD_DISPATCH
+#define TAO_JSON_TARGET_SSSE3 [[gnu::target( "ssse3" )]]
+#define TAO_JSON_TARGET_AVX2 [[gnu::target( "avx2" )]]
+#define TAO_JSON_TARGET_AVX512 [[gnu::target( "avx512bw" )]]
+#include <immintrin.h>
+#else
+#define TAO_JSON_TARGET_SSSE3
+#define TAO_JSON_TARGET_AVX2
+#define TAO_JSON_TARGET_AVX512
+#endif
+
+// Code for these instructions is compiled, it is used when the CPU has them.
+
+#if defined( TAO_JSON_USE_SSSE3 ) || defined( TAO_JSON_SIMD_DISPATCH )
+#define TAO_JSON_HAS_SSSE3
+#endif
+
+#if defined( TAO_JSON_USE_AVX2 ) || defined( TAO_JSON_SIMD_DISPATCH )
+#define TAO_JSON_HAS_AVX2
+#endif
+
+#if defined( TAO_JSON_USE_AVX512 ) || defined( TAO_JSON_SIMD_DISPATCH )
+#define TAO_JSON_HAS_AVX512
+#endif
+
+#if defined( _MSC_VER ) && !defined( __clang__ )
+#include <intrin.h>
+#endif
+
+namespace tao::json::internal
+{
+   // The instructions beyond SSE2, or beyond the portable fallbacks, that
+   // the string scan can use.
+
+   enum class simd_level : std::uint8_t
+   {
+      base,
+      ssse3,
+      avx2,
+      avx512
+   };
+
+#if defined( TAO_JSON_USE_AVX512 )
+   inline constexpr simd_level compiled_simd_level = simd_level::avx512;
+#elif defined( TAO_JSON_USE_AVX2 )
+   inline constexpr simd_level compiled_simd_level = simd_level::avx2;
+#elif defined( TAO_JSON_USE_SSSE3 )
+   inline constexpr simd_level compiled_simd_level = simd_level::ssse3;
+#else
+   inline constexpr simd_level compiled_simd_level = simd_level::base;
+#endif
+
+#if defined( TAO_JSON_SIMD_DISPATCH )
+
+   [[nodiscard]] inline simd_level detect_simd_level() noexcept
+   {
+      __builtin_cpu_init();
+      if( __builtin_cpu_supports( "avx512bw" ) ) {
+         return simd_level::avx512;
+      }
+      if( __builtin_cpu_supports( "avx2" ) ) {
+         return simd_level::avx2;
+      }
+      if( __builtin_cpu_supports( "ssse3" ) ) {
+         return simd_level::ssse3;
+      }
+      return simd_level::base;
+   }
+
+   // Set once at startup; it is zero, i.e. base, before, so that strings
+   // scanned by other static initialisers use the narrower loops.
+   inline const simd_level detected_simd_level = detect_simd_level();
+
+#endif
+
+   // The widest instructions that the CPU supports and code is compiled for.
+   [[nodiscard]] inline simd_level available_simd_level() noexcept
+   {
+#if defined( TAO_JSON_SIMD_DISPATCH )
+      return ( detected_simd_level > compiled_simd_level ) ? detected_simd_level : compiled_simd_level;
+#else
+      return compiled_simd_level;
+#endif
+   }
+
+   // Returns the index of the least significant set bit, m must not be zero.
+   [[nodiscard]] inline unsigned count_trailing_zeros( const std::uint64_t m ) noexcept
+   {
+#if defined( _MSC_VER ) && !defined( __clang__ ) && defined( _M_X64 )
+      unsigned long r;
+      _BitScanForward64( &r, m );
+      return static_cast< unsigned >( r );
+#elif defined( _MSC_VER ) && !defined( __clang__ )
+      unsigned n = 0;
+      for( std::uint64_t t = m; !( t & 1 ); t >>= 1 ) {
+         ++n;
+      }
+      return n;
+#else
+      return static_cast< unsigned >( __builtin_ctzll( m ) );
+#endif
+   }
+
+}  // namespace tao::json::internal
+
+#endif
@@ -0,0 +1,213 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_INTERNAL_STRUCTURAL_INDEX_HPP
+#define TAO_JSON_INTERNAL_STRUCTURAL_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "simd.hpp"
+
+namespace tao::json::internal
+{
+   // The first stage of the indexed parser finds the positions of all
+   // tokens of a JSON text, i.e. of all structural characters outside of
+   // strings, of the opening quotes of strings, and of the first character
+   // of all other runs of characters that are not whitespace, like the
+   // literals and numbers, but also invalid characters. The input is
+   // processed in blocks of 64 bytes, each character class is computed as
+   // a 64-bit mask with SIMD instructions where available, and the masks
+   // are then combined with bit operations that carry state from block to
+   // block. The second stage checks everything else, see indexed_parser.
+
+   struct block_classes
+   {
+      std::uint64_t quote = 0;
+      std::uint64_t backslash = 0;
+      std::uint64_t structural = 0;
+      std::uint64_t whitespace = 0;
+   };
+
+#if defined( TAO_JSON_USE_AVX2 )
+   [[nodiscard]] inline block_classes classify_block( const char* p ) noexcept
+   {
+      const __m256i quote = _mm256_set1_epi8( '"' );
+      const __m256i backslash = _mm256_set1_epi8( '\\' );
+      const __m256i lower = _mm256_set1_epi8( 0x20 );  // Maps '[' and ']' to '{' and '}'.
+      const __m256i open = _mm256_set1_epi8( '{' );
+      const __m256i close = _mm256_set1_epi8( '}' );
+      const __m256i colon = _mm256_set1_epi8( ':' );
+      const __m256i comma = _mm256_set1_epi8( ',' );
+      const __m256i space = _mm256_set1_epi8( ' ' );
+      const __m256i tab = _mm256_set1_epi8( '\t' );
+      const __m256i lf = _mm256_set1_epi8( '\n' );
+      const __m256i cr = _mm256_set1_epi8( '\r' );
+
+      block_classes r;
+      for( unsigned i = 0; i < 64; i += 32 ) {
+         const __m256i v = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( p + i ) );  // NOLINT
+         const __m256i l = _mm256_or_si256( v, lower );
+         const __m256i s = _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi8( l, open ), _mm256_cmpeq_epi8( l, close ) ), _mm256_or_si256( _mm256_cmpeq_epi8( v, colon ), _mm256_cmpeq_epi8( v, comma ) ) );
+         const __m256i w = _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi8( v, space ), _mm256_cmpeq_epi8( v, tab ) ), _mm256_or_si256( _mm256_cmpeq_epi8( v, lf ), _mm256_cmpeq_epi8( v, cr ) ) );
+         r.quote |= std::uint64_t( std::uint32_t( _mm256_movemask_epi8( _mm256_cmpeq_epi8( v, quote ) ) ) ) << i;
+         r.backslash |= std::uint64_t( std::uint32_t( _mm256_movemask_epi8( _mm256_cmpeq_epi8( v, backslash ) ) ) ) << i;
+         r.structural |= std::uint64_t( std::uint32_t( _mm256_movemask_epi8( s ) ) ) << i;
+         r.whitespace |= std::uint64_t( std::uint32_t( _mm256_movemask_epi8( w ) ) ) << i;
+      }
+      return r;
+   }
+#elif defined( TAO_JSON_USE_SSE2 )
+   [[nodiscard]] inline block_classes classify_block( const char* p ) noexcept
+   {
+      const __m128i quote = _mm_set1_epi8( '"' );
+      const __m128i backslash = _mm_set1_epi8( '\\' );
+      const __m128i lower = _mm_set1_epi8( 0x20 );  // Maps '[' and ']' to '{' and '}'.
+      const __m128i open = _mm_set1_epi8( '{' );
+      const __m128i close = _mm_set1_epi8( '}' );
+      const __m128i colon = _mm_set1_epi8( ':' );
+      const __m128i comma = _mm_set1_epi8( ',' );
+      const __m128i space = _mm_set1_epi8( ' ' );
+      const __m128i tab = _mm_set1_epi8( '\t' );
+      const __m128i lf = _mm_set1_epi8( '\n' );
+      const __m128i cr = _mm_set1_epi8( '\r' );
+
+      block_classes r;
+      for( unsigned i = 0; i < 64; i += 16 ) {
+         const __m128i v = _mm_loadu_si128( reinterpret_cast< const __m128i* >( p + i ) );  // NOLINT
+         const __m128i l = _mm_or_si128( v, lower );
+         const __m128i s = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( l, open ), _mm_cmpeq_epi8( l, close ) ), _mm_or_si128( _mm_cmpeq_epi8( v, colon ), _mm_cmpeq_epi8( v, comma ) ) );
+         const __m128i w = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, space ), _mm_cmpeq_epi8( v, tab ) ), _mm_or_si128( _mm_cmpeq_epi8( v, lf ), _mm_cmpeq_epi8( v, cr ) ) );
+         r.quote |= std::uint64_t( std::uint32_t( _mm_movemask_epi8( _mm_cmpeq_epi8( v, quote ) ) ) ) << i;
+         r.backslash |= std::uint64_t( std::uint32_t( _mm_movemask_epi8( _mm_cmpeq_epi8( v, backslash ) ) ) ) << i;
+         r.structural |= std::uint64_t( std::uint32_t( _mm_movemask_epi8( s ) ) ) << i;
+         r.whitespace |= std::uint64_t( std::uint32_t( _mm_movemask_epi8( w ) ) ) << i;
+      }
+      return r;
+   }
+#else
+   [[nodiscard]] inline block_classes classify_block( const char* p ) noexcept
+   {
+      block_classes r;
+      for( unsigned i = 0; i < 64; ++i ) {
+         const std::uint64_t b = std::uint64_t( 1 ) << i;
+         switch( p[ i ] ) {
+            case '"':
+               r.quote |= b;
+               break;
+            case '\\':
+               r.backslash |= b;
+               break;
+            case '[':
+            case ']':
+            case '{':
+            case '}':
+            case ':':
+            case ',':
+               r.structural |= b;
+               break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+               r.whitespace |= b;
+               break;
+         }
+      }
+      return r;
+   }
+#endif
+
+   // Sets every bit to the parity of the bits at and below it, e.g. turns
+   // the quotes of a block into the mask of the opening quotes and the
+   // characters inside of strings.
+   [[nodiscard]] inline std::uint64_t prefix_xor( std::uint64_t x ) noexcept
+   {
+#if defined( TAO_JSON_USE_PCLMUL )
+      return std::uint64_t( _mm_cvtsi128_si64( _mm_clmulepi64_si128( _mm_set_epi64x( 0, std::int64_t( x ) ), _mm_set1_epi8( -1 ), 0 ) ) );
+#else
+      x ^= x << 1;
+      x ^= x << 2;
+      x ^= x << 4;
+      x ^= x << 8;
+      x ^= x << 16;
+      x ^= x << 32;
+      return x;
+#endif
+   }
+
+   class structural_indexer
+   {
+   public:
+      // Appends the positions of the tokens in [data, data + size) to indices;
+      // returns false when the input ends in the middle of a string.
+      [[nodiscard]] bool operator()( const char* data, const std::size_t size, std::vector< std::uint32_t >& indices )
+      {
+         indices.clear();
+         indices.reserve( size / 4 + 16 );
+         std::size_t i = 0;
+         for( ; i + 64 <= size; i += 64 ) {
+            emit( i, block( classify_block( data + i ) ), indices );
+         }
+         if( i < size ) {
+            char tail[ 64 ];
+            std::memset( tail, ' ', sizeof( tail ) );
+            std::memcpy( tail, data + i, size - i );
+            emit( i, block( classify_block( tail ) ), indices );
+         }
+         return m_inside == 0;
+      }
+
+   private:
+      std::uint64_t m_escaped = 0;  // Whether the first character of the next block is escaped.
+      std::uint64_t m_inside = 0;  // All ones when the next block starts inside of a string.
+      std::uint64_t m_scalar = 0;  // Whether the last character of the previous block was a scalar character.
+
+      // Returns the mask of the characters that are preceded by an odd number
+      // of backslashes; backslashes are rare, so they are handled one by one.
+      [[nodiscard]] std::uint64_t escaped( std::uint64_t backslash ) noexcept
+      {
+         std::uint64_t r = m_escaped;
+         backslash &= ~m_escaped;
+         m_escaped = 0;
+         while( backslash ) {
+            const unsigned b = count_trailing_zeros( backslash );
+            if( b == 63 ) {
+               m_escaped = 1;
+               break;
+            }
+            const std::uint64_t next = std::uint64_t( 2 ) << b;
+            r |= next;
+            backslash &= ~next;
+            backslash &= backslash - 1;
+         }
+         return r;
+      }
+
+      [[nodiscard]] std::uint64_t block( const block_classes& c ) noexcept
+      {
+         const std::uint64_t quote = c.quote & ~escaped( c.backslash );
+         const std::uint64_t inside = prefix_xor( quote ) ^ m_inside;
+         m_inside = std::uint64_t( std::int64_t( inside ) >> 63 );
+
+         const std::uint64_t scalar = ~( c.structural | c.whitespace | quote | inside );
+         const std::uint64_t follows = ( scalar << 1 ) | m_scalar;
+         m_scalar = scalar >> 63;
+
+         return ( c.structural & ~inside ) | ( quote & inside ) | ( scalar & ~follows );
+      }
+
+      static void emit( const std::size_t base, std::uint64_t tokens, std::vector< std::uint32_t >& indices )
+      {
+         while( tokens ) {
+            indices.push_back( std::uint32_t( base + count_trailing_zeros( tokens ) ) );
+            tokens &= tokens - 1;
+         }
+      }
+   };
+
+}  // namespace tao::json::internal
+
+#endif
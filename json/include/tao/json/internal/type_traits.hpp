@@ -4,8 +4,13 @@
 #ifndef TAO_JSON_INTERNAL_TYPE_TRAITS_HPP
 #define TAO_JSON_INTERNAL_TYPE_TRAITS_HPP
 
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <typeinfo>
+#include <vector>
 
 #include "../forward.hpp"
 
@@ -99,6 +104,90 @@ namespace tao::json::internal
    template< template< typename... > class Traits, typename T >
    inline constexpr bool enable_implicit_constructor = Traits< std::conditional_t< has_enable_implicit_constructor< Traits, T >, T, void > >::enable_implicit_constructor;
 
+   template< template< typename... > class Traits, typename V, typename = void >
+   struct array_type
+   {
+      using type = std::vector< V >;
+   };
+
+   template< template< typename... > class Traits, typename V >
+   struct array_type< Traits, V, std::void_t< typename Traits< void >::template array_t< V > > >
+   {
+      using type = typename Traits< void >::template array_t< V >;
+   };
+
+   template< template< typename... > class Traits, typename V, typename = void >
+   struct object_type
+   {
+      using type = std::map< std::string, V, std::less<> >;
+   };
+
+   template< template< typename... > class Traits, typename V >
+   struct object_type< Traits, V, std::void_t< typename Traits< void >::template object_t< V > > >
+   {
+      using type = typename Traits< void >::template object_t< V >;
+   };
+
+   template< typename O, typename = void >
+   inline constexpr bool has_unsafe_assign_unsorted = false;
+
+   template< typename O >
+   inline constexpr bool has_unsafe_assign_unsorted< O, decltype( (void)std::declval< O& >().unsafe_assign_unsorted( std::declval< typename O::value_type* >(), std::declval< typename O::value_type* >() ), void() ) > = true;
+
+   template< typename C, typename = void >
+   inline constexpr bool has_is_shared = false;
+
+   template< typename C >
+   inline constexpr bool has_is_shared< C, decltype( (void)std::declval< const C& >().is_shared(), (void)std::declval< const C& >().get(), void() ) > = true;
+
+   // Whether an Array or Object container owns its elements, a container
+   // that shares them with others, like shared_container<>, only releases
+   // a reference when it is destroyed.
+
+   template< typename C >
+   [[nodiscard]] bool is_exclusive( const C& c ) noexcept
+   {
+      if constexpr( has_is_shared< C > ) {
+         return !c.is_shared();
+      }
+      else {
+         return true;
+      }
+   }
+
+   // Whether two containers are equal because they are the same storage.
+
+   template< typename L, typename R >
+   [[nodiscard]] bool is_same_storage( const L& l, const R& r ) noexcept
+   {
+      if constexpr( !std::is_same_v< L, R > ) {
+         return false;
+      }
+      else if constexpr( has_is_shared< L > ) {
+         return &l.get() == &r.get();
+      }
+      else {
+         return &l == &r;
+      }
+   }
+
+   // Whether a consumer accepts the unconverted text of numbers with a
+   // number_raw( std::string_view ); a consumer that inherits number_raw(),
+   // e.g. from events::to_stream, but needs converted numbers, e.g. since
+   // it overrides number(), declares a static disable_number_raw = true.
+
+   template< typename C, typename = void >
+   inline constexpr bool has_disable_number_raw = false;
+
+   template< typename C >
+   inline constexpr bool has_disable_number_raw< C, decltype( C::disable_number_raw, void() ) > = C::disable_number_raw;
+
+   template< typename C, typename = void >
+   inline constexpr bool has_number_raw = false;
+
+   template< typename C >
+   inline constexpr bool has_number_raw< C, decltype( (void)std::declval< C& >().number_raw( std::declval< std::string_view >() ), void() ) > = !has_disable_number_raw< C >;
+
 }  // namespace tao::json::internal
 
 #endif
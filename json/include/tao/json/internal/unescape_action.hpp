@@ -4,6 +4,10 @@
 #ifndef TAO_JSON_INTERNAL_UNESCAPE_ACTION_HPP
 #define TAO_JSON_INTERNAL_UNESCAPE_ACTION_HPP
 
+#include <string>
+#include <string_view>
+#include <utility>
+
 #include "../external/pegtl/contrib/unescape.hpp"
 #include "../external/pegtl/nothing.hpp"
 
@@ -19,6 +23,88 @@ namespace tao::json::internal
    template<> struct unescape_action< rules::unescaped > : pegtl::unescape::append_all {};
    // clang-format on
 
+   // State for unescape_view_action; the unescaped string is only built once
+   // the first escape sequence is seen, until then the content is a view into
+   // the input that stays valid until the closing quote has been consumed.
+
+   struct string_state
+   {
+      std::string_view view;
+      std::string unescaped;
+      bool escaped = false;
+
+      void escape()
+      {
+         if( !escaped ) {
+            unescaped.assign( view.data(), view.size() );
+            escaped = true;
+         }
+      }
+
+      template< typename Consumer >
+      void string( Consumer& consumer )
+      {
+         if( escaped ) {
+            consumer.string( std::move( unescaped ) );
+         }
+         else {
+            consumer.string( view );
+         }
+      }
+
+      template< typename Consumer >
+      void key( Consumer& consumer )
+      {
+         if( escaped ) {
+            consumer.key( std::move( unescaped ) );
+         }
+         else {
+            consumer.key( view );
+         }
+      }
+   };
+
+   template< typename Rule >
+   struct unescape_view_action
+      : pegtl::nothing< Rule >
+   {};
+
+   template< typename Unescape >
+   struct unescape_view
+   {
+      template< typename Input >
+      static void apply( const Input& in, string_state& s )
+      {
+         s.escape();
+         Unescape::apply( in, s.unescaped );
+      }
+   };
+
+   template<>
+   struct unescape_view_action< rules::escaped_unicode >
+      : unescape_view< unescape_action< rules::escaped_unicode > >
+   {};
+
+   template<>
+   struct unescape_view_action< rules::escaped_char >
+      : unescape_view< unescape_action< rules::escaped_char > >
+   {};
+
+   template<>
+   struct unescape_view_action< rules::unescaped >
+   {
+      template< typename Input >
+      static void apply( const Input& in, string_state& s )
+      {
+         if( s.escaped ) {
+            s.unescaped.append( in.begin(), in.size() );
+         }
+         else {
+            s.view = std::string_view( in.begin(), in.size() );
+         }
+      }
+   };
+
 }  // namespace tao::json::internal
 
 #endif
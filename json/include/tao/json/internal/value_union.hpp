@@ -22,7 +22,7 @@ namespace tao::json::internal
       producer_t producer;
    };
 
-   template< typename T >
+   template< typename T, typename O = std::map< std::string, T, std::less<> >, typename A = std::vector< T > >
    union value_union
    {
       value_union() noexcept  // NOLINT
@@ -49,8 +49,8 @@ namespace tao::json::internal
       std::vector< std::byte > x;
       tao::binary_view xv;
 
-      std::vector< T > a;
-      std::map< std::string, T, std::less<> > o;
+      A a;
+      O o;
 
       const T* p;
       opaque_ptr_t q;
@@ -21,6 +21,8 @@ namespace tao::json::jaxn::events
    {
       using json::events::to_pretty_stream::to_pretty_stream;
 
+      static constexpr bool disable_number_raw = true;
+
       using json::events::to_pretty_stream::number;
 
       void number( const double v )
@@ -22,6 +22,8 @@ namespace tao::json::jaxn::events
       using json::events::to_stream::number;
       using json::events::to_stream::to_stream;
 
+      static constexpr bool disable_number_raw = true;
+
       void number( const double v )
       {
          next();
@@ -247,17 +247,7 @@ namespace tao::json::jaxn::internal
             throw pegtl::parse_error( "JSON number with 1 megabyte digits", in );  // NOLINT
          }
 
-         const auto c = ( std::min )( s, json::internal::max_mantissa_digits );
-         std::memcpy( result.mantissa, in.begin(), c );
-         result.exponent10 += static_cast< typename json::internal::number_state< NEG >::exponent10_t >( s - c );
-         result.msize = static_cast< typename json::internal::number_state< NEG >::msize_t >( c );
-
-         for( std::size_t i = c; i < s; ++i ) {
-            if( in.peek_char( i ) != '0' ) {
-               result.drop = true;
-               return;
-            }
-         }
+         result.idigits( in.begin(), s );
       }
    };
 
@@ -267,31 +257,7 @@ namespace tao::json::jaxn::internal
       template< typename Input, bool NEG >
       static void apply( const Input& in, json::internal::number_state< NEG >& result )
       {
-         result.isfp = true;
-
-         const auto* b = in.begin();
-         const auto* e = in.end();
-
-         while( ( e > b ) && ( e[ -1 ] == '0' ) ) {
-            --e;
-         }
-         if( !result.msize ) {
-            while( ( b < e ) && ( b[ 0 ] == '0' ) ) {
-               ++b;
-               --result.exponent10;
-            }
-         }
-         const auto c = ( std::min )( std::size_t( e - b ), json::internal::max_mantissa_digits - result.msize );
-         std::memcpy( result.mantissa + result.msize, b, c );
-         result.exponent10 -= static_cast< typename json::internal::number_state< NEG >::exponent10_t >( c );
-         result.msize += static_cast< typename json::internal::number_state< NEG >::msize_t >( c );
-
-         for( const auto* r = b + c; r < e; ++r ) {
-            if( *r != '0' ) {
-               result.drop = true;
-               return;
-            }
-         }
+         result.fdigits( in.begin(), in.end() );
       }
    };
 
@@ -301,8 +267,6 @@ namespace tao::json::jaxn::internal
       template< typename Input, bool NEG >
       static void apply( const Input& in, json::internal::number_state< NEG >& result )
       {
-         result.isfp = true;
-
          const char* b = in.begin();
 
          while( ( b < in.end() ) && ( b[ 0 ] == '0' ) ) {
@@ -311,13 +275,7 @@ namespace tao::json::jaxn::internal
          if( ( in.end() - b ) > 9 ) {
             throw pegtl::parse_error( "JSON exponent has more than 9 significant digits", in );  // NOLINT
          }
-         int exponent10 = 0;
-
-         while( b < in.end() ) {
-            exponent10 = ( exponent10 * 10 ) + ( b[ 0 ] - '0' );
-            ++b;
-         }
-         result.exponent10 += ( result.eneg ? -exponent10 : exponent10 );
+         result.edigits( b, in.end() );
       }
    };
 
@@ -9,6 +9,9 @@
 #include "../../external/pegtl.hpp"
 #include "../../external/pegtl/contrib/abnf.hpp"
 
+#include "../../internal/first_sor.hpp"
+#include "../../internal/scan_string.hpp"
+
 namespace tao::json::jaxn::internal
 {
    // clang-format off
@@ -16,16 +19,18 @@ namespace tao::json::jaxn::internal
    {
       using namespace pegtl;  // NOLINT
 
-      struct line_comment_char : sor< one< '\t' >, utf8::ranges< 0x20, 0x7E, 0x80, 0x10FFFF > > {};
+      using tao::json::internal::first_sor;
+
+      struct line_comment_char : first_sor< one< '\t' >, utf8::ranges< 0x20, 0x7E, 0x80, 0x10FFFF > > {};
       struct line_comment : seq< one< '/' >, until< eolf, must< line_comment_char > > > {};
 
-      struct block_comment_char : sor< one< '\t' >, utf8::ranges< 0x20, 0x7E, 0x80, 0x10FFFF >, eol > {};
+      struct block_comment_char : first_sor< one< '\t' >, utf8::ranges< 0x20, 0x7E, 0x80, 0x10FFFF >, eol > {};
       struct end_block_comment : until< pegtl::string< '*', '/' >, must< block_comment_char > > {};
       struct block_comment : if_must< one< '*' >, end_block_comment > {};
 
-      struct comment : sor< line_comment, block_comment > {};
+      struct comment : first_sor< line_comment, block_comment > {};
 
-      struct ws : sor< one< ' ', '\t', '\n', '\r' >, seq< one< '#' >, until< eolf > >, if_must< one< '/' >, comment > > {};
+      struct ws : first_sor< one< ' ', '\t', '\n', '\r' >, seq< one< '#' >, until< eolf > >, if_must< one< '/' >, comment > > {};
 
       template< typename R, typename P = ws >
       using padr = pegtl::internal::seq< R, pegtl::internal::star< P > >;
@@ -72,7 +77,7 @@ namespace tao::json::jaxn::internal
       struct escaped_unicode : list< seq< one< 'u' >, rep< 4, xdigit > >, one< '\\' > > {};
 
       struct escaped_char : one< '"', '\'', '\\', '/', 'b', 'f', 'n', 'r', 't', 'v', '0' > {};
-      struct escaped : sor< escaped_char, escaped_unicode_code_point, escaped_unicode > {};
+      struct escaped : first_sor< escaped_char, escaped_unicode_code_point, escaped_unicode > {};
 
       template< char D >
       struct unescaped
@@ -85,6 +90,11 @@ namespace tao::json::jaxn::internal
             bool result = false;
 
             while( const std::size_t s = in.size( 4 ) ) {
+               if( const std::size_t n = tao::json::internal::scan_string< D >( in.current(), s ) ) {
+                  in.bump_in_this_line( n );
+                  result = true;
+                  continue;
+               }
                if( const auto t = pegtl::internal::peek_utf8::peek( in, s ) ) {
                   if( ( 0x20 <= t.data ) && ( t.data <= 0x10FFFF ) && ( t.data != '\\' ) && ( t.data != D ) && ( t.data != 0x7F ) ) {
                      in.bump_in_this_line( t.size );
@@ -132,7 +142,7 @@ namespace tao::json::jaxn::internal
       };
 
       template< char D >
-      struct mchars : sor< mchars_non_eol< D >, one< D >, eol > {};
+      struct mchars : first_sor< mchars_non_eol< D >, one< D >, eol > {};
 
       template< char D >
       struct mqstring_content : until< at< three< D > >, must< mchars< D > > > {};
@@ -140,7 +150,7 @@ namespace tao::json::jaxn::internal
       template< char D >
       struct mqstring : seq< three< D >, opt< eol >, must< mqstring_content< D > >, any, any, any > {};
 
-      struct string_fragment : sor< mqstring< '"' >, mqstring< '\'' >, qstring< '"' >, qstring< '\'' > > {};
+      struct string_fragment : first_sor< mqstring< '"' >, mqstring< '\'' >, qstring< '"' >, qstring< '\'' > > {};
 
       struct string : list_must< string_fragment, value_concat > {};
 
@@ -149,7 +159,7 @@ namespace tao::json::jaxn::internal
       struct bescaped_hexcode : seq< one< 'x' >, rep< 2, must< xdigit > > > {};
 
       struct bescaped_char : one< '"', '\'', '\\', '/', 'b', 'f', 'n', 'r', 't', 'v', '0' > {};
-      struct bescaped : sor< bescaped_char, bescaped_hexcode > {};
+      struct bescaped : first_sor< bescaped_char, bescaped_hexcode > {};
 
       template< char D >
       struct bunescaped
@@ -183,7 +193,7 @@ namespace tao::json::jaxn::internal
       template< char D >
       struct bqstring : seq< one< D >, must< bqstring_content< D > >, any > {};
 
-      struct bstring : sor< bqstring< '"' >, bqstring< '\'' > > {};
+      struct bstring : first_sor< bqstring< '"' >, bqstring< '\'' > > {};
 
       struct bbyte : rep< 2, abnf::HEXDIG > {};
 
@@ -191,7 +201,7 @@ namespace tao::json::jaxn::internal
 
       struct bdirect : list_must< bpart, one< '.' > > {};
 
-      struct bvalue : seq< binary_prefix, opt< sor< bstring, bdirect > > > {};
+      struct bvalue : seq< binary_prefix, opt< first_sor< bstring, bdirect > > > {};
 
       struct binary : list_must< bvalue, value_concat > {};
 
@@ -209,7 +219,7 @@ namespace tao::json::jaxn::internal
 
       struct key : string {};
 
-      struct mkey : sor< key, identifier > {};
+      struct mkey : first_sor< key, identifier > {};
       struct member : if_must< mkey, name_separator, value > {};
       struct object_content : opt< list_tail< member, value_separator > > {};
       struct object : seq< begin_object, object_content, must< end_object > >
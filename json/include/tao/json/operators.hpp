@@ -4,12 +4,189 @@
 #ifndef TAO_JSON_OPERATORS_HPP
 #define TAO_JSON_OPERATORS_HPP
 
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
 #include "basic_value.hpp"
 
 #include "internal/format.hpp"
+#include "internal/type_traits.hpp"
 
 namespace tao::json
 {
+   namespace internal
+   {
+      template< bool Less, typename L, typename R >
+      [[nodiscard]] int compare_single( const L& lhs, const R& rhs ) noexcept
+      {
+         if constexpr( Less ) {
+            return ( lhs < rhs ) ? -1 : ( ( rhs < lhs ) ? 1 : 0 );
+         }
+         else {
+            return ( lhs == rhs ) ? 0 : 1;
+         }
+      }
+
+      template< template< typename... > class Traits >
+      [[nodiscard]] bool is_nested( const basic_value< Traits >& v ) noexcept
+      {
+         return v.is_array() || v.is_object() || v.is_value_ptr();
+      }
+
+      // Compares two Arrays or two Objects without nested Values, returns
+      // false when a nested Value is found before the result is known.
+
+      template< bool Less, template< typename... > class TraitsL, template< typename... > class TraitsR >
+      [[nodiscard]] bool compare_flat( const basic_value< TraitsL >& lhs, const basic_value< TraitsR >& rhs, int& result ) noexcept
+      {
+         if( lhs.is_array() ) {
+            const auto& la = lhs.unsafe_get_array();
+            const auto& ra = rhs.unsafe_get_array();
+            auto li = la.begin();
+            auto ri = ra.begin();
+            for( ; ( li != la.end() ) && ( ri != ra.end() ); ++li, ++ri ) {
+               if( is_nested( *li ) || is_nested( *ri ) ) {
+                  return false;
+               }
+               if( ( result = compare_single< Less >( *li, *ri ) ) != 0 ) {
+                  return true;
+               }
+            }
+            result = int( li != la.end() ) - int( ri != ra.end() );
+            return true;
+         }
+         const auto& lo = lhs.unsafe_get_object();
+         const auto& ro = rhs.unsafe_get_object();
+         auto li = lo.begin();
+         auto ri = ro.begin();
+         for( ; ( li != lo.end() ) && ( ri != ro.end() ); ++li, ++ri ) {
+            if( is_nested( li->second ) || is_nested( ri->second ) ) {
+               return false;
+            }
+            if( ( ( result = compare_single< Less >( li->first, ri->first ) ) != 0 ) || ( ( result = compare_single< Less >( li->second, ri->second ) ) != 0 ) ) {
+               return true;
+            }
+         }
+         result = int( li != lo.end() ) - int( ri != ro.end() );
+         return true;
+      }
+
+      // Compares two Arrays or two Objects with an explicit stack instead of
+      // recursion. The result is zero when they are equal, otherwise, when
+      // Less is true, negative or positive when lhs is less or greater than
+      // rhs, and non-zero when Less is false. Arrays and Objects without
+      // nested Values are compared without using the stack.
+
+      template< bool Less, template< typename... > class TraitsL, template< typename... > class TraitsR >
+      [[nodiscard]] int compare_nested( const basic_value< TraitsL >& lhs, const basic_value< TraitsR >& rhs ) noexcept
+      {
+         struct frame
+         {
+            const basic_value< TraitsL >* l;
+            const basic_value< TraitsR >* r;
+            typename basic_value< TraitsL >::array_t::const_iterator la;
+            typename basic_value< TraitsR >::array_t::const_iterator ra;
+            typename basic_value< TraitsL >::object_t::const_iterator lo;
+            typename basic_value< TraitsR >::object_t::const_iterator ro;
+         };
+         std::byte buffer[ 1024 ];
+         std::pmr::monotonic_buffer_resource resource( buffer, sizeof( buffer ) );
+         std::pmr::vector< frame > stack( &resource );
+         const basic_value< TraitsL >* l = &lhs;
+         const basic_value< TraitsR >* r = &rhs;
+         while( true ) {
+            if( l->is_array() ) {
+               const auto& la = l->unsafe_get_array();
+               const auto& ra = r->unsafe_get_array();
+               if( !Less && ( la.size() != ra.size() ) ) {
+                  return 1;
+               }
+               if( !is_same_storage( la, ra ) ) {
+                  int c;
+                  if( !compare_flat< Less >( *l, *r, c ) ) {
+                     stack.push_back( { l, r, la.begin(), ra.begin(), {}, {} } );
+                  }
+                  else if( c != 0 ) {
+                     return c;
+                  }
+               }
+            }
+            else {
+               const auto& lo = l->unsafe_get_object();
+               const auto& ro = r->unsafe_get_object();
+               if( !Less && ( lo.size() != ro.size() ) ) {
+                  return 1;
+               }
+               if( !is_same_storage( lo, ro ) ) {
+                  int c;
+                  if( !compare_flat< Less >( *l, *r, c ) ) {
+                     stack.push_back( { l, r, {}, {}, lo.begin(), ro.begin() } );
+                  }
+                  else if( c != 0 ) {
+                     return c;
+                  }
+               }
+            }
+            l = nullptr;
+            while( l == nullptr ) {
+               if( stack.empty() ) {
+                  return 0;
+               }
+               auto& f = stack.back();
+               bool lm;
+               bool rm;
+               if( f.l->is_array() ) {
+                  const auto le = f.l->unsafe_get_array().end();
+                  const auto re = f.r->unsafe_get_array().end();
+                  while( ( f.la != le ) && ( f.ra != re ) ) {
+                     const auto& x = ( f.la++ )->skip_value_ptr();
+                     const auto& y = ( f.ra++ )->skip_value_ptr();
+                     if( ( x.type() == y.type() ) && ( x.is_array() || x.is_object() ) ) {
+                        l = &x;
+                        r = &y;
+                        break;
+                     }
+                     if( const int c = compare_single< Less >( x, y ) ) {
+                        return c;
+                     }
+                  }
+                  lm = ( f.la != le );
+                  rm = ( f.ra != re );
+               }
+               else {
+                  const auto le = f.l->unsafe_get_object().end();
+                  const auto re = f.r->unsafe_get_object().end();
+                  while( ( f.lo != le ) && ( f.ro != re ) ) {
+                     if( const int c = compare_single< Less >( f.lo->first, f.ro->first ) ) {
+                        return c;
+                     }
+                     const auto& x = ( f.lo++ )->second.skip_value_ptr();
+                     const auto& y = ( f.ro++ )->second.skip_value_ptr();
+                     if( ( x.type() == y.type() ) && ( x.is_array() || x.is_object() ) ) {
+                        l = &x;
+                        r = &y;
+                        break;
+                     }
+                     if( const int c = compare_single< Less >( x, y ) ) {
+                        return c;
+                     }
+                  }
+                  lm = ( f.lo != le );
+                  rm = ( f.ro != re );
+               }
+               if( l == nullptr ) {
+                  if( lm != rm ) {
+                     return lm ? 1 : -1;
+                  }
+                  stack.pop_back();
+               }
+            }
+         }
+      }
+
+   }  // namespace internal
+
    template< template< typename... > class TraitsL, template< typename... > class TraitsR >
    [[nodiscard]] bool operator==( const basic_value< TraitsL >& lhs, const basic_value< TraitsR >& rhs ) noexcept
    {
@@ -137,10 +314,8 @@ namespace tao::json
             return lhs.unsafe_get_binary_view() == rhs.unsafe_get_binary_view();
 
          case type::ARRAY:
-            return lhs.unsafe_get_array() == rhs.unsafe_get_array();
-
          case type::OBJECT:
-            return lhs.unsafe_get_object() == rhs.unsafe_get_object();
+            return internal::compare_nested< false >( lhs, rhs ) == 0;
 
          case type::VALUE_PTR:
             assert( lhs.type() != type::VALUE_PTR );
@@ -352,10 +527,8 @@ namespace tao::json
             return lhs.unsafe_get_binary_view() < rhs.unsafe_get_binary_view();
 
          case type::ARRAY:
-            return lhs.unsafe_get_array() < rhs.unsafe_get_array();
-
          case type::OBJECT:
-            return lhs.unsafe_get_object() < rhs.unsafe_get_object();
+            return internal::compare_nested< true >( lhs, rhs ) < 0;
 
          case type::VALUE_PTR:
             assert( lhs.type() != type::VALUE_PTR );
@@ -0,0 +1,188 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_PARSE_NDJSON_HPP
+#define TAO_JSON_PARSE_NDJSON_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "external/pegtl/file_input.hpp"
+
+#include "events/from_string.hpp"
+
+namespace tao::json
+{
+   enum class ndjson_order : bool
+   {
+      unordered,
+      ordered
+   };
+
+   namespace internal
+   {
+      struct ndjson_batch
+      {
+         const char* begin;
+         const char* end;
+         std::size_t line;  // Of the first line in the batch.
+      };
+
+      // Splits the text into batches of complete lines of roughly the given size.
+      [[nodiscard]] inline std::vector< ndjson_batch > ndjson_batches( const std::string_view data, const std::size_t size )
+      {
+         std::vector< ndjson_batch > result;
+         const char* const e = data.data() + data.size();
+         std::size_t line = 1;
+         for( const char* p = data.data(); p != e; ) {
+            const char* q = p + std::min( size, std::size_t( e - p ) );
+            if( q != e ) {
+               const void* n = std::memchr( q, '\n', e - q );
+               q = n ? ( static_cast< const char* >( n ) + 1 ) : e;
+            }
+            result.push_back( { p, q, line } );
+            line += std::size_t( std::count( p, q, '\n' ) );
+            p = q;
+         }
+         return result;
+      }
+
+      [[nodiscard]] inline bool ndjson_blank( const char* p, const char* e ) noexcept
+      {
+         for( ; p != e; ++p ) {
+            if( ( *p != ' ' ) && ( *p != '\t' ) && ( *p != '\r' ) ) {
+               return false;
+            }
+         }
+         return true;
+      }
+
+   }  // namespace internal
+
+   // Parses newline-delimited JSON, i.e. a text with one JSON value per line,
+   // on multiple threads. The text is split into batches of complete lines
+   // that the threads take in turn whenever they are free. For every line
+   // that is not blank the factory is called on the parsing thread, which
+   // means concurrently, to create a consumer for the Events of the line.
+   // The handler is then called with the consumer and the line number, the
+   // calls are serialised and, for ndjson_order::ordered, in the order of
+   // the lines. Errors report the position within the whole text; the first
+   // exception, from the parser, the factory or the handler, stops all work
+   // and is rethrown after all threads have finished.
+
+   template< typename Factory, typename Handler >
+   void parse_ndjson( const std::string_view data, Factory&& factory, Handler&& handler, unsigned threads = 0, const ndjson_order order = ndjson_order::ordered, const char* source = nullptr )
+   {
+      using consumer_t = std::decay_t< decltype( factory() ) >;
+      using results_t = std::vector< std::pair< std::size_t, consumer_t > >;
+
+      if( threads == 0 ) {
+         threads = std::max( std::thread::hardware_concurrency(), 1U );
+      }
+      const auto batches = internal::ndjson_batches( data, std::max( data.size() / ( 16 * threads ) + 1, std::size_t( 1 ) << 16 ) );
+      threads = unsigned( std::min( std::size_t( threads ), batches.size() ) );
+      if( source == nullptr ) {
+         source = "tao::json::parse_ndjson";
+      }
+
+      std::atomic< std::size_t > next_batch( 0 );
+      std::atomic< bool > stop( false );
+      std::mutex mutex;
+      std::vector< results_t > pending( ( order == ndjson_order::ordered ) ? batches.size() : 0 );
+      std::vector< bool > ready( pending.size() );
+      std::size_t next_delivery = 0;
+      std::exception_ptr error;
+      std::size_t error_batch = batches.size();
+
+      const auto deliver = [ & ]( results_t& results ) {
+         for( auto& [ line, consumer ] : results ) {
+            handler( std::move( consumer ), line );
+         }
+         results.clear();
+      };
+
+      const auto worker = [ & ]() {
+         results_t results;
+         for( std::size_t i = next_batch++; ( i < batches.size() ) && !stop; i = next_batch++ ) {
+            try {
+               std::size_t line = batches[ i ].line;
+               for( const char* p = batches[ i ].begin; p != batches[ i ].end; ++line ) {
+                  const void* n = std::memchr( p, '\n', batches[ i ].end - p );
+                  const char* e = n ? static_cast< const char* >( n ) : batches[ i ].end;
+                  if( !internal::ndjson_blank( p, e ) ) {
+                     results.emplace_back( line, factory() );
+                     events::from_string( results.back().second, p, std::size_t( e - p ), source, std::size_t( p - data.data() ), line );
+                  }
+                  p = n ? ( e + 1 ) : e;
+               }
+               const std::lock_guard< std::mutex > lock( mutex );
+               if( order == ndjson_order::unordered ) {
+                  if( !stop ) {
+                     deliver( results );
+                  }
+                  results.clear();
+                  continue;
+               }
+               pending[ i ] = std::move( results );
+               results.clear();
+               ready[ i ] = true;
+               for( ; ( next_delivery < batches.size() ) && ready[ next_delivery ] && !stop; ++next_delivery ) {
+                  deliver( pending[ next_delivery ] );
+               }
+            }
+            catch( ... ) {
+               results.clear();
+               const std::lock_guard< std::mutex > lock( mutex );
+               if( i < error_batch ) {
+                  error = std::current_exception();
+                  error_batch = i;
+               }
+               stop = true;
+            }
+         }
+      };
+
+      std::vector< std::thread > pool;
+      try {
+         for( unsigned i = 1; i < threads; ++i ) {
+            pool.emplace_back( worker );
+         }
+      }
+      catch( ... ) {
+         // Continue with the threads that could be started.
+      }
+      worker();
+      for( auto& t : pool ) {
+         t.join();
+      }
+      if( error ) {
+         std::rethrow_exception( error );
+      }
+   }
+
+   template< typename Factory, typename Handler >
+   void parse_ndjson( const std::string_view data, Factory&& factory, Handler&& handler, const unsigned threads, const ndjson_order order, const std::string& source )
+   {
+      json::parse_ndjson( data, std::forward< Factory >( factory ), std::forward< Handler >( handler ), threads, order, source.c_str() );
+   }
+
+   template< typename Factory, typename Handler >
+   void parse_ndjson_file( const std::string& filename, Factory&& factory, Handler&& handler, const unsigned threads = 0, const ndjson_order order = ndjson_order::ordered )
+   {
+      const pegtl::file_input< pegtl::tracking_mode::lazy > in( filename );
+      json::parse_ndjson( std::string_view( in.begin(), in.size() ), std::forward< Factory >( factory ), std::forward< Handler >( handler ), threads, order, filename.c_str() );
+   }
+
+}  // namespace tao::json
+
+#endif
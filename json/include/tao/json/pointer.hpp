@@ -15,6 +15,7 @@
 #include "type.hpp"
 
 #include "external/pegtl.hpp"
+#include "internal/first_sor.hpp"
 #include "internal/format.hpp"
 
 namespace tao::json
@@ -138,11 +139,11 @@ namespace tao::json
       struct pointer_zero : pegtl::one< '0' > {};
       struct pointer_one : pegtl::one< '1' > {};
       struct pointer_tilde : pegtl::one< '~' > {};
-      struct pointer_escaped : pegtl::sor< pointer_zero, pointer_one > {};
+      struct pointer_escaped : first_sor< pointer_zero, pointer_one > {};
       struct pointer_slash : pegtl::one< '/' > {};
       struct pointer_char : pegtl::utf8::not_one< '/' > {};
       struct pointer_escape : pegtl::if_must< pointer_tilde, pointer_escaped > {};
-      struct pointer_token : pegtl::star< pegtl::sor< pointer_escape, pointer_char > > {};
+      struct pointer_token : pegtl::star< first_sor< pointer_escape, pointer_char > > {};
       struct pointer_rule : pegtl::until< pegtl::eof, pegtl::must< pointer_slash, pointer_token > > {};
       struct pointer_grammar : pegtl::must< pointer_rule > {};
       // clang-format on
@@ -59,6 +59,12 @@ namespace tao::json
 
       template< typename >
       using public_base = internal::empty_base;
+
+      template< typename V >
+      using array_t = std::vector< V >;
+
+      template< typename V >
+      using object_t = std::map< std::string, V, std::less<> >;
    };
 
    template<>
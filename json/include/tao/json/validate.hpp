@@ -0,0 +1,421 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_VALIDATE_HPP
+#define TAO_JSON_VALIDATE_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "internal/indexed_parser.hpp"
+#include "internal/scan_string.hpp"
+
+namespace tao::json
+{
+   struct validate_options
+   {
+      std::size_t max_nesting_depth = 0;  // Zero means unlimited.
+      bool allow_trailing = false;  // Whether the value can be followed by other text.
+      bool allow_infinite = false;  // Whether numbers that overflow a double are accepted.
+   };
+
+   struct validate_result
+   {
+      bool success;
+      std::size_t offset;  // Of the error, or of the end of the value.
+
+      [[nodiscard]] explicit operator bool() const noexcept
+      {
+         return success;
+      }
+   };
+
+   namespace internal
+   {
+      // Checks a JSON text in a single pass without Events and without any
+      // conversions, with the same rules as the grammar and internal::action
+      // including the limits for the number of digits; the functions return
+      // the position after the checked part, or nullptr after setting m_error.
+
+      class validator
+      {
+      public:
+         validator( const char* begin, const char* end, const std::size_t max_nesting_depth, const bool allow_infinite = false ) noexcept
+            : m_end( end ),
+              m_max( max_nesting_depth ),
+              m_infinite( allow_infinite ),
+              m_error( begin )
+         {}
+
+         [[nodiscard]] const char* error() const noexcept
+         {
+            return m_error;
+         }
+
+         [[nodiscard]] const char* whitespace( const char* p ) const noexcept
+         {
+            while( ( p != m_end ) && ( ( *p == ' ' ) || ( *p == '\t' ) || ( *p == '\n' ) || ( *p == '\r' ) ) ) {
+               ++p;
+            }
+            return p;
+         }
+
+         // Checks the value at p, which must not be whitespace, and returns
+         // the position after the value.
+         [[nodiscard]] const char* value( const char* p )
+         {
+            for( ;; ) {
+               if( p == m_end ) {
+                  return fail( p );
+               }
+               switch( *p ) {
+                  case '[':
+                     if( !push( '[', p ) ) {
+                        return nullptr;
+                     }
+                     p = whitespace( p + 1 );
+                     if( ( p != m_end ) && ( *p == ']' ) ) {
+                        m_stack.pop_back();
+                        ++p;
+                        break;
+                     }
+                     continue;
+                  case '{':
+                     if( !push( '{', p ) ) {
+                        return nullptr;
+                     }
+                     p = whitespace( p + 1 );
+                     if( ( p != m_end ) && ( *p == '}' ) ) {
+                        m_stack.pop_back();
+                        ++p;
+                        break;
+                     }
+                     if( !( p = key( p ) ) ) {
+                        return nullptr;
+                     }
+                     continue;
+                  case '"':
+                     p = string( p + 1 );
+                     break;
+                  case 'n':
+                     p = literal( p, "null" );
+                     break;
+                  case 't':
+                     p = literal( p, "true" );
+                     break;
+                  case 'f':
+                     p = literal( p, "false" );
+                     break;
+                  case '-':
+                     p = number( p + 1 );
+                     break;
+                  default:
+                     p = number( p );
+               }
+               if( !( p = end_value( p ) ) ) {
+                  return nullptr;
+               }
+               if( m_stack.empty() ) {
+                  return p;
+               }
+            }
+         }
+
+      private:
+         const char* m_end;
+         std::size_t m_max;
+         bool m_infinite;
+         const char* m_error;
+         std::vector< char > m_stack;
+
+         [[nodiscard]] const char* fail( const char* p ) noexcept
+         {
+            m_error = p;
+            return nullptr;
+         }
+
+         [[nodiscard]] static bool is_digit( const char c ) noexcept
+         {
+            return ( '0' <= c ) && ( c <= '9' );
+         }
+
+         [[nodiscard]] bool push( const char c, const char* p )
+         {
+            if( ( m_max != 0 ) && ( m_stack.size() == m_max ) ) {
+               m_error = p;
+               return false;
+            }
+            m_stack.push_back( c );
+            return true;
+         }
+
+         [[nodiscard]] const char* digits( const char* p ) const noexcept
+         {
+            while( ( p != m_end ) && is_digit( *p ) ) {
+               ++p;
+            }
+            return p;
+         }
+
+         [[nodiscard]] const char* literal( const char* p, const std::string_view l ) noexcept
+         {
+            if( ( std::size_t( m_end - p ) < l.size() ) || ( l.compare( 0, l.size(), p, l.size() ) != 0 ) ) {
+               return fail( p );
+            }
+            return p + l.size();
+         }
+
+         // Checks whether the number does not overflow to infinity, which the
+         // parser rejects, given the integer and fraction digits and the value
+         // of the exponent; the smallest such number is 2^1024 - 2^970, all of
+         // its 309 digits are significant and numbers up to 10^308 are finite.
+         [[nodiscard]] static bool finite( const char* ib, const char* ie, const char* fb, const char* fe, long long e ) noexcept
+         {
+            static constexpr std::string_view limit =
+               "179769313486231580793728971405303415079934132710037826936173778980444968292764750946649017977587207096330286416692887910946555547851940402630657488671505820681908902000708383676273854845817711531764475730270069855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497792";
+
+            const char* s = ib;
+            if( *ib == '0' ) {
+               for( s = fb; ( s != fe ) && ( *s == '0' ); ++s ) {
+               }
+               if( s == fe ) {
+                  return true;
+               }
+               e -= s - fb;
+            }
+            else {
+               e += ie - ib;
+            }
+            if( e != 309 ) {
+               return e < 309;
+            }
+            for( std::size_t i = 0; i < 309; ++i ) {
+               if( s == ie ) {
+                  s = fb;
+               }
+               const char c = ( s == fe ) ? '0' : *s++;
+               if( c != limit[ i ] ) {
+                  return c < limit[ i ];
+               }
+            }
+            return false;
+         }
+
+         [[nodiscard]] const char* number( const char* p ) noexcept
+         {
+            if( ( p == m_end ) || !is_digit( *p ) ) {
+               return fail( p );
+            }
+            const char* ib = p;
+            if( *p == '0' ) {
+               ++p;
+            }
+            else {
+               p = digits( p );
+               if( p - ib > ( 1 << 20 ) ) {
+                  return fail( ib );
+               }
+            }
+            const char* ie = p;
+            const char* fb = p;
+            const char* fe = p;
+            if( ( p != m_end ) && ( *p == '.' ) ) {
+               fb = ++p;
+               if( ( fe = p = digits( p ) ) == fb ) {
+                  return fail( p );
+               }
+            }
+            long long x = 0;
+            if( ( p != m_end ) && ( ( *p == 'e' ) || ( *p == 'E' ) ) ) {
+               bool neg = false;
+               if( ( ++p != m_end ) && ( ( *p == '+' ) || ( *p == '-' ) ) ) {
+                  neg = ( *p++ == '-' );
+               }
+               const char* e = p;
+               if( ( p = digits( p ) ) == e ) {
+                  return fail( p );
+               }
+               while( ( e < p ) && ( *e == '0' ) ) {
+                  ++e;
+               }
+               if( p - e > 9 ) {
+                  return fail( e );
+               }
+               for( ; e != p; ++e ) {
+                  x = x * 10 + ( *e - '0' );
+               }
+               x = neg ? -x : x;
+            }
+            if( !m_infinite && !finite( ib, ie, fb, fe, x ) ) {
+               return fail( ib );
+            }
+            return p;
+         }
+
+         [[nodiscard]] static long hex4( const char* h ) noexcept
+         {
+            long r = 0;
+            for( int i = 0; i < 4; ++i ) {
+               const char c = h[ i ];
+               r <<= 4;
+               if( is_digit( c ) ) {
+                  r += c - '0';
+               }
+               else if( ( 'a' <= c ) && ( c <= 'f' ) ) {
+                  r += c - 'a' + 10;
+               }
+               else if( ( 'A' <= c ) && ( c <= 'F' ) ) {
+                  r += c - 'A' + 10;
+               }
+               else {
+                  return -1;
+               }
+            }
+            return r;
+         }
+
+         [[nodiscard]] const char* escape( const char* p ) noexcept
+         {
+            if( m_end - p < 2 ) {
+               return fail( p );
+            }
+            switch( p[ 1 ] ) {
+               case '"':
+               case '\\':
+               case '/':
+               case 'b':
+               case 'f':
+               case 'n':
+               case 'r':
+               case 't':
+                  return p + 2;
+               case 'u': {
+                  const long c = ( m_end - p < 6 ) ? -1 : hex4( p + 2 );
+                  if( ( c < 0 ) || ( ( 0xdc00 <= c ) && ( c <= 0xdfff ) ) ) {
+                     return fail( p );
+                  }
+                  if( ( 0xd800 <= c ) && ( c <= 0xdbff ) ) {
+                     if( ( m_end - p < 12 ) || ( p[ 6 ] != '\\' ) || ( p[ 7 ] != 'u' ) ) {
+                        return fail( p );
+                     }
+                     const long d = hex4( p + 8 );
+                     if( ( d < 0xdc00 ) || ( d > 0xdfff ) ) {
+                        return fail( p );
+                     }
+                     return p + 12;
+                  }
+                  return p + 6;
+               }
+               default:
+                  return fail( p );
+            }
+         }
+
+         [[nodiscard]] const char* string( const char* p ) noexcept
+         {
+            for( ;; ) {
+               p += scan_string< '"' >( p, m_end - p );
+               if( p == m_end ) {
+                  return fail( p );
+               }
+               const auto c = static_cast< unsigned char >( *p );
+               if( c == '"' ) {
+                  return p + 1;
+               }
+               if( c == '\\' ) {
+                  if( !( p = escape( p ) ) ) {
+                     return nullptr;
+                  }
+                  continue;
+               }
+               if( c < 0x20 ) {
+                  return fail( p );
+               }
+               const std::size_t n = utf8_sequence( p, m_end - p );
+               if( n == 0 ) {
+                  return fail( p );
+               }
+               p += n;
+            }
+         }
+
+         // Checks a key, the name separator and the whitespace around it.
+         [[nodiscard]] const char* key( const char* p ) noexcept
+         {
+            if( ( p == m_end ) || ( *p != '"' ) ) {
+               return fail( p );
+            }
+            if( !( p = string( p + 1 ) ) ) {
+               return nullptr;
+            }
+            p = whitespace( p );
+            if( ( p == m_end ) || ( *p != ':' ) ) {
+               return fail( p );
+            }
+            return whitespace( p + 1 );
+         }
+
+         // Finishes the Arrays and Objects that end after the value that
+         // ended at p; returns the start of the next element or member value,
+         // or the position after the value at the top level.
+         [[nodiscard]] const char* end_value( const char* p )
+         {
+            if( p == nullptr ) {
+               return nullptr;
+            }
+            for( ;; ) {
+               if( m_stack.empty() ) {
+                  return p;
+               }
+               p = whitespace( p );
+               if( p == m_end ) {
+                  return fail( p );
+               }
+               if( *p == ',' ) {
+                  p = whitespace( p + 1 );
+                  return ( m_stack.back() == '{' ) ? key( p ) : p;
+               }
+               if( *p != ( ( m_stack.back() == '[' ) ? ']' : '}' ) ) {
+                  return fail( p );
+               }
+               m_stack.pop_back();
+               ++p;
+            }
+         }
+      };
+
+   }  // namespace internal
+
+   // Checks whether the text is a valid JSON text, i.e. a JSON value with
+   // optional whitespace around it, without calling any Events Interface
+   // functions and without converting anything. It accepts the same texts
+   // as events::from_string(), only faster, and returns the offset of the
+   // first character that can not be part of a valid text on failure.
+   // With allow_trailing the text only needs to start with a JSON value,
+   // which is e.g. useful to find JSON values embedded in other text, the
+   // offset on success is the end of the value in both cases. With
+   // allow_infinite numbers that are too large for a double are accepted,
+   // e.g. for consumers that use number_raw(), or to let the parser report
+   // the error when the text is parsed after checking it.
+
+   [[nodiscard]] inline validate_result validate( const std::string_view text, const validate_options& options = validate_options() )
+   {
+      const char* const b = text.data();
+      const char* const e = b + text.size();
+      internal::validator v( b, e, options.max_nesting_depth, options.allow_infinite );
+      const char* p = v.value( v.whitespace( b ) );
+      if( p == nullptr ) {
+         return { false, std::size_t( v.error() - b ) };
+      }
+      if( !options.allow_trailing ) {
+         if( const char* q = v.whitespace( p ); q != e ) {
+            return { false, std::size_t( q - b ) };
+         }
+      }
+      return { true, std::size_t( p - b ) };
+   }
+
+}  // namespace tao::json
+
+#endif
@@ -0,0 +1,66 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#ifndef TAO_JSON_VALUE_PARSER_HPP
+#define TAO_JSON_VALUE_PARSER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "events/from_string.hpp"
+#include "events/to_value.hpp"
+#include "events/transformer.hpp"
+
+namespace tao::json
+{
+   // Parses one JSON text after the other into a Value, reusing the same
+   // consumer so that the stacks for nested arrays, objects and keys keep
+   // their capacity across documents. This avoids the allocations that a
+   // new events::to_basic_value performs for every call to from_string()
+   // when parsing many small documents, e.g. one per line.
+
+   // The returned reference is valid until the next call to parse() or
+   // reset(); the Value can be moved out with value(). The Transformers
+   // are only constructed once and must be stateless across documents.
+
+   template< template< typename... > class Traits, template< typename... > class... Transformers >
+   class basic_value_parser
+   {
+   public:
+      [[nodiscard]] const basic_value< Traits >& parse( const std::string_view data, const char* source = nullptr )
+      {
+         m_consumer.reset();
+         events::from_string( m_consumer, data.data(), data.size(), source );
+         return m_consumer.value;
+      }
+
+      [[nodiscard]] const basic_value< Traits >& parse( const std::string_view data, const std::string& source )
+      {
+         return parse( data, source.c_str() );
+      }
+
+      [[nodiscard]] basic_value< Traits >& value() noexcept
+      {
+         return m_consumer.value;
+      }
+
+      [[nodiscard]] const basic_value< Traits >& value() const noexcept
+      {
+         return m_consumer.value;
+      }
+
+      void reset() noexcept
+      {
+         m_consumer.reset();
+      }
+
+   private:
+      events::transformer< events::to_basic_value< Traits >, Transformers... > m_consumer;
+   };
+
+   using value_parser = basic_value_parser< traits >;
+
+}  // namespace tao::json
+
+#endif
@@ -0,0 +1,85 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include <cstdint>
+#include <string>
+
+#include <tao/json.hpp>
+
+#include "bench_mark.hpp"
+
+// Compares parsing into a struct with 40 members via the binding, directly
+// with consume_string() and via a value, with a handwritten parser that
+// uses the parts_parser and knows the structure of the keys.
+
+struct request
+{
+   std::int64_t i0, i1, i2, i3, i4, i5, i6, i7, i8, i9;
+   std::string s0, s1, s2, s3, s4, s5, s6, s7, s8, s9;
+   double d0, d1, d2, d3, d4, d5, d6, d7, d8, d9;
+   bool b0, b1, b2, b3, b4, b5, b6, b7, b8, b9;
+};
+
+#define BIND4( N ) TAO_JSON_BIND_REQUIRED( "int_" #N, &request::i##N ), TAO_JSON_BIND_REQUIRED( "string_" #N, &request::s##N ), TAO_JSON_BIND_REQUIRED( "double_" #N, &request::d##N ), TAO_JSON_BIND_REQUIRED( "bool_" #N, &request::b##N )
+
+namespace tao::json
+{
+   template<>
+   struct traits< request >
+      : binding::object< BIND4( 0 ), BIND4( 1 ), BIND4( 2 ), BIND4( 3 ), BIND4( 4 ), BIND4( 5 ), BIND4( 6 ), BIND4( 7 ), BIND4( 8 ), BIND4( 9 ) >
+   {};
+
+}  // namespace tao::json
+
+#undef BIND4
+
+[[nodiscard]] request handwritten( const std::string& text )
+{
+   static constexpr std::int64_t request::*ints[] = { &request::i0, &request::i1, &request::i2, &request::i3, &request::i4, &request::i5, &request::i6, &request::i7, &request::i8, &request::i9 };
+   static constexpr std::string request::*strings[] = { &request::s0, &request::s1, &request::s2, &request::s3, &request::s4, &request::s5, &request::s6, &request::s7, &request::s8, &request::s9 };
+   static constexpr double request::*doubles[] = { &request::d0, &request::d1, &request::d2, &request::d3, &request::d4, &request::d5, &request::d6, &request::d7, &request::d8, &request::d9 };
+   static constexpr bool request::*bools[] = { &request::b0, &request::b1, &request::b2, &request::b3, &request::b4, &request::b5, &request::b6, &request::b7, &request::b8, &request::b9 };
+
+   request r;
+   tao::json::parts_parser p( text, "handwritten" );
+   auto s = p.begin_object();
+   while( p.member_or_end_object( s ) ) {
+      const auto k = p.key();
+      const auto n = k.back() - '0';
+      switch( k[ 0 ] ) {
+         case 'i':
+            r.*ints[ n ] = p.number_signed();
+            break;
+         case 's':
+            r.*strings[ n ] = p.string();
+            break;
+         case 'd':
+            r.*doubles[ n ] = p.number_double();
+            break;
+         default:
+            r.*bools[ n ] = p.boolean();
+      }
+   }
+   return r;
+}
+
+int main()
+{
+   std::string text = "{";
+   for( int i = 0; i < 10; ++i ) {
+      const auto n = std::to_string( i );
+      text += "\"int_" + n + "\":" + std::to_string( i * 12345 ) + ",\"string_" + n + "\":\"value " + n + "\",\"double_" + n + "\":" + n + ".25,\"bool_" + n + "\":true,";
+   }
+   text.back() = '}';
+
+   const auto ref = tao::bench::mark( "handwritten", "request", [&]() {
+      (void)handwritten( text );
+   } );
+   tao::bench::mark( "consume", "request", [&]() {
+      (void)tao::json::consume_string< request >( text );
+   }, ref );
+   tao::bench::mark( "value", "request", [&]() {
+      (void)tao::json::from_string( text ).as< request >();
+   }, ref );
+   return 0;
+}
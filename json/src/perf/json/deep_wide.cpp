@@ -0,0 +1,105 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include <tao/json.hpp>
+
+#include "bench_mark.hpp"
+
+// Compares the traversals of basic_value that use an explicit stack, i.e.
+// events::from_value(), the comparison operators and the destructor, with
+// recursive implementations on a deep and on a wide document. Note that
+// for the deep document the results depend on whether the allocator keeps
+// the memory for the explicit stack between iterations, with glibc compare
+// with MALLOC_MMAP_THRESHOLD_=1000000000 in the environment.
+
+void recursive_from_value( tao::json::events::discard& consumer, const tao::json::value& v )
+{
+   tao::json::events::from_value< &recursive_from_value >( consumer, v );
+}
+
+bool recursive_equal( const tao::json::value& l, const tao::json::value& r )
+{
+   if( l.type() != r.type() ) {
+      return false;
+   }
+   switch( l.type() ) {
+      case tao::json::type::ARRAY:
+         return std::equal( l.unsafe_get_array().begin(), l.unsafe_get_array().end(), r.unsafe_get_array().begin(), r.unsafe_get_array().end(), &recursive_equal );
+      case tao::json::type::OBJECT:
+         return std::equal( l.unsafe_get_object().begin(), l.unsafe_get_object().end(), r.unsafe_get_object().begin(), r.unsafe_get_object().end(), []( const auto& a, const auto& b ) { return ( a.first == b.first ) && recursive_equal( a.second, b.second ); } );
+      default:
+         return l == r;
+   }
+}
+
+tao::json::value make_deep( const std::size_t depth )
+{
+   tao::json::value v = 0;
+   for( std::size_t i = 0; i < depth; ++i ) {
+      tao::json::value n;
+      if( i % 2 ) {
+         n.emplace( "k", std::move( v ) );
+      }
+      else {
+         n.emplace_back( std::move( v ) );
+      }
+      v = std::move( n );
+   }
+   return v;
+}
+
+tao::json::value make_wide( const std::size_t width )
+{
+   tao::json::value v = tao::json::empty_array;
+   v.get_array().reserve( width );
+   for( std::size_t i = 0; i < width; ++i ) {
+      if( i % 2 ) {
+         v.emplace_back( i );
+      }
+      else {
+         v.emplace_back( tao::json::value::array( { i } ) );
+      }
+   }
+   return v;
+}
+
+void bench( const std::string& type, const tao::json::value& v )
+{
+   const tao::json::value w = v;
+
+   const auto r1 = tao::bench::mark( "recursive", "from_value " + type, [&]() {
+      tao::json::events::discard consumer;
+      recursive_from_value( consumer, v );
+   } );
+   tao::bench::mark( "iterative", "from_value " + type, [&]() {
+      tao::json::events::discard consumer;
+      tao::json::events::from_value( consumer, v );
+   }, r1 );
+
+   const auto r2 = tao::bench::mark( "recursive", "equal      " + type, [&]() {
+      (void)recursive_equal( v, w );
+   } );
+   tao::bench::mark( "iterative", "equal      " + type, [&]() {
+      (void)( v == w );
+   }, r2 );
+
+   tao::bench::mark( "iterative", "less       " + type, [&]() {
+      (void)( v < w );
+   } );
+   tao::bench::mark( "iterative", "copy+free  " + type, [&]() {
+      const auto c = v;
+      (void)c;
+   } );
+}
+
+int main()
+{
+   bench( "deep 10k", make_deep( 10000 ) );
+   bench( "wide 1M ", make_wide( 1000000 ) );
+   return 0;
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <tao/json.hpp>
+#include <tao/json/contrib/lazy_value.hpp>
+
+#include "bench_mark.hpp"
+
+int main( int argc, char** argv )
+{
+   if( argc < 3 ) {
+      std::cerr << "usage: " << argv[ 0 ] << " file pointer..." << std::endl;
+      return 1;
+   }
+   const std::string text = tao::json::pegtl::internal::file_reader( argv[ 1 ] ).read();
+   std::vector< tao::json::pointer > pointers;
+   for( int i = 2; i < argc; ++i ) {
+      pointers.emplace_back( argv[ i ] );
+   }
+   const auto ref = tao::bench::mark( "value", argv[ 1 ], [&]() {
+      const auto v = tao::json::from_string( text );
+      for( const auto& p : pointers ) {
+         (void)v.at( p ).as< std::string >();
+      }
+   } );
+   tao::bench::mark( "lazy", argv[ 1 ], [&]() {
+      const tao::json::lazy_document d( text );
+      for( const auto& p : pointers ) {
+         (void)d.root().at( p ).get_string();
+      }
+   }, ref );
+   tao::bench::mark( "trusted", argv[ 1 ], [&]() {
+      const tao::json::lazy_document d( text, tao::json::lazy_document::trusted );
+      for( const auto& p : pointers ) {
+         (void)d.root().at( p ).get_string();
+      }
+   }, ref );
+   return 0;
+}
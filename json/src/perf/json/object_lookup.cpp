@@ -0,0 +1,79 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <tao/json.hpp>
+#include <tao/json/contrib/flat_object.hpp>
+#include <tao/json/contrib/hash_object.hpp>
+
+#include "bench_mark.hpp"
+
+// Compares the object storages on lookups in an Object with many members,
+// e.g. an id-to-record map. The keys are looked up in a scrambled order,
+// directly and with JSON Pointers that go through the Object.
+
+volatile std::size_t found = 0;
+
+std::string make_text( const std::size_t size )
+{
+   std::string text = "{";
+   for( std::size_t i = 0; i < size; ++i ) {
+      text += "\"id" + std::to_string( i ) + "\":{\"id\":" + std::to_string( i ) + ",\"name\":\"record\"},";
+   }
+   text.back() = '}';
+   return text;
+}
+
+template< template< typename... > class Traits >
+std::uint64_t bench( const std::string& type, const std::string& text, const std::vector< std::string >& keys, const std::vector< tao::json::pointer >& pointers, const std::uint64_t ref )
+{
+   const auto v = tao::json::basic_from_string< Traits >( text );
+
+   tao::bench::mark( "parse", type, [&]() {
+      (void)tao::json::basic_from_string< Traits >( text );
+   } );
+   const auto r = tao::bench::mark( "find", type, [&]() {
+      std::size_t n = 0;
+      for( const auto& k : keys ) {
+         n += ( v.find( k ) != nullptr );
+      }
+      found = n;
+   }, ref );
+   tao::bench::mark( "pointer", type, [&]() {
+      std::size_t n = 0;
+      for( const auto& p : pointers ) {
+         n += v.at( p ).get_unsigned();
+      }
+      found = n;
+   } );
+   tao::bench::mark( "miss", type, [&]() {
+      std::size_t n = 0;
+      for( const auto& k : keys ) {
+         n += ( v.find( k + 'x' ) != nullptr );
+      }
+      found = n;
+   } );
+   return r;
+}
+
+int main( int argc, char** argv )
+{
+   const std::size_t size = ( argc > 1 ) ? std::stoul( argv[ 1 ] ) : 100000;
+   const std::string text = make_text( size );
+
+   std::vector< std::string > keys;
+   std::vector< tao::json::pointer > pointers;
+   for( std::size_t i = 0; i < size; ++i ) {
+      const auto k = "id" + std::to_string( ( i * 7919 ) % size );
+      keys.emplace_back( k );
+      pointers.emplace_back( "/" + k + "/id" );
+   }
+   const auto r = bench< tao::json::traits >( "map  " + std::to_string( size ), text, keys, pointers, 0 );
+   bench< tao::json::flat_traits >( "flat " + std::to_string( size ), text, keys, pointers, r );
+   bench< tao::json::hash_traits >( "hash " + std::to_string( size ), text, keys, pointers, r );
+   return 0;
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include <tao/json.hpp>
+#include <tao/json/contrib/flat_object.hpp>
+#include <tao/json/contrib/hash_object.hpp>
+#include <tao/json/contrib/interned_key.hpp>
+#include <tao/json/contrib/shared_value.hpp>
+
+#include "bench_mark.hpp"
+
+template< template< typename... > class Traits >
+std::size_t visit( const tao::json::basic_value< Traits >& v )
+{
+   std::size_t r = 1;
+   if( v.is_array() ) {
+      for( const auto& e : v.unsafe_get_array() ) {
+         r += visit( e );
+      }
+   }
+   else if( v.is_object() ) {
+      for( const auto& e : v.unsafe_get_object() ) {
+         r += e.first.size() + visit( e.second );
+      }
+   }
+   return r;
+}
+
+template< template< typename... > class Traits >
+void bench( const std::string& type, const std::string& file )
+{
+   tao::bench::mark( "parse", type + ' ' + file, [&]() {
+      tao::json::events::to_basic_value< Traits > consumer;
+      tao::json::events::parse_file( consumer, file );
+   } );
+
+   tao::json::events::to_basic_value< Traits > consumer;
+   tao::json::events::parse_file( consumer, file );
+   const auto& v = consumer.value;
+
+   tao::bench::mark( "iterate", type + ' ' + file, [&]() {
+      (void)visit( v );
+   } );
+   tao::bench::mark( "copy", type + ' ' + file, [&]() {
+      const auto c = v;
+      (void)c;
+   } );
+}
+
+int main( int argc, char** argv )
+{
+   for( int i = 1; i < argc; ++i ) {
+      bench< tao::json::traits >( "map ", argv[ i ] );
+      bench< tao::json::flat_traits >( "flat", argv[ i ] );
+      bench< tao::json::hash_traits >( "hash", argv[ i ] );
+      bench< tao::json::interned_traits >( "intd", argv[ i ] );
+      bench< tao::json::shared_traits >( "shrd", argv[ i ] );
+   }
+   return 0;
+}
@@ -0,0 +1,22 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include <tao/json.hpp>
+#include <tao/json/contrib/arena_value.hpp>
+
+#include "bench_mark.hpp"
+
+int main( int argc, char** argv )
+{
+   for( int i = 1; i < argc; ++i ) {
+      const auto ref = tao::bench::mark( "value", argv[ i ], [&]() {
+         tao::json::events::to_value consumer;
+         tao::json::events::parse_file( consumer, argv[ i ] );
+      } );
+      tao::bench::mark( "arena", argv[ i ], [&]() {
+         tao::json::arena_document document;
+         document.parse_file( argv[ i ] );
+      }, ref );
+   }
+   return 0;
+}
@@ -8,10 +8,15 @@
 int main( int argc, char** argv )
 {
    for( int i = 1; i < argc; ++i ) {
+      const auto ref = tao::bench::mark( "eager", argv[ i ], [&]() {
+         tao::json::events::to_value consumer;
+         tao::json::pegtl::file_input< tao::json::pegtl::tracking_mode::eager > in( argv[ i ] );
+         tao::json::pegtl::parse< tao::json::internal::grammar, tao::json::internal::action, tao::json::internal::errors >( in, consumer );
+      } );
       tao::bench::mark( "json", argv[ i ], [&]() {
          tao::json::events::to_value consumer;
          tao::json::events::parse_file( consumer, argv[ i ] );
-      } );
+      }, ref );
    }
    return 0;
 }
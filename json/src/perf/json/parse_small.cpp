@@ -0,0 +1,33 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include <string>
+#include <vector>
+
+#include <tao/json.hpp>
+
+#include "bench_mark.hpp"
+
+// Parses many documents of about 100 bytes each, as in a log stream with
+// one document per line, with a new consumer per document and with one
+// value_parser that is reused for all documents.
+
+int main()
+{
+   std::vector< std::string > lines;
+   for( int i = 0; i < 1000; ++i ) {
+      lines.emplace_back( "{\"timestamp\":" + std::to_string( 1546300800 + i ) + ",\"level\":\"info\",\"request_id\":\"" + std::to_string( i * 7919 ) + "\",\"tags\":[\"a\",\"b\"],\"ok\":true}" );
+   }
+   const auto ref = tao::bench::mark( "from_string", "100 byte documents", [&]() {
+      for( const auto& line : lines ) {
+         (void)tao::json::from_string( line );
+      }
+   } );
+   tao::json::value_parser p;
+   tao::bench::mark( "value_parser", "100 byte documents", [&]() {
+      for( const auto& line : lines ) {
+         (void)p.parse( line );
+      }
+   }, ref );
+   return 0;
+}
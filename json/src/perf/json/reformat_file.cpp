@@ -0,0 +1,31 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include <tao/json.hpp>
+
+#include "bench_mark.hpp"
+
+// Compares parsing and writing JSON with numbers that are converted and
+// printed again, with the unconverted text passed to number_raw().
+
+struct converted
+   : tao::json::events::to_string
+{
+   static constexpr bool disable_number_raw = true;
+};
+
+int main( int argc, char** argv )
+{
+   for( int i = 1; i < argc; ++i ) {
+      const auto r = tao::bench::mark( "converted", argv[ i ], [&]() {
+         converted consumer;
+         tao::json::events::parse_file( consumer, argv[ i ] );
+      } );
+      tao::bench::mark( "raw", argv[ i ], [&]() {
+         tao::json::events::to_string consumer;
+         tao::json::events::parse_file( consumer, argv[ i ] );
+      },
+      r );
+   }
+   return 0;
+}
@@ -4,6 +4,7 @@
 #include <iostream>
 
 #include <tao/json.hpp>
+#include <tao/json/contrib/compact_value.hpp>
 
 #define PRINT_SIZE( ... ) \
    std::cout << #__VA_ARGS__ << " size " << sizeof( __VA_ARGS__ ) << " align " << alignof( __VA_ARGS__ ) << std::endl;
@@ -15,6 +16,7 @@ int main( int /*unused*/, char** /*unused*/ )
    PRINT_SIZE( tao::json::value );
    PRINT_SIZE( std::vector< tao::json::value > );
    PRINT_SIZE( std::map< std::string, tao::json::value > );
+   PRINT_SIZE( tao::json::compact_value );
    PRINT_SIZE( tao::json::token );
    PRINT_SIZE( tao::json::pointer );
    return 0;
@@ -22,6 +22,13 @@ int main( int argc, char** argv )
          tao::json::events::parse_file( consumer, argv[ i ] );
       },
       r );
+      tao::bench::mark( "validate", argv[ i ], [&]() {
+         pegtl::file_input< pegtl::tracking_mode::lazy > in( argv[ i ] );
+         if( !tao::json::validate( std::string_view( in.begin(), in.size() ) ) ) {
+            throw std::runtime_error( "invalid JSON" );
+         }
+      },
+      r );
    }
    return 0;
 }
@@ -0,0 +1,77 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <sstream>
+
+#include <tao/json/contrib/arena_value.hpp>
+#include <tao/json/events/to_string.hpp>
+#include <tao/json/from_string.hpp>
+#include <tao/json/to_string.hpp>
+
+namespace tao::json
+{
+   std::string to_text( const arena_value& v )
+   {
+      std::ostringstream o;
+      o << v;
+      return o.str();
+   }
+
+   void test_access()
+   {
+      const auto d = arena_from_string( "{\"b\":[1,-2,3.5,\"x\",null,true],\"a\":{\"c\":\"string\"},\"\":{}}" );
+      const auto& v = d.value();
+      TEST_ASSERT( v.is_object() );
+      TEST_ASSERT( v.get_object().size() == 3 );
+      TEST_ASSERT( v.get_object().begin()->first.empty() );
+      TEST_ASSERT( v.at( "b" ).get_array().size() == 6 );
+      TEST_ASSERT( v.at( "b" ).at( 0 ).get_unsigned() == 1 );
+      TEST_ASSERT( v.at( "b" ).at( 1 ).get_signed() == -2 );
+      TEST_ASSERT( v.at( "b" ).at( 2 ).get_double() == 3.5 );
+      TEST_ASSERT( v[ "b" ][ 3 ].get_string_type() == "x" );
+      TEST_ASSERT( v[ "b" ][ 4 ].is_null() );
+      TEST_ASSERT( v[ "b" ][ 5 ].get_boolean() );
+      TEST_ASSERT( v.at( pointer( "/a/c" ) ).get_string_type() == "string" );
+      TEST_ASSERT( v.at( "" ).get_object().empty() );
+      TEST_ASSERT( v.find( "d" ) == nullptr );
+      TEST_ASSERT( v.find( pointer( "/b/6" ) ) == nullptr );
+      TEST_THROWS( v.at( "d" ) );
+      TEST_THROWS( v.at( "b" ).at( 6 ) );
+      TEST_THROWS( v.at( "a" ).get_array() );
+      TEST_ASSERT( to_text( v ) == "{\"\":{},\"a\":{\"c\":\"string\"},\"b\":[1,-2,3.5,\"x\",null,true]}" );
+   }
+
+   void test_document()
+   {
+      const std::string text = "[{\"z\":[],\"y\":[[],[[]]]},\"some longer string that will not fit\",[1,2,3],{}]";
+      arena_document d( 64 );
+      d.from_string( text );
+      TEST_ASSERT( d.value().is_array() );
+      TEST_ASSERT( d.value() == arena_from_string( text ).value() );
+      TEST_ASSERT( d.value() != arena_from_string( "[1,2,3]" ).value() );
+      TEST_ASSERT( to_text( d.value() ) == to_string( from_string( text ) ) );
+
+      d.from_string( "[1]" );
+      TEST_ASSERT( d.value().at( 0 ) == arena_from_string( "1.0" ).value() );
+      d.reset();
+      TEST_ASSERT( d.value().is_uninitialized() );
+
+      events::to_string consumer;
+      events::from_arena_value( consumer, arena_from_string( text ).value() );
+      TEST_ASSERT( consumer.value() == to_string( from_string( text ) ) );
+
+      TEST_THROWS( arena_from_string( "{\"a\":1,\"b\":2,\"a\":3}" ) );
+      TEST_THROWS( arena_from_string( "[1,2" ) );
+   }
+
+   void unit_test()
+   {
+      test_access();
+      test_document();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
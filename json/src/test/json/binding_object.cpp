@@ -191,7 +191,74 @@ namespace tao::json
       (void)v.as< type_5 >();
    }
 
-   // TODO: Test with different for_unknown_key.
+   struct type_6
+   {
+      int a = 0;
+      int ab = 0;
+      int abc = 0;
+      int b = 0;
+      int ba = 0;
+      std::string e;
+      std::string k0;
+      std::string k1;
+      std::string k2;
+      std::string k3;
+      std::optional< int > k10;
+      std::optional< int > k11;
+   };
+
+   template<>
+   struct traits< type_6 >
+      : binding::basic_object< binding::for_unknown_key::skip,
+                               binding::for_nothing_value::suppress,
+                               TAO_JSON_BIND_REQUIRED( "a", &type_6::a ),
+                               TAO_JSON_BIND_REQUIRED( "ab", &type_6::ab ),
+                               TAO_JSON_BIND_REQUIRED( "abc", &type_6::abc ),
+                               TAO_JSON_BIND_REQUIRED( "b", &type_6::b ),
+                               TAO_JSON_BIND_REQUIRED( "ba", &type_6::ba ),
+                               TAO_JSON_BIND_REQUIRED( "", &type_6::e ),
+                               TAO_JSON_BIND_REQUIRED( "k0", &type_6::k0 ),
+                               TAO_JSON_BIND_REQUIRED( "k1", &type_6::k1 ),
+                               TAO_JSON_BIND_REQUIRED( "k2", &type_6::k2 ),
+                               TAO_JSON_BIND_REQUIRED( "k3", &type_6::k3 ),
+                               TAO_JSON_BIND_OPTIONAL( "k10", &type_6::k10 ),
+                               TAO_JSON_BIND_OPTIONAL( "k11", &type_6::k11 ) >
+   {};
+
+   constexpr binding::internal::key_table< 4 > table_6{ { "a", "ab", "", "abc" } };
+
+   static_assert( !table_6.has_duplicates() );
+   static_assert( table_6.find( "a" ) == 0 );
+   static_assert( table_6.find( "ab" ) == 1 );
+   static_assert( table_6.find( "" ) == 2 );
+   static_assert( table_6.find( "abc" ) == 3 );
+   static_assert( table_6.find( "abcd" ) == 4 );
+   static_assert( table_6.find( "b" ) == 4 );
+   static_assert( binding::internal::key_table< 3 >( { "a", "b", "a" } ).has_duplicates() );
+
+   void unit_test_6()
+   {
+      const char* text = R"({ "k11" : 11, "ba" : 5, "b" : 4, "abc" : 3, "ab" : 2, "a" : 1, "" : "e", "k0" : "0", "k1" : "1", "k2" : "2", "k3" : "3", "k" : [ 1 ], "abcd" : {}, "k4" : null })";
+      for( const auto& t : { consume_string< type_6 >( text ), from_string( text ).as< type_6 >() } ) {
+         TEST_ASSERT( t.a == 1 );
+         TEST_ASSERT( t.ab == 2 );
+         TEST_ASSERT( t.abc == 3 );
+         TEST_ASSERT( t.b == 4 );
+         TEST_ASSERT( t.ba == 5 );
+         TEST_ASSERT( t.e == "e" );
+         TEST_ASSERT( t.k0 == "0" );
+         TEST_ASSERT( t.k3 == "3" );
+         TEST_ASSERT( !t.k10 );
+         TEST_ASSERT( t.k11 == 11 );
+      }
+      const value v = consume_string< type_6 >( text );
+      TEST_ASSERT( v.get_object().size() == 11 );
+      TEST_ASSERT( v.at( "" ) == "e" );
+
+      TEST_THROWS( consume_string< type_6 >( R"({ "a" : 1, "ab" : 2, "abc" : 3, "b" : 4, "ba" : 5, "" : "e", "k0" : "0", "k1" : "1", "k2" : "2" })" ) );
+      TEST_THROWS( consume_string< type_6 >( R"({ "a" : 1, "ab" : 2, "abc" : 3, "b" : 4, "ba" : 5, "" : "e", "k0" : "0", "k1" : "1", "k2" : "2", "k3" : "3", "a" : 1 })" ) );
+   }
+
    // TODO: Test with different for_nothing_value (incl. consistency of size to consumer).
 
    void unit_test()
@@ -201,6 +268,7 @@ namespace tao::json
       unit_test_3();
       unit_test_4();
       unit_test_5();
+      unit_test_6();
    }
 
 }  // namespace tao::json
@@ -0,0 +1,125 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <sstream>
+
+#include <tao/json/contrib/compact_value.hpp>
+#include <tao/json/events/to_string.hpp>
+
+namespace tao::json
+{
+   std::string to_text( const compact_value& v )
+   {
+      std::ostringstream o;
+      o << v;
+      return o.str();
+   }
+
+   void test_scalars()
+   {
+      TEST_ASSERT( sizeof( compact_value ) == 16 );
+
+      compact_value v;
+      TEST_ASSERT( v.is_uninitialized() );
+      TEST_ASSERT( !v );
+
+      v = null;
+      TEST_ASSERT( v.is_null() );
+
+      v = true;
+      TEST_ASSERT( v.get_boolean() );
+
+      v = -42;
+      TEST_ASSERT( v.get_signed() == -42 );
+      TEST_THROWS( v.get_unsigned() );
+
+      v = 42u;
+      TEST_ASSERT( v.get_unsigned() == 42 );
+      TEST_ASSERT( v == compact_value( 42 ) );
+      TEST_ASSERT( v == compact_value( 42.0 ) );
+      TEST_ASSERT( v != compact_value( -42 ) );
+
+      v = 1.5;
+      TEST_ASSERT( v.get_double() == 1.5 );
+   }
+
+   void test_strings()
+   {
+      const compact_value e = empty_string;
+      TEST_ASSERT( e.is_inline_string() );
+      TEST_ASSERT( e.get_string_type().empty() );
+
+      const compact_value s( "fourteen chars" );
+      TEST_ASSERT( s.is_inline_string() );
+      TEST_ASSERT( s.get_string_type() == "fourteen chars" );
+
+      const compact_value l( "fifteen chars.." );
+      TEST_ASSERT( !l.is_inline_string() );
+      TEST_ASSERT( l.get_string_type() == "fifteen chars.." );
+
+      compact_value c = l;
+      TEST_ASSERT( c == l );
+      TEST_ASSERT( c.get_string_type().data() != l.get_string_type().data() );
+
+      const compact_value m = std::move( c );
+      TEST_ASSERT( m == l );
+      TEST_ASSERT( c.is_discarded() );
+   }
+
+   void test_containers()
+   {
+      compact_value v = compact_value::object( { { "a", 1 }, { "b", compact_value::array( { 1, "x", null } ) } } );
+      TEST_ASSERT( v.is_object() );
+      TEST_ASSERT( v.get_object().size() == 2 );
+      TEST_ASSERT( v.at( "a" ).get_signed() == 1 );
+      TEST_ASSERT( v.at( "b" ).at( 1 ).get_string_type() == "x" );
+      TEST_ASSERT( v.at( pointer( "/b/2" ) ).is_null() );
+      TEST_ASSERT( v.find( "c" ) == nullptr );
+      TEST_ASSERT( v.find( pointer( "/b/3" ) ) == nullptr );
+      TEST_THROWS( v.at( "c" ) );
+      TEST_THROWS( v.at( "b" ).at( 3 ) );
+      TEST_THROWS( v.emplace( "a", 2 ) );
+
+      v[ "c" ] = "a string that is not inline";
+      v[ "b" ].emplace_back( false );
+      v[ "b" ].erase( 0 );
+      v.erase( "a" );
+      TEST_ASSERT( to_text( v ) == "{\"b\":[\"x\",null,false],\"c\":\"a string that is not inline\"}" );
+
+      const compact_value w = v;
+      TEST_ASSERT( w == v );
+      v[ "b" ][ 0 ] = "y";
+      TEST_ASSERT( w != v );
+   }
+
+   void test_events()
+   {
+      const std::string text = "[null,true,false,-1,2,3.5,\"short\",\"something much longer\",[],{},{\"a\":[1,{\"b\":2}]}]";
+      const auto v = compact_from_string( text );
+      TEST_ASSERT( v.is_array() );
+      TEST_ASSERT( v.get_array().size() == 11 );
+      TEST_ASSERT( v[ 3 ].is_signed() );
+      TEST_ASSERT( v[ 4 ].is_unsigned() );
+      TEST_ASSERT( v[ 6 ].is_inline_string() );
+      TEST_ASSERT( !v[ 7 ].is_inline_string() );
+
+      events::to_string consumer;
+      events::from_compact_value( consumer, v );
+      TEST_ASSERT( consumer.value() == text );
+
+      TEST_THROWS( compact_from_string( "{\"a\":1,\"a\":2}" ) );
+   }
+
+   void unit_test()
+   {
+      test_scalars();
+      test_strings();
+      test_containers();
+      test_events();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
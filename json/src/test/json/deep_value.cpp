@@ -0,0 +1,101 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <tao/json.hpp>
+#include <tao/json/contrib/shared_value.hpp>
+
+namespace tao::json
+{
+   // Deep enough to overflow the call stack when any of the traversals recurses.
+   constexpr std::size_t depth = 400000;
+
+   template< template< typename... > class Traits >
+   basic_value< Traits > make_deep( basic_value< Traits > v )
+   {
+      for( std::size_t i = 0; i < depth; ++i ) {
+         basic_value< Traits > n;
+         if( i % 2 ) {
+            n.emplace( "k", std::move( v ) );
+         }
+         else {
+            n.emplace_back( 1 );
+            n.emplace_back( std::move( v ) );
+         }
+         v = std::move( n );
+      }
+      return v;
+   }
+
+   void test_shallow()
+   {
+      const value v = from_string( "[1,[2,{\"a\":[],\"b\":{\"c\":[3,4]}}],{},\"x\"]" );
+      const value w = from_string( "[1,[2,{\"a\":[],\"b\":{\"c\":[3,5]}}],{},\"x\"]" );
+      TEST_ASSERT( v == v );
+      TEST_ASSERT( v != w );
+      TEST_ASSERT( v < w );
+      TEST_ASSERT( !( w < v ) );
+      TEST_ASSERT( from_string( "[1,2]" ) < from_string( "[1,2,0]" ) );
+      TEST_ASSERT( from_string( "{\"a\":1}" ) < from_string( "{\"b\":0}" ) );
+      TEST_ASSERT( from_string( "{\"a\":[1]}" ) != from_string( "{\"a\":[1],\"b\":[]}" ) );
+      TEST_ASSERT( from_string( "[[1,2],[3]]" ) < from_string( "[[1,2],[3,0]]" ) );
+      TEST_ASSERT( from_string( "[[1,2],{\"a\":3}]" ) < from_string( "[[1,2],{\"b\":3}]" ) );
+      TEST_ASSERT( from_string( "[{\"a\":[]},1]" ) == from_string( "[{\"a\":[]},1.0]" ) );
+      TEST_ASSERT( to_string( v ) == "[1,[2,{\"a\":[],\"b\":{\"c\":[3,4]}}],{},\"x\"]" );
+
+      value p = value::array( { 1, &v } );
+      TEST_ASSERT( p == from_string( "[1,[1,[2,{\"a\":[],\"b\":{\"c\":[3,4]}}],{},\"x\"]]" ) );
+      TEST_ASSERT( to_string( p ) == "[1,[1,[2,{\"a\":[],\"b\":{\"c\":[3,4]}}],{},\"x\"]]" );
+
+      events::to_value c;
+      events::from_value( c, value( v ) );
+      TEST_ASSERT( c.value == v );
+   }
+
+   void test_deep()
+   {
+      const value v = make_deep( value( "leaf" ) );
+      const value w = make_deep( value( "leaf" ) );
+      const value x = make_deep( value( "leap" ) );
+      TEST_ASSERT( v == w );
+      TEST_ASSERT( v != x );
+      TEST_ASSERT( v < x );
+      TEST_ASSERT( !( x < v ) );
+
+      const auto s = to_string( v );
+      TEST_ASSERT( s.size() == 6 + depth / 2 * 10 );
+      TEST_ASSERT( s.find( "\"leaf\"" ) == depth / 2 * 8 );
+
+      events::to_value c;
+      events::from_value( c, v );
+      TEST_ASSERT( c.value == v );
+
+      events::to_value d;
+      events::from_value( d, make_deep( value( "leaf" ) ) );
+      TEST_ASSERT( d.value == v );
+   }
+
+   void test_shared()
+   {
+      const shared_value v = make_deep( shared_value( "leaf" ) );
+      shared_value w = v;
+      w = make_deep( shared_value( "leaf" ) );
+      TEST_ASSERT( v == w );
+      {
+         const shared_value x = v;
+         TEST_ASSERT( x == v );
+      }
+      TEST_ASSERT( v.get_object().size() == 1 );
+   }
+
+   void unit_test()
+   {
+      test_shallow();
+      test_deep();
+      test_shared();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
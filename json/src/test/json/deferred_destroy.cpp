@@ -0,0 +1,85 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <tao/json.hpp>
+#include <tao/json/contrib/deferred_destroy.hpp>
+
+namespace tao::json
+{
+   [[nodiscard]] value make_big( const std::size_t n = 1000 )
+   {
+      value v = empty_array;
+      for( std::size_t i = 0; i < n; ++i ) {
+         v.emplace_back( value( { { "key", std::string( 100, 'x' ) } } ) );
+      }
+      return v;
+   }
+
+   void test_estimate_size()
+   {
+      TEST_ASSERT( internal::estimate_size( value( 1 ), 1000 ) == 0 );
+      TEST_ASSERT( internal::estimate_size( value( std::string( 100, 'x' ) ), 1000 ) >= 100 );
+      TEST_ASSERT( internal::estimate_size( make_big(), 1000000000 ) >= 100000 );
+      TEST_ASSERT( internal::estimate_size( make_big(), 1000 ) >= 1000 );
+      TEST_ASSERT( internal::estimate_size( make_big(), 1000 ) < 100000 );
+   }
+
+   void test_reclaimer()
+   {
+      reclaimer r( 10000, 4 );
+      value v = make_big();
+      r.destroy( std::move( v ) );
+      r.destroy( value( "small" ) );
+      r.wait();
+      const auto s = r.stats();
+      TEST_ASSERT( s.depth == 0 );
+      TEST_ASSERT( s.max_depth == 1 );
+      TEST_ASSERT( s.deferred == 1 );
+      TEST_ASSERT( s.reclaimed == 1 );
+      TEST_ASSERT( s.direct == 1 );
+
+      for( std::size_t i = 0; i < 100; ++i ) {
+         r.destroy( make_big() );
+      }
+      r.wait();
+      const auto t = r.stats();
+      TEST_ASSERT( t.depth == 0 );
+      TEST_ASSERT( t.max_depth <= 4 );
+      TEST_ASSERT( t.deferred == t.reclaimed );
+      TEST_ASSERT( t.deferred + t.direct == 102 );
+   }
+
+   void test_disabled()
+   {
+      reclaimer r( 0, 0 );
+      r.destroy( make_big() );
+      r.wait();
+      const auto s = r.stats();
+      TEST_ASSERT( s.deferred == 0 );
+      TEST_ASSERT( s.direct == 1 );
+   }
+
+   void test_global()
+   {
+      const auto before = reclaimer::global().stats();
+      value v = make_big( 10000 );  // Above the default of 1 MiB.
+      deferred_destroy( std::move( v ) );
+      reclaimer::global().wait();
+      const auto after = reclaimer::global().stats();
+      TEST_ASSERT( after.deferred == before.deferred + 1 );
+      TEST_ASSERT( after.reclaimed == before.reclaimed + 1 );
+   }
+
+   void unit_test()
+   {
+      test_estimate_size();
+      test_reclaimer();
+      test_disabled();
+      test_global();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
@@ -3,6 +3,11 @@
 
 #include "test.hpp"
 
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+
 #include <tao/json/from_string.hpp>
 #include <tao/json/to_string.hpp>
 #include <tao/json/value.hpp>
@@ -25,8 +30,30 @@ namespace tao::json
       TEST_ASSERT( r == double2string( v ) );
    }
 
+   // Compares with std::strtod for random numbers with up to 20 significant
+   // digits, most of which take the fast path of the number parser.
+   void test_random()
+   {
+      std::mt19937_64 rng( 42 );
+      for( int i = 0; i < 100000; ++i ) {
+         const std::uint64_t m = rng() >> ( rng() % 64 );
+         const int e = int( rng() % 660 ) - 340;
+         const std::string s = std::to_string( m ) + ( ( i & 1 ) ? ".0e" : "e" ) + std::to_string( e );
+         const double d = std::strtod( s.c_str(), nullptr );
+         if( std::isfinite( d ) ) {
+            TEST_ASSERT( string2double( s ) == d );
+            TEST_ASSERT( string2double( '-' + s ) == -d );
+         }
+         else {
+            TEST_THROWS( string2double( s ) );
+         }
+      }
+   }
+
    void unit_test()
    {
+      test_random();
+
       test_double( "0.0", 0.0, "0.0" );
       test_double( "-0.0", -0.0, "-0.0" );
       test_double( "1.0", 1.0, "1.0" );
@@ -153,6 +180,21 @@ namespace tao::json
       test_double( "2.225073858507201136057409796709131975934819546351645648023426109724822222021076945516529523908135087914149158913039621106870086438694594645527657207407820621743379988141063267329253552286881372149012981122451451889849057222307285255133155755015914397476397983411801999323962548289017107081850690630666655994938275772572015763062690663332647565300009245888316433037779791869612049497390377829704905051080609940730262937128958950003583799967207254304360284078895771796150945516748243471030702609144621572289880258182545180325707018860872113128079512233426288368622321503775666622503982534335974568884423900265498198385487948292206894721689831099698365846814022854243330660339850886445804001034933970427567186443383770486037861622771738545623065874679014086723327636718751234567890123456789012345678901e-308", 2.2250738585072014e-308, "2.2250738585072014e-308" );
       test_double( "30e001", 300.0, "300.0" );
 
+      // Exact halfway cases, rounding to even, subnormals and the limits.
+      test_double( "9007199254740993.0", 9007199254740992.0, "9007199254740992.0" );
+      test_double( "9007199254740995.0", 9007199254740996.0, "9007199254740996.0" );
+      test_double( "1e23", 1e23, "1e23" );
+      test_double( "8.98846567431158e307", 8.98846567431158e307, "8.98846567431158e307" );
+      test_double( "1.7976931348623157e308", 1.7976931348623157e308, "1.7976931348623157e308" );
+      test_double( "2.2250738585072011e-308", 2.2250738585072011e-308, "2.225073858507201e-308" );
+      test_double( "4.9406564584124654e-324", 4.9406564584124654e-324, "5e-324" );
+      test_double( "5e-324", 5e-324, "5e-324" );
+      test_double( "0.1e-342", 0.0, "0.0" );
+      test_double( "99999999999999999999", 1e20, "100000000000000000000.0" );
+      test_double( "-18446744073709551616", -18446744073709551616.0, "-18446744073709552000.0" );
+      TEST_THROWS( from_string( "1.7976931348623159e308" ) );
+      TEST_THROWS( from_string( "1e309" ) );
+
       // TODO: Disabled, triggers infinity
       // test_double( std::string( 2000, '1' ), (std::numeric_limits< double >::max)() );
 
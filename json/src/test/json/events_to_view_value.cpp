@@ -0,0 +1,49 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <tao/json/events/from_string.hpp>
+#include <tao/json/events/to_view_value.hpp>
+#include <tao/json/from_string.hpp>
+
+namespace tao::json
+{
+   [[nodiscard]] bool inside( const std::string& input, const std::string_view sv )
+   {
+      return ( sv.data() >= input.data() ) && ( sv.data() + sv.size() <= input.data() + input.size() );
+   }
+
+   void unit_test()
+   {
+      const std::string input = "{\"plain\":\"abc\",\"esc\\u0061ped\":\"a\\nb\",\"list\":[\"\",\"\\u00e4\",\"x y\"]}";
+
+      events::to_view_value consumer;
+      events::from_string( consumer, input );
+      const value& v = consumer.value;
+
+      TEST_ASSERT( v == from_string( input ) );
+
+      TEST_ASSERT( v.at( "plain" ).type() == type::STRING_VIEW );
+      TEST_ASSERT( v.at( "plain" ).get_string_view() == "abc" );
+      TEST_ASSERT( inside( input, v.at( "plain" ).get_string_view() ) );
+
+      TEST_ASSERT( v.at( "escaped" ).type() == type::STRING );
+      TEST_ASSERT( v.at( "escaped" ).get_string() == "a\nb" );
+
+      const auto& a = v.at( "list" ).get_array();
+      TEST_ASSERT( a[ 0 ].type() == type::STRING_VIEW );
+      TEST_ASSERT( a[ 0 ].get_string_view().empty() );
+      TEST_ASSERT( a[ 1 ].type() == type::STRING );
+      TEST_ASSERT( a[ 1 ].get_string() == "\xc3\xa4" );
+      TEST_ASSERT( a[ 2 ].type() == type::STRING_VIEW );
+      TEST_ASSERT( inside( input, a[ 2 ].get_string_view() ) );
+
+      TEST_ASSERT( from_string( "\"\\\\ab\\\"c\\/\"" ).get_string() == "\\ab\"c/" );
+      TEST_ASSERT( from_string( "\"ab\\tc\"" ).get_string() == "ab\tc" );
+      TEST_ASSERT( from_string( "{\"k\\u0065y\":0}" ).get_object().begin()->first == "key" );
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
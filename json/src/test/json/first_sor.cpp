@@ -0,0 +1,96 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <random>
+#include <string>
+
+#include <tao/json.hpp>
+#include <tao/json/internal/first_sor.hpp>
+
+namespace tao::json
+{
+   template< typename Rule >
+   [[nodiscard]] constexpr bool first_is( const char* cs, const bool nullable = false )
+   {
+      internal::first_set e;
+      for( ; *cs; ++cs ) {
+         e.set( static_cast< unsigned char >( *cs ) );
+      }
+      e.nullable = nullable;
+      const internal::first_set f = internal::first_of< Rule >();
+      for( std::size_t i = 0; i < 4; ++i ) {
+         if( f.bits[ i ] != e.bits[ i ] ) {
+            return false;
+         }
+      }
+      return f.nullable == e.nullable;
+   }
+
+   static_assert( first_is< pegtl::one< 'a', 'b' > >( "ab" ) );
+   static_assert( first_is< pegtl::istring< 'x', 'y' > >( "xX" ) );
+   static_assert( first_is< pegtl::opt< pegtl::one< 'a' > > >( "a", true ) );
+   static_assert( first_is< pegtl::seq< pegtl::opt< pegtl::one< 'a' > >, pegtl::star< pegtl::one< 'b' > >, pegtl::one< 'c' > > >( "abc" ) );
+   static_assert( first_is< pegtl::eolf >( "\r\n", true ) );
+   static_assert( first_is< internal::rules::escaped >( "\"\\/bfnrtu" ) );
+   static_assert( first_is< jaxn::internal::rules::ws >( " \t\r\n#/" ) );
+   static_assert( first_is< jaxn::internal::rules::string_fragment >( "\"'" ) );
+   static_assert( internal::first_of< pegtl::must< pegtl::one< 'a' > > >().all() );
+   static_assert( internal::first_of< internal::rules::unescaped >().all() );
+
+   // clang-format off
+   struct alternatives
+   {
+      template< template< typename... > class Sor >
+      using type = Sor< pegtl::seq< pegtl::opt< pegtl::one< 'a' > >, pegtl::one< 'b' > >,
+                        pegtl::if_must< pegtl::one< 'c' >, pegtl::one< 'd' > >,
+                        pegtl::istring< 'e', 'f' >,
+                        pegtl::utf8::range< 0x100, 0x200 >,
+                        pegtl::seq< pegtl::at< pegtl::one< 'g' > >, pegtl::any >,
+                        pegtl::plus< pegtl::ranges< 'h', 'i', 'x' > >,
+                        pegtl::if_then_else< pegtl::one< 'j' >, pegtl::one< 'k' >, pegtl::eolf >,
+                        pegtl::until< pegtl::one< 'l' >, pegtl::one< 'm' > >,
+                        pegtl::rep< 2, pegtl::not_one< 'n' > > >;
+   };
+   // clang-format on
+
+   template< typename Rule >
+   [[nodiscard]] std::string match( const std::string& text )
+   {
+      pegtl::memory_input in( text, "" );
+      try {
+         if( !pegtl::parse< Rule >( in ) ) {
+            return "failure";
+         }
+         return std::to_string( in.current() - text.data() );
+      }
+      catch( const pegtl::parse_error& ) {
+         return "error";
+      }
+   }
+
+   void unit_test()
+   {
+      using sor = alternatives::type< pegtl::sor >;
+      using first = alternatives::type< internal::first_sor >;
+
+      const char chars[] = "abcdefghijklmnxEF\r\n\xc4\x80\xc8\x80\xff";
+      std::mt19937 rng( 1 );
+      for( int i = 0; i < 20000; ++i ) {
+         std::string text;
+         for( unsigned j = rng() % 4; j > 0; --j ) {
+            text += chars[ rng() % ( sizeof( chars ) - 1 ) ];
+         }
+         TEST_ASSERT( match< first >( text ) == match< sor >( text ) );
+      }
+      TEST_ASSERT( match< first >( "" ) == "0" );
+      TEST_ASSERT( match< first >( "c" ) == "error" );
+      TEST_ASSERT( match< first >( "ab" ) == "2" );
+      TEST_ASSERT( match< first >( "\xc4\x80" ) == "2" );
+      TEST_ASSERT( match< first >( "nn" ) == "failure" );
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
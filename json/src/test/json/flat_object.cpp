@@ -0,0 +1,122 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <tao/json.hpp>
+
+#include <tao/json/contrib/diff.hpp>
+#include <tao/json/contrib/flat_object.hpp>
+#include <tao/json/contrib/patch.hpp>
+
+namespace tao::json
+{
+   void test_storage()
+   {
+      static_assert( std::is_same_v< flat_value::object_t, flat_object< flat_value > > );
+      static_assert( std::is_same_v< value::object_t, std::map< std::string, value, std::less<> > > );
+
+      flat_object< int > o;
+      TEST_ASSERT( o.empty() );
+      TEST_ASSERT( o.emplace( "c", 3 ).second );
+      TEST_ASSERT( o.emplace( "a", 1 ).second );
+      TEST_ASSERT( o.try_emplace( "b", 2 ).second );
+      TEST_ASSERT( !o.emplace( "a", 4 ).second );
+      TEST_ASSERT( !o.try_emplace( std::string_view( "b" ), 5 ).second );
+      TEST_ASSERT( o.size() == 3 );
+      TEST_ASSERT( o.begin()->first == "a" );
+      TEST_ASSERT( o.at( "a" ) == 1 );
+      TEST_ASSERT( o.find( std::string( "b" ) )->second == 2 );
+      TEST_ASSERT( o.find( "d" ) == o.end() );
+      TEST_THROWS( (void)o.at( "d" ) );
+      o[ "d" ] = 4;
+      TEST_ASSERT( o.count( "d" ) == 1 );
+      TEST_ASSERT( o.erase( "b" ) == 1 );
+      TEST_ASSERT( o.erase( "b" ) == 0 );
+
+      std::string keys;
+      for( const auto& e : o ) {
+         keys += e.first;
+      }
+      TEST_ASSERT( keys == "acd" );
+
+      std::vector< flat_object< int >::value_type > m = { { "x", 24 }, { "y", 25 }, { "z", 26 } };
+      flat_object< int > p;
+      const auto i1 = p.unsafe_assign_unsorted( m.begin(), m.end() );
+      TEST_ASSERT( i1 == p.end() );
+      TEST_ASSERT( p.size() == 3 );
+
+      m = { { "z", 26 }, { "a", 1 }, { "y", 25 } };
+      TEST_ASSERT( p.unsafe_assign_unsorted( m.begin(), m.end() ) == std::as_const( p ).end() );
+      TEST_ASSERT( p.begin()->first == "a" );
+      TEST_ASSERT( p.at( "z" ) == 26 );
+
+      m = { { "z", 26 }, { "a", 1 }, { "z", 0 } };
+      const auto i3 = p.unsafe_assign_unsorted( m.begin(), m.end() );
+      TEST_ASSERT( i3 != p.end() );
+      TEST_ASSERT( i3->first == "z" );
+
+      m.clear();
+      for( int i = 0; i < 100; ++i ) {
+         m.emplace_back( std::to_string( ( i * 37 ) % 100 ), i );
+      }
+      const auto i4 = p.unsafe_assign_unsorted( m.begin(), m.end() );
+      TEST_ASSERT( i4 == p.end() );
+      TEST_ASSERT( p.size() == 100 );
+      TEST_ASSERT( std::is_sorted( p.begin(), p.end() ) );
+      TEST_ASSERT( p.at( "37" ) == 1 );
+   }
+
+   void test_value()
+   {
+      flat_value v = {
+         { "b", 2 },
+         { "a", flat_value::array( { 1, "x" } ) },
+         { "c", { { "d", null } } }
+      };
+      TEST_ASSERT( v.is_object() );
+      TEST_ASSERT( v.get_object().begin()->first == "a" );
+      TEST_ASSERT( v.at( "b" ) == 2 );
+      TEST_ASSERT( v.at( pointer( "/c/d" ) ).is_null() );
+      TEST_ASSERT( v.find( "e" ) == nullptr );
+      TEST_THROWS( v.at( "e" ) );
+      TEST_THROWS( v.emplace( "a", 0 ) );
+
+      v[ "e" ] = true;
+      v.insert( pointer( "/c/f" ), 42 );
+      v.erase( "b" );
+      TEST_ASSERT( to_string( v ) == "{\"a\":[1,\"x\"],\"c\":{\"d\":null,\"f\":42},\"e\":true}" );
+
+      const flat_value w = v;
+      TEST_ASSERT( w == v );
+      v[ "c" ][ "d" ] = 0;
+      TEST_ASSERT( w != v );
+      TEST_ASSERT( w < v );
+   }
+
+   void test_parse()
+   {
+      const std::string text = "{\"z\":1,\"m\":{\"b\":[true,{\"y\":null,\"x\":[]}],\"a\":\"s\"},\"c\":2.5}";
+      const auto v = flat_from_string( text );
+      const auto r = from_string( text );
+      TEST_ASSERT( to_string( v ) == to_string( r ) );
+      TEST_ASSERT( v.at( "m" ).at( "b" ).at( 1 ).get_object().begin()->first == "x" );
+
+      TEST_THROWS( flat_from_string( "{\"a\":1,\"b\":2,\"a\":3}" ) );
+      TEST_THROWS( flat_from_string( "[{\"a\":1,\"a\":1}]" ) );
+
+      const auto d = diff( v, flat_from_string( "{\"z\":1,\"m\":{\"a\":\"t\"},\"c\":2.5,\"n\":0}" ) );
+      TEST_ASSERT( to_string( d ) == to_string( diff( r, from_string( "{\"z\":1,\"m\":{\"a\":\"t\"},\"c\":2.5,\"n\":0}" ) ) ) );
+      TEST_ASSERT( patch( v, d ) == flat_from_string( "{\"c\":2.5,\"n\":0,\"m\":{\"a\":\"t\"},\"z\":1}" ) );
+   }
+
+   void unit_test()
+   {
+      test_storage();
+      test_value();
+      test_parse();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
@@ -0,0 +1,125 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include <tao/json.hpp>
+
+#include <tao/json/contrib/diff.hpp>
+#include <tao/json/contrib/hash_object.hpp>
+#include <tao/json/contrib/patch.hpp>
+
+namespace tao::json
+{
+   [[nodiscard]] bool same( const hash_object< int >& o, const std::map< std::string, int >& m )
+   {
+      if( !std::equal( o.begin(), o.end(), m.begin(), m.end(), []( const auto& l, const auto& r ) { return ( l.first == r.first ) && ( l.second == r.second ); } ) ) {
+         return false;
+      }
+      for( const auto& e : m ) {
+         const auto it = o.find( e.first );
+         if( ( it == o.end() ) || ( it->second != e.second ) ) {
+            return false;
+         }
+      }
+      return o.find( "-" ) == o.end();
+   }
+
+   void test_storage()
+   {
+      static_assert( std::is_same_v< hash_value::object_t, hash_object< hash_value > > );
+
+      hash_object< int > o;
+      std::map< std::string, int > m;
+      TEST_ASSERT( o.empty() );
+      TEST_ASSERT( o.emplace( "c", 3 ).second );
+      TEST_ASSERT( o.try_emplace( "a", 1 ).second );
+      TEST_ASSERT( !o.emplace( "a", 4 ).second );
+      TEST_ASSERT( o.at( "a" ) == 1 );
+      TEST_THROWS( (void)o.at( "d" ) );
+
+      // Grows past small_size, first in order, then in random order.
+      o.clear();
+      for( int i = 0; i < 1000; ++i ) {
+         const auto k = std::to_string( 10000 + i );
+         o[ k ] = i;
+         m[ k ] = i;
+      }
+      TEST_ASSERT( same( o, m ) );
+      for( int i = 0; i < 1000; ++i ) {
+         const auto k = std::to_string( ( i * 7919 ) % 3000 );
+         TEST_ASSERT( o.try_emplace( k, i ).second == m.try_emplace( k, i ).second );
+      }
+      TEST_ASSERT( same( o, m ) );
+      TEST_ASSERT( o.at( "10500" ) == 500 );
+      TEST_ASSERT( o.count( "10500" ) == 1 );
+
+      for( int i = 0; i < 2000; ++i ) {
+         const auto k = std::to_string( ( i * 104729 ) % 12000 );
+         TEST_ASSERT( o.erase( k ) == m.erase( k ) );
+      }
+      TEST_ASSERT( same( o, m ) );
+      while( o.size() > 5 ) {
+         m.erase( o.begin()->first );
+         o.erase( o.begin() );
+         if( o.size() % 97 == 0 ) {
+            TEST_ASSERT( same( o, m ) );
+         }
+      }
+      TEST_ASSERT( same( o, m ) );
+
+      std::vector< hash_object< int >::value_type > v;
+      for( int i = 0; i < 100; ++i ) {
+         v.emplace_back( std::to_string( ( i * 37 ) % 100 ), i );
+      }
+      const auto i1 = o.unsafe_assign_unsorted( v.begin(), v.end() );
+      TEST_ASSERT( i1 == o.end() );
+      TEST_ASSERT( o.size() == 100 );
+      TEST_ASSERT( o.at( "37" ) == 1 );
+      const hash_object< int > p = o;
+      TEST_ASSERT( p == o );
+      TEST_ASSERT( p.at( "74" ) == 2 );
+   }
+
+   void test_value()
+   {
+      std::string text = "{";
+      for( int i = 0; i < 100; ++i ) {
+         text += "\"k" + std::to_string( 99 - i ) + "\":{\"i\":" + std::to_string( i ) + "},";
+      }
+      text.back() = '}';
+      const auto v = hash_from_string( text );
+      const auto r = from_string( text );
+      TEST_ASSERT( to_string( v ) == to_string( r ) );
+      TEST_ASSERT( v.at( "k42" ).at( "i" ) == 57 );
+      TEST_ASSERT( v.at( pointer( "/k7/i" ) ) == 92 );
+      TEST_ASSERT( v.find( "k100" ) == nullptr );
+      TEST_ASSERT( v == r );
+
+      TEST_THROWS( hash_from_string( "{\"a\":1,\"b\":2,\"a\":3}" ) );
+
+      hash_value w = v;
+      TEST_ASSERT( w == v );
+      w[ "k50" ][ "i" ] = 0;
+      w[ "k500" ] = 1;
+      w.erase( "k0" );
+      TEST_ASSERT( w != v );
+      const auto d = diff( v, w );
+      TEST_ASSERT( d.get_array().size() == 3 );
+      TEST_ASSERT( patch( v, d ) == w );
+      TEST_ASSERT( w.at( pointer( "/k500" ) ) == 1 );
+   }
+
+   void unit_test()
+   {
+      test_storage();
+      test_value();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
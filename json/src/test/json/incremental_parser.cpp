@@ -0,0 +1,199 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tao/json.hpp>
+#include <tao/json/external/pegtl/internal/file_reader.hpp>
+
+namespace tao::json
+{
+   [[nodiscard]] std::string events_of( const std::string& text )
+   {
+      std::ostringstream os;
+      try {
+         events::debug consumer( os );
+         events::from_string( consumer, text );
+      }
+      catch( const std::exception& ) {
+         return "error";
+      }
+      return os.str();
+   }
+
+   // Returns the events for the text fed in chunks that end at the given
+   // positions, or "error" when the parser throws.
+   [[nodiscard]] std::string events_of( const std::string& text, const std::vector< std::size_t >& splits )
+   {
+      std::ostringstream os;
+      try {
+         events::debug consumer( os );
+         incremental_parser parser( consumer );
+         std::size_t b = 0;
+         for( const auto e : splits ) {
+            parser.feed( std::string_view( text ).substr( b, e - b ) );
+            b = e;
+         }
+         parser.feed( std::string_view( text ).substr( b ) );
+         parser.finish();
+      }
+      catch( const std::exception& ) {
+         return "error";
+      }
+      return os.str();
+   }
+
+   // Checks all ways of cutting the text into two chunks, and one byte chunks.
+   [[nodiscard]] bool same( const std::string& text )
+   {
+      const std::string expected = events_of( text );
+      for( std::size_t i = 0; i <= text.size(); ++i ) {
+         if( events_of( text, { i } ) != expected ) {
+            return false;
+         }
+      }
+      std::vector< std::size_t > splits;
+      for( std::size_t i = 0; i <= text.size(); ++i ) {
+         splits.push_back( i );
+      }
+      return events_of( text, splits ) == expected;
+   }
+
+   void test_documents()
+   {
+      const char* valid[] = {
+         "null", "true", "false", " 0 ", "-0", "0.0", "-0.0", "42", "-42", "1e5", "1E+5", "1.5e-5", "0e0", "18446744073709551615", "-9223372036854775808",
+         "18446744073709551616", "123456789012345678901234567890", "1.7976931348623157e308", "4.9406564584124654e-324",
+         "\"\"", "\"a\"", "\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"", "\"\\u0041\\u00e4\\u20ac\\ud834\\udf06\"", "\"\xc3\xa4\xe2\x82\xac\xf0\x9d\x8c\x86\"", "\"\x7f\"",
+         "[]", "{}", "[[]]", "[{}]", "{\"a\":[]}", " [ 1 , 2 , 3 ] ", "\t{\r\n\"a\" : 1 ,\"b\":{\"c\":[true,false,null]}}\n",
+         "[\"]\",\"[\",\"{\",\"}\",\":\",\",\",\"\\\"\"]", "{\"\\\\\":\"\\\\\\\\\"}", "[1,-2,3.5,\"x\",null]"
+      };
+      for( const auto* t : valid ) {
+         TEST_ASSERT( events_of( t, {} ) != "error" );
+         TEST_ASSERT( same( t ) );
+      }
+      const char* invalid[] = {
+         "", " ", "nul", "nulll", "True", "truefalse", "1 2", "01", "-", "--1", "+1", "1.", ".5", "1e", "1e+", "0x10", "1.5x", "1e1234567890",
+         "\"", "\"a", "\"\\\"", "\"\\x\"", "\"\\u12\"", "\"\\u12g4\"", "\"\\ud800\"", "\"\\udc00\"", "\"\\ud800\\u0041\"", "\"\x01\"", "\"\xff\"", "\"\xc0\x80\"", "\"\xed\xa0\x80\"", "\"\xf4\x90\x80\x80\"", "\"\xc3\"",
+         "[", "]", "[1", "[1,", "[1,]", "[,1]", "[1 2]", "[1:2]", "{", "}", "{\"a\"}", "{\"a\":}", "{\"a\":1,}", "{\"a\" 1}", "{1:2}", "{\"a\":1\"b\":2}",
+         "[1]]", "{}}", "[1]x", "\"a\"\"b\"", "\"a\"b", "[\"a\"1]", "@", "[1\\]", "\\\"a\"", "\"\\"
+      };
+      for( const auto* t : invalid ) {
+         TEST_ASSERT( events_of( t, {} ) == "error" );
+         TEST_ASSERT( same( t ) );
+      }
+   }
+
+   void test_files()
+   {
+      std::mt19937 rng( 1 );
+      for( const char* f : { "tests/blns.json", "tests/taocpp/dateTime.json", "tests/taocpp/number.json", "tests/taocpp/position.json", "tests/taocpp/schema.json", "tests/draft4/properties.json" } ) {
+         const std::string text = pegtl::internal::file_reader( f ).read();
+         const std::string expected = events_of( text );
+         TEST_ASSERT( expected != "error" );
+         for( const std::size_t n : { 1, 7, 64, 1000 } ) {
+            std::vector< std::size_t > splits;
+            for( std::size_t i = rng() % n; i < text.size(); i += rng() % n + 1 ) {
+               splits.push_back( i );
+            }
+            TEST_ASSERT( events_of( text, splits ) == expected );
+         }
+      }
+   }
+
+   void test_mutations()
+   {
+      // Random edits of valid documents, fed in random chunks, must be accepted or rejected like the grammar does.
+      const std::string base = "{\"a\":[1,-2.5e3,true,false,null,\"x\\\"y\\\\\"],\"b\":{\"c\":\"\\u00e4\xc3\xa4\",\"d\":[[],{}]},\"e\":0}";
+      const char replacements[] = "{}[]:,\"\\ 0-.eE+x\x01\xc3";
+      std::mt19937 rng( 1 );
+      for( int i = 0; i < 20000; ++i ) {
+         std::string text = base;
+         for( unsigned j = rng() % 3 + 1; j > 0; --j ) {
+            const std::size_t p = rng() % text.size();
+            const char r = replacements[ rng() % ( sizeof( replacements ) - 1 ) ];
+            switch( rng() % 3 ) {
+               case 0:
+                  text[ p ] = r;
+                  break;
+               case 1:
+                  text.insert( p, 1, r );
+                  break;
+               default:
+                  text.erase( p, 1 );
+            }
+         }
+         std::vector< std::size_t > splits;
+         for( std::size_t k = rng() % 8; k < text.size(); k += rng() % 8 + 1 ) {
+            splits.push_back( k );
+         }
+         TEST_ASSERT( events_of( text, splits ) == events_of( text ) );
+      }
+   }
+
+   void test_errors()
+   {
+      const std::string text = "[\n  1,\n  \"a\", x ]";
+      for( std::size_t i = 0; i <= text.size(); ++i ) {
+         try {
+            events::discard consumer;
+            incremental_parser parser( consumer, "test" );
+            parser.feed( std::string_view( text ).substr( 0, i ) );
+            parser.feed( std::string_view( text ).substr( i ) );
+            parser.finish();
+            TEST_ASSERT( false );
+         }
+         catch( const pegtl::parse_error& e ) {
+            TEST_ASSERT( e.positions.size() == 1 );
+            TEST_ASSERT( e.positions[ 0 ].source == "test" );
+            TEST_ASSERT( e.positions[ 0 ].line == 3 );
+            TEST_ASSERT( e.positions[ 0 ].byte_in_line == 7 );
+            TEST_ASSERT( e.positions[ 0 ].byte == 14 );
+         }
+      }
+      try {
+         events::discard consumer;
+         incremental_parser parser( consumer );
+         parser.feed( "[\n\"abc" );
+         parser.feed( "\\u12x4\"]" );
+         TEST_ASSERT( false );
+      }
+      catch( const pegtl::parse_error& e ) {
+         TEST_ASSERT( e.positions[ 0 ].line == 2 );
+         TEST_ASSERT( e.positions[ 0 ].byte_in_line == 4 );
+         TEST_ASSERT( e.positions[ 0 ].byte == 6 );
+      }
+   }
+
+   void test_reuse()
+   {
+      events::to_value consumer;
+      incremental_parser parser( consumer );
+      parser.feed( "{\"a\":[1,2.5,\"x\\n" );
+      parser.feed( "y\"]}" );
+      parser.finish();
+      TEST_ASSERT( consumer.value == from_string( "{\"a\":[1,2.5,\"x\\ny\"]}" ) );
+      parser.feed( " 12" );
+      parser.feed( "3 " );
+      parser.finish();
+      TEST_ASSERT( consumer.value == 123 );
+   }
+
+   void unit_test()
+   {
+      test_documents();
+      test_files();
+      test_mutations();
+      test_errors();
+      test_reuse();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
@@ -0,0 +1,163 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <tao/json.hpp>
+#include <tao/json/events/from_string_indexed.hpp>
+#include <tao/json/events/parse_file_indexed.hpp>
+#include <tao/json/external/pegtl/internal/file_reader.hpp>
+
+namespace tao::json
+{
+   // Returns the events for the text, or "error" when the parser throws.
+   template< bool INDEXED >
+   [[nodiscard]] std::string events_of( const std::string& text )
+   {
+      std::ostringstream os;
+      try {
+         events::debug consumer( os );
+         if constexpr( INDEXED ) {
+            events::from_string_indexed( consumer, text );
+         }
+         else {
+            events::from_string( consumer, text );
+         }
+      }
+      catch( const std::exception& ) {
+         return "error";
+      }
+      return os.str();
+   }
+
+   [[nodiscard]] bool same( const std::string& text )
+   {
+      return events_of< false >( text ) == events_of< true >( text );
+   }
+
+   void test_documents()
+   {
+      const char* valid[] = {
+         "null", "true", "false", " 0 ", "-0", "0.0", "-0.0", "42", "-42", "1e5", "1E+5", "1.5e-5", "0e0", "18446744073709551615", "-9223372036854775808",
+         "18446744073709551616", "123456789012345678901234567890", "1.7976931348623157e308", "4.9406564584124654e-324",
+         "\"\"", "\"a\"", "\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"", "\"\\u0041\\u00e4\\u20ac\\ud834\\udf06\"", "\"\xc3\xa4\xe2\x82\xac\xf0\x9d\x8c\x86\"", "\"\x7f\"",
+         "[]", "{}", "[[]]", "[{}]", "{\"a\":[]}", " [ 1 , 2 , 3 ] ", "\t{\r\n\"a\" : 1 ,\"b\":{\"c\":[true,false,null]}}\n",
+         "[\"]\",\"[\",\"{\",\"}\",\":\",\",\",\"\\\"\"]", "{\"\\\\\":\"\\\\\\\\\"}"
+      };
+      for( const auto* t : valid ) {
+         TEST_ASSERT( events_of< true >( t ) != "error" );
+         TEST_ASSERT( same( t ) );
+      }
+      const char* invalid[] = {
+         "", " ", "nul", "nulll", "True", "truefalse", "1 2", "01", "-", "--1", "+1", "1.", ".5", "1e", "1e+", "0x10", "1.5x", "1e1234567890",
+         "\"", "\"a", "\"\\\"", "\"\\x\"", "\"\\u12\"", "\"\\u12g4\"", "\"\\ud800\"", "\"\\udc00\"", "\"\\ud800\\u0041\"", "\"\x01\"", "\"\xff\"", "\"\xc0\x80\"", "\"\xed\xa0\x80\"", "\"\xf4\x90\x80\x80\"", "\"\xc3\"",
+         "[", "]", "[1", "[1,", "[1,]", "[,1]", "[1 2]", "[1:2]", "{", "}", "{\"a\"}", "{\"a\":}", "{\"a\":1,}", "{\"a\" 1}", "{1:2}", "{\"a\":1\"b\":2}",
+         "[1]]", "{}}", "[1]x", "\"a\"\"b\"", "\"a\"b", "[\"a\"1]", "@", "[1\\]", "\\\"a\""
+      };
+      for( const auto* t : invalid ) {
+         TEST_ASSERT( events_of< true >( t ) == "error" );
+         TEST_ASSERT( same( t ) );
+      }
+   }
+
+   void test_blocks()
+   {
+      // Strings, escapes and tokens at all positions relative to the 64 byte blocks of the first stage.
+      for( std::size_t i = 0; i < 140; ++i ) {
+         const std::string a( i, ' ' );
+         const std::string b( i, 'x' );
+         const std::string c( i, '\\' );
+         TEST_ASSERT( same( a + "[1,\"" + b + "\",true]" + a ) );
+         TEST_ASSERT( same( "[\"" + b + "\\\"\",\"" + b + "\\\\\",1]" ) );
+         TEST_ASSERT( same( "[\"" + c + "\",\"" + c + "\\\",0]" ) );
+         TEST_ASSERT( same( "[\"" + c + c + "\"]" ) );
+         TEST_ASSERT( same( "{\"" + b + "\":" + a + "123" + a + "}" ) );
+         TEST_ASSERT( same( "[\"" + b + "\"" + b + "]" ) );
+         TEST_ASSERT( same( "[\"" + b ) );
+         TEST_ASSERT( same( a + "1" + a + "2" ) );
+      }
+   }
+
+   void test_files()
+   {
+      for( const char* f : { "tests/blns.json", "tests/taocpp/dateTime.json", "tests/taocpp/number.json", "tests/taocpp/position.json", "tests/taocpp/schema.json", "tests/draft4/properties.json" } ) {
+         const std::string text = pegtl::internal::file_reader( f ).read();
+         TEST_ASSERT( same( text ) );
+         TEST_ASSERT( events_of< true >( text ) != "error" );
+
+         std::ostringstream o1;
+         std::ostringstream o2;
+         events::debug c1( o1 );
+         events::debug c2( o2 );
+         events::parse_file( c1, f );
+         events::parse_file_indexed( c2, f );
+         TEST_ASSERT( o1.str() == o2.str() );
+      }
+   }
+
+   void test_mutations()
+   {
+      // Random edits of valid documents must be accepted or rejected like the grammar does.
+      const std::string base = "{\"a\":[1,-2.5e3,true,false,null,\"x\\\"y\\\\\"],\"b\":{\"c\":\"\\u00e4\xc3\xa4\",\"d\":[[],{}]},\"e\":0}";
+      const char replacements[] = "{}[]:,\"\\ 0-.eE+x\x01\xc3";
+      std::mt19937 rng( 1 );
+      for( int i = 0; i < 20000; ++i ) {
+         std::string text = base;
+         for( unsigned j = rng() % 3 + 1; j > 0; --j ) {
+            const std::size_t p = rng() % text.size();
+            const char r = replacements[ rng() % ( sizeof( replacements ) - 1 ) ];
+            switch( rng() % 3 ) {
+               case 0:
+                  text[ p ] = r;
+                  break;
+               case 1:
+                  text.insert( p, 1, r );
+                  break;
+               default:
+                  text.erase( p, 1 );
+            }
+         }
+         TEST_ASSERT( same( text ) );
+      }
+   }
+
+   void test_errors()
+   {
+      try {
+         events::discard consumer;
+         events::from_string_indexed( consumer, "[\n  1,\n  x ]", "test" );
+         TEST_ASSERT( false );
+      }
+      catch( const pegtl::parse_error& e ) {
+         TEST_ASSERT( e.positions.size() == 1 );
+         TEST_ASSERT( e.positions[ 0 ].source == "test" );
+         TEST_ASSERT( e.positions[ 0 ].line == 3 );
+         TEST_ASSERT( e.positions[ 0 ].byte_in_line == 2 );
+         TEST_ASSERT( e.positions[ 0 ].byte == 9 );
+      }
+   }
+
+   void test_value()
+   {
+      events::to_value consumer;
+      events::from_string_indexed( consumer, "{\"a\":[1,2.5,\"x\\ny\"]}" );
+      TEST_ASSERT( consumer.value == from_string( "{\"a\":[1,2.5,\"x\\ny\"]}" ) );
+   }
+
+   void unit_test()
+   {
+      test_documents();
+      test_blocks();
+      test_files();
+      test_mutations();
+      test_errors();
+      test_value();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
@@ -0,0 +1,72 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <tao/json.hpp>
+
+#include <tao/json/contrib/interned_key.hpp>
+
+namespace tao::json
+{
+   void test_key()
+   {
+      const interned_key a( "timestamp" );
+      const interned_key b( std::string( "times" ) + "tamp" );
+      const interned_key c( "level" );
+      TEST_ASSERT( a.data() == b.data() );
+      TEST_ASSERT( a == b );
+      TEST_ASSERT( a != c );
+      TEST_ASSERT( c < a );
+      TEST_ASSERT( !( a < b ) );
+      TEST_ASSERT( a == "timestamp" );
+      TEST_ASSERT( "level" == c );
+      TEST_ASSERT( a < "u" );
+      TEST_ASSERT( a.view() == "timestamp" );
+      TEST_ASSERT( std::hash< interned_key >()( a ) == std::hash< interned_key >()( b ) );
+      TEST_ASSERT( interned_key( "" ).empty() );
+
+      const auto n = key_pool::global().size();
+      (void)interned_key( "level" );
+      TEST_ASSERT( key_pool::global().size() == n );
+
+      for( int j = 0; j < 1000; ++j ) {
+         (void)interned_key( std::to_string( j ) );
+      }
+      TEST_ASSERT( interned_key( "999" ).data() == interned_key( std::string( "999" ) ).data() );
+      TEST_ASSERT( key_pool::global().size() == n + 1000 );
+   }
+
+   void test_value()
+   {
+      static_assert( sizeof( interned_key ) == sizeof( void* ) );
+      static_assert( std::is_same_v< interned_value::object_t::key_type, interned_key > );
+
+      const std::string text = "[{\"timestamp\":1,\"level\":\"info\",\"request_id\":\"x\"},{\"request_id\":\"y\",\"level\":\"warn\",\"timestamp\":2}]";
+      const auto v = interned_from_string( text );
+      TEST_ASSERT( to_string( v ) == to_string( from_string( text ) ) );
+      TEST_ASSERT( v[ 0 ].get_object().begin()->first.data() == v[ 1 ].get_object().begin()->first.data() );
+      TEST_ASSERT( v.at( pointer( "/1/level" ) ) == "warn" );
+      TEST_ASSERT( v[ 1 ].find( "missing" ) == nullptr );
+      TEST_THROWS( interned_from_string( "{\"a\":1,\"b\":2,\"a\":3}" ) );
+
+      interned_value w = v;
+      TEST_ASSERT( w == v );
+      w[ 0 ][ "extra" ] = true;
+      w[ 1 ].erase( "level" );
+      TEST_ASSERT( w != v );
+      TEST_ASSERT( to_string( w ) == "[{\"extra\":true,\"level\":\"info\",\"request_id\":\"x\",\"timestamp\":1},{\"request_id\":\"y\",\"timestamp\":2}]" );
+
+      const interned_value o = { { "b", 1 }, { "a", 2 } };
+      TEST_ASSERT( o.get_object().begin()->first == "a" );
+   }
+
+   void unit_test()
+   {
+      test_key();
+      test_value();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
@@ -25,7 +25,19 @@ namespace tao::json
       TEST_THROWS( custom_from_string( "\"" ) );
       TEST_THROWS( custom_from_string( "\"\r\n\"" ) );
 
-      // TODO...
+      // Stop characters at all positions relative to the blocks of the string scanner.
+      for( std::size_t i = 0; i < 70; ++i ) {
+         const std::string a( i, 'a' );
+         TEST_ASSERT( custom_from_string( '"' + a + '"' ) == value( a ) );
+         TEST_ASSERT( custom_from_string( '"' + a + "\\n" + a + '"' ) == value( a + '\n' + a ) );
+         TEST_ASSERT( custom_from_string( '"' + a + "\\\"" + a + '"' ) == value( a + '"' + a ) );
+         TEST_ASSERT( custom_from_string( '"' + a + "\xc3\xa4\xe2\x82\xac" + a + '"' ) == value( a + "\xc3\xa4\xe2\x82\xac" + a ) );
+         TEST_ASSERT( custom_from_string( '"' + a + "\x7f" + a + '"' ) == value( a + "\x7f" + a ) );
+         TEST_THROWS( custom_from_string( '"' + a + "\x1f" + a + '"' ) );
+         TEST_THROWS( custom_from_string( '"' + a + "\xff" + a + '"' ) );
+         TEST_THROWS( custom_from_string( '"' + a + "\xc3" + a + '"' ) );
+         TEST_THROWS( custom_from_string( '"' + a ) );
+      }
    }
 
    void test_array()
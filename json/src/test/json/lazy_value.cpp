@@ -0,0 +1,96 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <sstream>
+
+#include <tao/json/contrib/lazy_value.hpp>
+#include <tao/json/from_string.hpp>
+
+namespace tao::json
+{
+   std::string to_text( const lazy_value& v )
+   {
+      std::ostringstream o;
+      o << v;
+      return o.str();
+   }
+
+   void test_access()
+   {
+      const std::string text = " { \"b\" : [ 1 , -2 , 3.5 , \"x\" , null , true ] , \"a\" : { \"c\" : \"str\\\"ing\" } , \"\" : { } , \"e\\u0073c\" : 18446744073709551616 } ";
+      const lazy_document d( text );
+      const auto v = d.root();
+      TEST_ASSERT( v.is_object() );
+      TEST_ASSERT( d.cached() == 0 );
+
+      TEST_ASSERT( v[ "b" ].is_array() );
+      TEST_ASSERT( d.cached() == 1 );
+      TEST_ASSERT( v[ "b" ][ 0 ].get_unsigned() == 1 );
+      TEST_ASSERT( v[ "b" ][ 1 ].get_signed() == -2 );
+      TEST_ASSERT( v[ "b" ][ 1 ].type() == type::SIGNED );
+      TEST_ASSERT( v[ "b" ][ 2 ].get_double() == 3.5 );
+      TEST_ASSERT( v[ "b" ][ 3 ].get_string() == "x" );
+      TEST_ASSERT( v[ "b" ][ 3 ].raw() == "\"x\"" );
+      TEST_ASSERT( v[ "b" ][ 4 ].is_null() );
+      TEST_ASSERT( v[ "b" ][ 5 ].get_boolean() );
+      TEST_ASSERT( v[ "b" ].size() == 6 );
+      TEST_ASSERT( !v[ "b" ].find( 6 ) );
+      TEST_THROWS( v[ "b" ][ 6 ] );
+      TEST_THROWS( v[ "b" ][ "x" ] );
+      TEST_THROWS( v[ "b" ][ 3 ].get_boolean() );
+      TEST_THROWS( v[ "b" ][ 3 ].get_signed() );
+
+      TEST_ASSERT( v.at( pointer( "/a/c" ) ).get_string() == "str\"ing" );
+      TEST_ASSERT( v.at( pointer( "/b/2" ) ).as< double >() == 3.5 );
+      TEST_ASSERT( !v.find( pointer( "/b/7" ) ) );
+      TEST_THROWS( v.at( pointer( "/a/d" ) ) );
+      TEST_ASSERT( v[ "" ].size() == 0 );
+      TEST_ASSERT( v[ "esc" ].type() == type::DOUBLE );
+      TEST_ASSERT( !v.find( "d" ) );
+      TEST_THROWS( v.at( "d" ) );
+      TEST_ASSERT( v.size() == 4 );
+
+      TEST_ASSERT( v[ "a" ].raw() == "{ \"c\" : \"str\\\"ing\" }" );
+      TEST_ASSERT( v[ "a" ].to_value() == from_string( "{\"c\":\"str\\\"ing\"}" ) );
+      TEST_ASSERT( from_string( to_text( v ) ) == from_string( text ) );
+      TEST_ASSERT( to_text( v[ "b" ] ) == "[1,-2,3.5,\"x\",null,true]" );
+   }
+
+   void test_partial()
+   {
+      // Only the members up to the one that is accessed are scanned.
+      const std::string text = "{\"x\":{\"y\":[1,2,{\"z\":true}]},\"w\":[[[],[]]],\"v\":0}";
+      const lazy_document d( text );
+      TEST_ASSERT( d.root()[ pointer( "/x/y/2/z" ) ].get_boolean() );
+      TEST_ASSERT( d.cached() == 4 );
+      TEST_ASSERT( d.root()[ "v" ].get_unsigned() == 0 );
+      TEST_ASSERT( d.cached() == 4 );
+      TEST_ASSERT( d.root()[ "w" ][ 0 ].size() == 2 );
+      TEST_ASSERT( d.cached() == 6 );
+      TEST_ASSERT( d.root()[ "x" ][ "y" ].size() == 3 );
+      TEST_ASSERT( d.root()[ "w" ][ 0 ][ 1 ].size() == 0 );
+
+      const lazy_document t( text, lazy_document::trusted );
+      TEST_ASSERT( t.root()[ "w" ][ 0 ].size() == 2 );
+      TEST_ASSERT( t.cached() == 3 );
+
+      const lazy_document s( " 42 " );
+      TEST_ASSERT( s.root().get_unsigned() == 42 );
+      TEST_ASSERT( s.root().raw() == "42" );
+
+      TEST_THROWS( lazy_document( "{\"a\":}" ) );
+      TEST_THROWS( lazy_document( "[1,2" ) );
+      TEST_THROWS( lazy_document( "[1] 2" ) );
+   }
+
+   void unit_test()
+   {
+      test_access();
+      test_partial();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
@@ -0,0 +1,106 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <tao/json.hpp>
+
+namespace tao::json
+{
+   struct raw_numbers
+      : events::discard
+   {
+      std::vector< std::string > numbers;
+
+      void number_raw( const std::string_view v )
+      {
+         numbers.emplace_back( v );
+      }
+   };
+
+   struct converted_doubles
+      : events::to_string
+   {
+      static constexpr bool disable_number_raw = true;
+
+      using to_string::number;
+
+      void number( const double v )
+      {
+         to_string::number( v );
+      }
+   };
+
+   static_assert( internal::has_number_raw< events::to_stream > );
+   static_assert( internal::has_number_raw< events::to_string > );
+   static_assert( internal::has_number_raw< events::to_pretty_stream > );
+   static_assert( internal::has_number_raw< events::limit_value_count< events::to_string, 10 > > );
+   static_assert( internal::has_number_raw< raw_numbers > );
+
+   static_assert( !internal::has_number_raw< events::discard > );
+   static_assert( !internal::has_number_raw< events::to_value > );
+   static_assert( !internal::has_number_raw< events::prefer_signed< events::to_string > > );
+   static_assert( !internal::has_number_raw< events::non_finite_to_null< events::to_string > > );
+   static_assert( !internal::has_number_raw< jaxn::events::to_stream > );
+   static_assert( !internal::has_number_raw< converted_doubles > );
+
+   void unit_test()
+   {
+      const std::string text = "[0,-0,1,-12,1.50,0.0,-1E+05,1e400,123456789012345678901234567890,-0.1e-0]";
+      const std::vector< std::string > numbers = { "0", "-0", "1", "-12", "1.50", "0.0", "-1E+05", "1e400", "123456789012345678901234567890", "-0.1e-0" };
+      {
+         raw_numbers c;
+         events::from_string( c, text );
+         TEST_ASSERT( c.numbers == numbers );
+      }
+      {
+         raw_numbers c;
+         events::from_string_indexed( c, text );
+         TEST_ASSERT( c.numbers == numbers );
+      }
+      {
+         raw_numbers c;
+         std::istringstream is( text );
+         events::from_stream( c, is, "number_raw", 16 );
+         TEST_ASSERT( c.numbers == numbers );
+      }
+      {
+         events::to_string c;
+         events::from_string( c, text );
+         TEST_ASSERT( c.value() == text );
+      }
+      {
+         events::to_string c;
+         events::from_string_indexed( c, text );
+         TEST_ASSERT( c.value() == text );
+      }
+      {
+         std::ostringstream os;
+         events::to_pretty_stream c( os, 1 );
+         events::from_string( c, "{\"a\":[1.50,-0]}" );
+         TEST_ASSERT( os.str() == "{\n \"a\": [\n  1.50,\n  -0\n ]\n}" );
+      }
+      {
+         converted_doubles c;
+         events::from_string( c, "[1.50,-0,7]" );
+         TEST_ASSERT( c.value() == "[1.5,0,7]" );
+      }
+      {
+         converted_doubles c;
+         TEST_THROWS( events::from_string( c, "[1e400]" ) );
+      }
+      for( const auto* s : { "[01]", "[1.]", "[1e]", "[1e+]", "[-]", "[-a]", "[.5]", "[+1]" } ) {
+         events::to_string c;
+         TEST_THROWS( events::from_string( c, s ) );
+         events::to_string d;
+         TEST_THROWS( events::from_string_indexed( d, s ) );
+      }
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
@@ -0,0 +1,113 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <tao/json.hpp>
+#include <tao/json/parse_ndjson.hpp>
+
+namespace tao::json
+{
+   using results_t = std::vector< std::pair< std::size_t, value > >;
+
+   [[nodiscard]] results_t parse( const std::string& text, const unsigned threads, const ndjson_order order )
+   {
+      results_t results;
+      parse_ndjson(
+         text,
+         [] { return events::to_value(); },
+         [ & ]( events::to_value&& consumer, const std::size_t line ) { results.emplace_back( line, std::move( consumer.value ) ); },
+         threads,
+         order );
+      return results;
+   }
+
+   void test_lines()
+   {
+      std::string text;
+      results_t expected;
+      for( std::size_t i = 1; i <= 30000; ++i ) {
+         if( i % 7 == 0 ) {
+            text += ( i % 2 ) ? "\n" : " \r\n";
+            continue;
+         }
+         const value v = { { "i", i }, { "s", std::string( i % 50, 'x' ) }, { "a", value::array( { 1, 2.5, "\xc3\xa4", null } ) } };
+         text += to_string( v );
+         text += ( i % 3 ) ? "\n" : "\r\n";
+         expected.emplace_back( i, v );
+      }
+      for( const unsigned threads : { 1, 2, 4, 0 } ) {
+         TEST_ASSERT( parse( text, threads, ndjson_order::ordered ) == expected );
+         auto unordered = parse( text, threads, ndjson_order::unordered );
+         std::sort( unordered.begin(), unordered.end(), []( const auto& l, const auto& r ) { return l.first < r.first; } );
+         TEST_ASSERT( unordered == expected );
+      }
+      TEST_ASSERT( parse( "", 4, ndjson_order::ordered ).empty() );
+      TEST_ASSERT( parse( "\n\n", 4, ndjson_order::ordered ).empty() );
+      TEST_ASSERT( parse( "1", 4, ndjson_order::ordered ) == results_t{ { 1, 1 } } );
+   }
+
+   void test_errors()
+   {
+      std::string text;
+      for( std::size_t i = 1; i <= 20000; ++i ) {
+         text += ( i == 12345 ) ? "[1,2" : "[1,2]";
+         text += '\n';
+      }
+      for( const auto order : { ndjson_order::ordered, ndjson_order::unordered } ) {
+         try {
+            (void)parse( text, 4, order );
+            TEST_ASSERT( false );
+         }
+         catch( const pegtl::parse_error& e ) {
+            TEST_ASSERT( e.positions.size() == 1 );
+            TEST_ASSERT( e.positions[ 0 ].source == "tao::json::parse_ndjson" );
+            TEST_ASSERT( e.positions[ 0 ].line == 12345 );
+            TEST_ASSERT( e.positions[ 0 ].byte_in_line == 4 );
+            TEST_ASSERT( e.positions[ 0 ].byte == 12344 * 6 + 4 );
+         }
+      }
+      TEST_THROWS( parse_ndjson(
+         text.substr( 0, 1000 ),
+         [] { return events::discard(); },
+         []( events::discard&&, const std::size_t line ) {
+            if( line == 100 ) {
+               throw std::runtime_error( "handler" );
+            }
+         },
+         2 ) );
+   }
+
+   void test_file()
+   {
+      results_t results;
+      parse_ndjson_file(
+         "tests/taocpp/lines.ndjson",
+         [] { return events::to_value(); },
+         [ & ]( events::to_value&& consumer, const std::size_t line ) { results.emplace_back( line, std::move( consumer.value ) ); } );
+      const results_t expected = {
+         { 1, { { "id", 1 }, { "name", "first" } } },
+         { 2, value::array( { 1, 2, 3 } ) },
+         { 4, "three" },
+         { 5, { { "nested", { { "a", value::array( { true, false, null } ) } } } } },
+         { 6, -45.0 }
+      };
+      TEST_ASSERT( results == expected );
+   }
+
+   void unit_test()
+   {
+      test_lines();
+      test_errors();
+      test_file();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
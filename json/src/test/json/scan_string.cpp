@@ -0,0 +1,155 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <iterator>
+#include <random>
+#include <string>
+
+#include <tao/json.hpp>
+
+namespace tao::json
+{
+   // One character or UTF-8 sequence at a time, for comparison with the
+   // vector loops of internal::scan_string() for all instructions that the
+   // CPU supports.
+
+   template< char D >
+   [[nodiscard]] std::size_t scan_scalar( const char* p, const std::size_t n )
+   {
+      std::size_t i = 0;
+      while( i < n ) {
+         if( internal::is_plain< D >( p[ i ] ) ) {
+            ++i;
+         }
+         else if( const std::size_t k = ( static_cast< unsigned char >( p[ i ] ) >= 0x80 ) ? internal::utf8_sequence( p + i, n - i ) : 0 ) {
+            i += k;
+         }
+         else {
+            break;
+         }
+      }
+      return i;
+   }
+
+   template< char D >
+   [[nodiscard]] bool same( const std::string& s )
+   {
+      const std::size_t expected = scan_scalar< D >( s.data(), s.size() );
+      for( const auto level : { internal::simd_level::base, internal::simd_level::ssse3, internal::simd_level::avx2, internal::simd_level::avx512 } ) {
+         if( ( level <= internal::available_simd_level() ) && ( internal::scan_string< D >( s.data(), s.size(), level ) != expected ) ) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   void append_utf8( std::string& s, const char32_t c )
+   {
+      if( c < 0x80 ) {
+         s += char( c );
+      }
+      else if( c < 0x800 ) {
+         s += char( 0xc0 | ( c >> 6 ) );
+         s += char( 0x80 | ( c & 0x3f ) );
+      }
+      else if( c < 0x10000 ) {
+         s += char( 0xe0 | ( c >> 12 ) );
+         s += char( 0x80 | ( ( c >> 6 ) & 0x3f ) );
+         s += char( 0x80 | ( c & 0x3f ) );
+      }
+      else {
+         s += char( 0xf0 | ( c >> 18 ) );
+         s += char( 0x80 | ( ( c >> 12 ) & 0x3f ) );
+         s += char( 0x80 | ( ( c >> 6 ) & 0x3f ) );
+         s += char( 0x80 | ( c & 0x3f ) );
+      }
+   }
+
+   void test_pairs()
+   {
+      // All pairs of bytes at all positions relative to the blocks of 16,
+      // 32 and 64 bytes, after a valid multi-byte sequence in the block.
+      std::size_t errors = 0;
+      for( unsigned a = 0; a < 256; ++a ) {
+         for( unsigned b = 0; b < 256; ++b ) {
+            for( std::size_t i = 56; i < 72; ++i ) {
+               std::string s( 80, 'a' );
+               s.replace( i - 8, 2, "\xc3\xa4" );
+               s[ i ] = char( a );
+               s[ i + 1 ] = char( b );
+               errors += !same< '"' >( s );
+               errors += !same< '\'' >( s );
+            }
+         }
+      }
+      TEST_ASSERT( errors == 0 );
+   }
+
+   void test_sequences()
+   {
+      // Every code point, and the surrogates and code points that are too
+      // large, also as truncated and overlong sequences, at all positions.
+      std::size_t errors = 0;
+      for( char32_t c = 0x80; c < 0x110800; c += ( c < 0x3000 ) ? 1 : 61 ) {
+         std::string u;
+         append_utf8( u, c );
+         for( std::size_t i = 0; i < 68; i += ( i < 12 ) ? 1 : 13 ) {
+            for( std::size_t k = 1; k <= u.size(); ++k ) {
+               const std::string s = std::string( i, 'x' ) + u.substr( 0, k ) + std::string( 70, 'y' );
+               errors += !same< '"' >( s );
+            }
+         }
+         if( c < 0x10000 ) {
+            std::string o;
+            o += char( 0xf0 );
+            o += char( 0x80 | ( ( c >> 12 ) & 0x3f ) );
+            o += char( 0x80 | ( ( c >> 6 ) & 0x3f ) );
+            o += char( 0x80 | ( c & 0x3f ) );
+            errors += !same< '"' >( std::string( 30, 'x' ) + o + std::string( 70, 'y' ) );
+         }
+      }
+      TEST_ASSERT( errors == 0 );
+   }
+
+   void test_random()
+   {
+      std::mt19937 r( 42 );
+      const char32_t samples[] = { 0xe4, 0x3b1, 0x7ff, 0x800, 0x20ac, 0xd7ff, 0xe000, 0xfffd, 0xffff, 0x10000, 0x1d306, 0x10ffff };
+      std::size_t errors = 0;
+      for( int n = 0; n < 20000; ++n ) {
+         std::string s;
+         const std::size_t length = r() % 300;
+         const unsigned odds = 1 + r() % 1000;
+         while( s.size() < length ) {
+            const auto x = r() % 10;
+            if( x < 6 ) {
+               s += char( 'a' + r() % 26 );
+            }
+            else if( x < 9 ) {
+               append_utf8( s, samples[ r() % std::size( samples ) ] );
+            }
+            else {
+               append_utf8( s, 0x80 + r() % 0x10ff80 );
+            }
+            if( r() % odds == 0 ) {
+               s[ r() % s.size() ] = char( r() );
+            }
+         }
+         errors += !same< '"' >( s );
+         errors += !same< '\'' >( s );
+      }
+      TEST_ASSERT( errors == 0 );
+   }
+
+   void unit_test()
+   {
+      test_pairs();
+      test_sequences();
+      test_random();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
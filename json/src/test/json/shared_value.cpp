@@ -0,0 +1,90 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <tao/json.hpp>
+
+#include <tao/json/contrib/diff.hpp>
+#include <tao/json/contrib/patch.hpp>
+#include <tao/json/contrib/shared_value.hpp>
+
+namespace tao::json
+{
+   void test_container()
+   {
+      shared_container< std::vector< int > > a;
+      TEST_ASSERT( a.empty() );
+      TEST_ASSERT( !a.is_shared() );
+      a.push_back( 1 );
+      a.emplace_back( 2 );
+      auto b = a;
+      TEST_ASSERT( a.is_shared() );
+      TEST_ASSERT( &a.get() == &b.get() );
+      TEST_ASSERT( a == b );
+      b[ 1 ] = 3;
+      TEST_ASSERT( !a.is_shared() );
+      TEST_ASSERT( std::as_const( a )[ 1 ] == 2 );
+      TEST_ASSERT( std::as_const( b )[ 1 ] == 3 );
+      TEST_ASSERT( a < b );
+      b.clear();
+      TEST_ASSERT( b.empty() );
+      TEST_ASSERT( b < a );
+
+      shared_container< std::map< std::string, int, std::less<> > > m;
+      m.emplace( "a", 1 );
+      const auto n = m;
+      TEST_ASSERT( std::as_const( m ).find( "b" ) == std::as_const( m ).end() );
+      TEST_ASSERT( m.is_shared() );
+      TEST_ASSERT( m.at( "a" ) == 1 );
+      TEST_ASSERT( !m.is_shared() );
+      TEST_ASSERT( m.erase( "a" ) == 1 );
+      TEST_ASSERT( n.count( "a" ) == 1 );
+   }
+
+   void test_value()
+   {
+      static_assert( std::is_same_v< shared_value::array_t, shared_container< std::vector< shared_value > > > );
+      static_assert( std::is_same_v< value::array_t, std::vector< value > > );
+
+      const std::string text = "{\"config\":{\"limits\":[1,2,3],\"name\":\"x\"},\"routes\":[{\"path\":\"/a\"},{\"path\":\"/b\"}]}";
+      const auto v = shared_from_string( text );
+      TEST_ASSERT( to_string( v ) == to_string( from_string( text ) ) );
+
+      // Copies share all containers.
+      auto w = v;
+      TEST_ASSERT( &w.get_object().get() == &v.get_object().get() );
+      TEST_ASSERT( w == v );
+
+      // Changing a copy only copies the containers on the path.
+      w[ "routes" ][ 1 ][ "path" ] = "/c";
+      TEST_ASSERT( v.at( pointer( "/routes/1/path" ) ) == "/b" );
+      TEST_ASSERT( w.at( pointer( "/routes/1/path" ) ) == "/c" );
+      TEST_ASSERT( &w.at( "config" ).get_object().get() == &v.at( "config" ).get_object().get() );
+      TEST_ASSERT( &w.at( "routes" ).at( 0 ).get_object().get() == &v.at( "routes" ).at( 0 ).get_object().get() );
+      TEST_ASSERT( w != v );
+
+      w.at( "config" ).at( "limits" ).at( 2 ) = 4;
+      w.insert( pointer( "/config/extra" ), true );
+      w.erase( "routes" );
+      TEST_ASSERT( to_string( v ) == to_string( from_string( text ) ) );
+      TEST_ASSERT( to_string( w ) == "{\"config\":{\"extra\":true,\"limits\":[1,2,4],\"name\":\"x\"}}" );
+
+      const auto d = diff( v, w );
+      TEST_ASSERT( patch( v, d ) == w );
+
+      shared_value e = shared_value::array( { 1, "a", shared_value::array( {} ) } );
+      e.emplace_back( null );
+      TEST_ASSERT( to_string( e ) == "[1,\"a\",[],null]" );
+      TEST_ASSERT( e.get_array().size() == 4 );
+   }
+
+   void unit_test()
+   {
+      test_container();
+      test_value();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
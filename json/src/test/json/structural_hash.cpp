@@ -0,0 +1,113 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <unordered_set>
+
+#include <tao/json.hpp>
+#include <tao/json/contrib/diff.hpp>
+#include <tao/json/contrib/shared_value.hpp>
+#include <tao/json/contrib/structural_hash.hpp>
+
+namespace tao::json
+{
+   void test_value()
+   {
+      TEST_ASSERT( structural_hash( value( 1 ) ) == structural_hash( value( 1U ) ) );
+      TEST_ASSERT( structural_hash( value( 1 ) ) == structural_hash( value( 1.0 ) ) );
+      TEST_ASSERT( structural_hash( value( 0.0 ) ) == structural_hash( value( -0.0 ) ) );
+      TEST_ASSERT( structural_hash( value( 1 ) ) != structural_hash( value( 2 ) ) );
+      TEST_ASSERT( structural_hash( value( "a" ) ) == structural_hash( value( std::string_view( "a" ) ) ) );
+      TEST_ASSERT( structural_hash( value( "a" ) ) != structural_hash( value( "b" ) ) );
+      TEST_ASSERT( structural_hash( value( true ) ) != structural_hash( value( false ) ) );
+      TEST_ASSERT( structural_hash( value( null ) ) != structural_hash( value( false ) ) );
+      TEST_ASSERT( structural_hash( value( binary{ std::byte( 1 ) } ) ) == structural_hash( value( binary_view( binary{ std::byte( 1 ) } ) ) ) );
+      TEST_ASSERT( structural_hash( value( binary{ std::byte( 1 ) } ) ) != structural_hash( value( binary{ std::byte( 2 ) } ) ) );
+
+      const value v = from_string( "[1,{\"a\":[true,null],\"b\":\"c\"},[],{}]" );
+      const value w = from_string( "[1.0,{\"a\":[true,null],\"b\":\"c\"},[],{}]" );
+      const value x = from_string( "[1,{\"a\":[true,null],\"b\":\"d\"},[],{}]" );
+      TEST_ASSERT( structural_hash( v ) == structural_hash( w ) );
+      TEST_ASSERT( structural_hash( v ) != structural_hash( x ) );
+      TEST_ASSERT( structural_hash( value::array( { &v } ) ) == structural_hash( value::array( { w } ) ) );
+      TEST_ASSERT( structural_hash( from_string( "[[]]" ) ) != structural_hash( from_string( "[[],[]]" ) ) );
+      TEST_ASSERT( structural_hash( from_string( "[[1],2]" ) ) != structural_hash( from_string( "[[1,2]]" ) ) );
+      TEST_ASSERT( structural_hash( from_string( "{\"a\":1}" ) ) != structural_hash( from_string( "{\"b\":1}" ) ) );
+
+      std::unordered_set< value > s;
+      s.insert( v );
+      s.insert( w );
+      s.insert( x );
+      TEST_ASSERT( s.size() == 2 );
+   }
+
+   void test_shared()
+   {
+      const shared_value v = shared_from_string( "{\"a\":[1,2,{\"b\":3}],\"c\":{\"d\":5}}" );
+      shared_value w = shared_from_string( "{\"a\":[1,2,{\"b\":3}],\"c\":{\"d\":5}}" );
+      const auto h = structural_hash( v );
+      TEST_ASSERT( structural_hash( v ) == h );
+      TEST_ASSERT( structural_hash( w ) == h );
+      TEST_ASSERT( v == w );
+
+      w[ "a" ][ 2 ][ "b" ] = 4;
+      TEST_ASSERT( v != w );
+      TEST_ASSERT( structural_hash( w ) != h );
+      TEST_ASSERT( structural_hash( w ) == structural_hash( shared_from_string( "{\"a\":[1,2,{\"b\":4}],\"c\":{\"d\":5}}" ) ) );
+      TEST_ASSERT( v < w );
+      TEST_ASSERT( !( w < v ) );
+
+      w[ "a" ][ 2 ][ "b" ] = 3;
+      TEST_ASSERT( v == w );
+      TEST_ASSERT( structural_hash( w ) == h );
+
+      const shared_value x = w;
+      TEST_ASSERT( structural_hash( x ) == h );
+      TEST_ASSERT( x == v );
+   }
+
+   void test_stale()
+   {
+      shared_value a = shared_from_string( "{\"x\":[1,2]}" );
+      const shared_value b = shared_from_string( "{\"x\":[1,2,3]}" );
+      auto& x = a.at( "x" );
+      (void)structural_hash( a );
+      (void)structural_hash( b );
+      x.push_back( 3 );
+      TEST_ASSERT( a == b );
+      TEST_ASSERT( !( a != b ) );
+      TEST_ASSERT( !( a < b ) );
+      TEST_ASSERT( !( b < a ) );
+      TEST_ASSERT( structural_hash( a ) == structural_hash( b ) );
+
+      std::unordered_set< shared_value > s;
+      s.insert( a );
+      s.insert( b );
+      TEST_ASSERT( s.size() == 1 );
+   }
+
+   void test_diff()
+   {
+      const value v = from_string( "{\"a\":[1,2,{\"b\":3}],\"c\":{\"d\":[]}}" );
+      const value w = from_string( "{\"a\":[1,2,{\"b\":4}],\"c\":{\"d\":[]}}" );
+      TEST_ASSERT( diff( v, v ) == empty_array );
+      TEST_ASSERT( diff( v, w ) == value::array( { { { "op", "replace" }, { "path", "/a/2/b" }, { "value", 4 } } } ) );
+
+      const shared_value x = shared_from_string( "{\"a\":[1,2,{\"b\":3}],\"c\":{\"d\":[]}}" );
+      shared_value y = x;
+      y[ "c" ][ "d" ].push_back( 5 );
+      TEST_ASSERT( diff( x, y ) == shared_value::array( { { { "op", "add" }, { "path", "/c/d/0" }, { "value", 5 } } } ) );
+   }
+
+   void unit_test()
+   {
+      test_value();
+      test_shared();
+      test_stale();
+      test_diff();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
@@ -0,0 +1,89 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <sstream>
+
+#include <tao/json.hpp>
+#include <tao/json/cbor.hpp>
+#include <tao/json/contrib/tape.hpp>
+
+namespace tao::json
+{
+   std::string to_text( const tape_ref r )
+   {
+      std::ostringstream o;
+      o << r;
+      return o.str();
+   }
+
+   void test_navigation()
+   {
+      const auto t = tape_from_string( "{\"b\":[1,-2,3.5,\"x\",null,true,false],\"a\":{\"c\":\"string\",\"d\":[]},\"\":{}}" );
+      const auto v = t.root();
+      TEST_ASSERT( v.is_object() );
+      TEST_ASSERT( v.size() == 3 );
+      TEST_ASSERT( v[ "b" ].size() == 7 );
+      TEST_ASSERT( v[ "b" ][ 0 ].get_unsigned() == 1 );
+      TEST_ASSERT( v[ "b" ][ 1 ].get_signed() == -2 );
+      TEST_ASSERT( v[ "b" ][ 2 ].get_double() == 3.5 );
+      TEST_ASSERT( v[ "b" ][ 3 ].get_string_type() == "x" );
+      TEST_ASSERT( v[ "b" ][ 4 ].is_null() );
+      TEST_ASSERT( v[ "b" ][ 5 ].get_boolean() );
+      TEST_ASSERT( !v[ "b" ][ 6 ].get_boolean() );
+      TEST_ASSERT( v.at( pointer( "/a/c" ) ).get_string_type() == "string" );
+      TEST_ASSERT( v.at( pointer( "/a/d" ) ).get_array().empty() );
+      TEST_ASSERT( v[ "" ].get_object().empty() );
+      TEST_ASSERT( !v.find( "e" ) );
+      TEST_ASSERT( !v.find( pointer( "/b/7" ) ) );
+      TEST_THROWS( v.at( "e" ) );
+      TEST_THROWS( v[ "b" ].at( 7 ) );
+      TEST_THROWS( v[ "a" ].get_array() );
+      TEST_THROWS( v[ "a" ][ "c" ].size() );
+
+      std::string keys;
+      for( const auto& m : v.get_object() ) {
+         keys += m.first;
+         keys += m.second.is_object() ? 'o' : 'a';
+      }
+      TEST_ASSERT( keys == "baaoo" );
+
+      std::size_t n = 0;
+      for( const auto& e : v[ "b" ].get_array() ) {
+         n += e.is_number() ? 1 : 0;
+      }
+      TEST_ASSERT( n == 3 );
+   }
+
+   void test_events()
+   {
+      const std::string text = "[{\"y\":[[],[[{}]]],\"z\":[]},\"s\",[1,2,3],{\"k\":\"v\"},-1,2.5,null]";
+      const auto t = tape_from_string( text );
+      TEST_ASSERT( to_text( t.root() ) == text );
+      TEST_ASSERT( to_text( t.root()[ 0 ][ "y" ] ) == "[[],[[{}]]]" );
+
+      const value v = from_string( text );
+      TEST_ASSERT( cbor::to_string( v ) == [ & ]() {
+         cbor::events::to_string consumer;
+         events::from_tape( consumer, t );
+         return consumer.value();
+      }() );
+
+      events::to_tape consumer;
+      events::from_value( consumer, v );
+      TEST_ASSERT( consumer.value.words() == t.words() );
+      TEST_ASSERT( consumer.value.strings() == t.strings() );
+
+      TEST_THROWS( tape().root() );
+   }
+
+   void unit_test()
+   {
+      test_navigation();
+      test_events();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
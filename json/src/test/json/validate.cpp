@@ -0,0 +1,151 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <random>
+#include <string>
+
+#include <tao/json.hpp>
+#include <tao/json/external/pegtl/internal/file_reader.hpp>
+
+namespace tao::json
+{
+   [[nodiscard]] bool parses( const std::string& text )
+   {
+      try {
+         events::discard consumer;
+         events::from_string( consumer, text );
+      }
+      catch( const std::exception& ) {
+         return false;
+      }
+      return true;
+   }
+
+   [[nodiscard]] bool same( const std::string& text )
+   {
+      return bool( validate( text ) ) == parses( text );
+   }
+
+   void test_documents()
+   {
+      const char* valid[] = {
+         "null", "true", "false", " 0 ", "-0", "0.0", "-0.0", "42", "-42", "1e5", "1E+5", "1.5e-5", "0e0", "1e000000000009", "18446744073709551616",
+         "\"\"", "\"a\"", "\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"", "\"\\u0041\\u00e4\\u20ac\\ud834\\udf06\"", "\"\xc3\xa4\xe2\x82\xac\xf0\x9d\x8c\x86\"", "\"\x7f\"",
+         "[]", "{}", "[[]]", "[{}]", "{\"a\":[]}", " [ 1 , 2 , 3 ] ", "\t{\r\n\"a\" : 1 ,\"b\":{\"c\":[true,false,null]}}\n",
+         "[\"]\",\"[\",\"{\",\"}\",\":\",\",\",\"\\\"\"]", "{\"\\\\\":\"\\\\\\\\\"}"
+      };
+      for( const auto* t : valid ) {
+         TEST_ASSERT( validate( t ) );
+         TEST_ASSERT( same( t ) );
+      }
+      const char* invalid[] = {
+         "", " ", "nul", "nulll", "True", "truefalse", "1 2", "01", "-", "--1", "+1", "1.", ".5", "1e", "1e+", "0x10", "1.5x", "1e1234567890",
+         "\"", "\"a", "\"\\\"", "\"\\x\"", "\"\\u12\"", "\"\\u12g4\"", "\"\\ud800\"", "\"\\udc00\"", "\"\\ud800\\u0041\"", "\"\x01\"", "\"\xff\"", "\"\xc0\x80\"", "\"\xed\xa0\x80\"", "\"\xf4\x90\x80\x80\"", "\"\xc3\"",
+         "[", "]", "[1", "[1,", "[1,]", "[,1]", "[1 2]", "[1:2]", "{", "}", "{\"a\"}", "{\"a\":}", "{\"a\":1,}", "{\"a\" 1}", "{1:2}", "{\"a\":1\"b\":2}",
+         "[1]]", "{}}", "[1]x", "\"a\"\"b\"", "\"a\"b", "[\"a\"1]", "@", "[1\\]", "\\\"a\"", "\"\\"
+      };
+      for( const auto* t : invalid ) {
+         TEST_ASSERT( !validate( t ) );
+         TEST_ASSERT( same( t ) );
+      }
+   }
+
+   void test_numbers()
+   {
+      // Numbers that overflow to infinity are rejected by the parser.
+      const char* numbers[] = {
+         "1e308", "1e309", "-1e309", "1.7976931348623157e308", "1.7976931348623158e308", "1.7976931348623159e308", "0.0001e312", "0.0001e313", "0.00000e999999999",
+         "17976931348623158079372897140530341507993413271003782693617377898044496829276475094664901797758720709633028641669288791094655554785194040263065748867150582068190890200070838367627385484581771153176447573027006985557136695962284291481986083493647529271907416844436551070434271155969950809304288017790417449779e1",
+         "17976931348623158079372897140530341507993413271003782693617377898044496829276475094664901797758720709633028641669288791094655554785194040263065748867150582068190890200070838367627385484581771153176447573027006985557136695962284291481986083493647529271907416844436551070434271155969950809304288017790417449779.1e1",
+         "1797693134862315807937289714053034150799341327100378269361737789804449682927647509466490179775872070963302864166928879109465555478519404026306574886715058206819089020007083836762738548458177115317644757302700698555713669596228429148198608349364752927190741684443655107043427115596995080930428801779041744977.91e2",
+         "0.17976931348623158079372897140530341507993413271003782693617377898044496829276475094664901797758720709633028641669288791094655554785194040263065748867150582068190890200070838367627385484581771153176447573027006985557136695962284291481986083493647529271907416844436551070434271155969950809304288017790417449779e309",
+         "0.1797693134862315807937289714053034150799341327100378269361737789804449682927647509466490179775872070963302864166928879109465555478519404026306574886715058206819089020007083836762738548458177115317644757302700698555713669596228429148198608349364752927190741684443655107043427115596995080930428801779041744977919e309"
+      };
+      for( const auto* t : numbers ) {
+         TEST_ASSERT( same( t ) );
+      }
+      TEST_ASSERT( same( std::string( 308, '9' ) ) );
+      TEST_ASSERT( same( std::string( 309, '9' ) ) );
+      TEST_ASSERT( same( std::string( 1 << 20, '0' ) ) );
+      TEST_ASSERT( same( "0." + std::string( 1 << 20, '1' ) ) );
+      TEST_ASSERT( same( "1." + std::string( 1 << 20, '0' ) + "e308" ) );
+   }
+
+   void test_offsets()
+   {
+      TEST_ASSERT( validate( "[1,2,x]" ).offset == 5 );
+      TEST_ASSERT( validate( "{\"a\" 1}" ).offset == 5 );
+      TEST_ASSERT( validate( "\"ab\\q\"" ).offset == 3 );
+      TEST_ASSERT( validate( "[1] 2" ).offset == 4 );
+      TEST_ASSERT( validate( "[1" ).offset == 2 );
+
+      const validate_options trailing = { 0, true };
+      TEST_ASSERT( validate( "[1] 2", trailing ) );
+      TEST_ASSERT( validate( "[1] 2", trailing ).offset == 3 );
+      TEST_ASSERT( validate( "{\"a\":1}xyz", trailing ).offset == 7 );
+      TEST_ASSERT( validate( " 12 ", trailing ).offset == 3 );
+      TEST_ASSERT( validate( " 12 " ).offset == 3 );
+      TEST_ASSERT( !validate( "[1 x", trailing ) );
+
+      const validate_options depth = { 2, false };
+      TEST_ASSERT( validate( "[{\"a\":1}]", depth ) );
+      TEST_ASSERT( !validate( "[[[1]]]", depth ) );
+      TEST_ASSERT( validate( "[[[1]]]", depth ).offset == 2 );
+
+      const validate_options infinite = { 0, false, true };
+      TEST_ASSERT( !validate( "[1,1e400]" ) );
+      TEST_ASSERT( validate( "[1,1e400]" ).offset == 3 );
+      TEST_ASSERT( validate( "[1,1e400]", infinite ) );
+      TEST_ASSERT( validate( "-1" + std::string( 400, '0' ), infinite ) );
+      TEST_ASSERT( !validate( "[1e]", infinite ) );
+      TEST_ASSERT( !validate( "[01]", infinite ) );
+   }
+
+   void test_files()
+   {
+      for( const char* f : { "tests/blns.json", "tests/taocpp/dateTime.json", "tests/taocpp/number.json", "tests/taocpp/position.json", "tests/taocpp/schema.json", "tests/draft4/properties.json" } ) {
+         const std::string text = pegtl::internal::file_reader( f ).read();
+         TEST_ASSERT( validate( text ) );
+      }
+   }
+
+   void test_mutations()
+   {
+      // Random edits of a valid document must be accepted or rejected like the parser does.
+      const std::string base = "{\"a\":[1,-2.5e3,true,false,null,\"x\\\"y\\\\\"],\"b\":{\"c\":\"\\u00e4\xc3\xa4\",\"d\":[[],{}]},\"e\":0}";
+      const char replacements[] = "{}[]:,\"\\ 0-.eE+x\x01\xc3";
+      std::mt19937 rng( 1 );
+      for( int i = 0; i < 20000; ++i ) {
+         std::string text = base;
+         for( unsigned j = rng() % 3 + 1; j > 0; --j ) {
+            const std::size_t p = rng() % text.size();
+            const char r = replacements[ rng() % ( sizeof( replacements ) - 1 ) ];
+            switch( rng() % 3 ) {
+               case 0:
+                  text[ p ] = r;
+                  break;
+               case 1:
+                  text.insert( p, 1, r );
+                  break;
+               default:
+                  text.erase( p, 1 );
+            }
+         }
+         TEST_ASSERT( same( text ) );
+      }
+   }
+
+   void unit_test()
+   {
+      test_documents();
+      test_numbers();
+      test_offsets();
+      test_files();
+      test_mutations();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"
@@ -0,0 +1,45 @@
+// Copyright (c) 2019 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/json/
+
+#include "test.hpp"
+
+#include <tao/json/contrib/flat_object.hpp>
+#include <tao/json/from_string.hpp>
+#include <tao/json/value_parser.hpp>
+
+namespace tao::json
+{
+   void test_parse()
+   {
+      value_parser p;
+      TEST_ASSERT( p.value().is_uninitialized() );
+      TEST_ASSERT( p.parse( "{\"a\":[1,2,{\"b\":null}],\"c\":\"d\"}" ) == from_string( "{\"a\":[1,2,{\"b\":null}],\"c\":\"d\"}" ) );
+      TEST_ASSERT( p.parse( "42" ) == 42 );
+      TEST_ASSERT( p.parse( std::string( " [ true ] " ), "source" ) == from_string( "[true]" ) );
+
+      // The state left behind by an error does not leak into the next document.
+      TEST_THROWS( p.parse( "{\"a\":[1,{\"b\":" ) );
+      TEST_ASSERT( p.parse( "[{\"x\":1}]" ) == from_string( "[{\"x\":1}]" ) );
+
+      const value v = std::move( p.value() );
+      TEST_ASSERT( v == from_string( "[{\"x\":1}]" ) );
+      p.reset();
+      TEST_ASSERT( p.value().is_uninitialized() );
+   }
+
+   void test_flat()
+   {
+      basic_value_parser< flat_traits > p;
+      TEST_THROWS( p.parse( "[{\"a\":{\"b\":1,\"b\":2}}]" ) );
+      TEST_ASSERT( p.parse( "{\"z\":{\"b\":1,\"a\":2},\"y\":0}" ) == flat_from_string( "{\"y\":0,\"z\":{\"a\":2,\"b\":1}}" ) );
+   }
+
+   void unit_test()
+   {
+      test_parse();
+      test_flat();
+   }
+
+}  // namespace tao::json
+
+#include "main.hpp"